@@ -1,10 +1,24 @@
 #pragma once
 
+#include "./collision/aabbtree.hpp"
 #include "./collision/capsule.hpp"
+#include "./collision/ccd.hpp"
 #include "./collision/circle.hpp"
 #include "./collision/collision.hpp"
 #include "./collision/gjk.hpp"
+#include "./collision/gjk_cache.hpp"
+#include "./collision/heightfield.hpp"
+#include "./collision/hull.hpp"
+#include "./collision/manifold.hpp"
+#include "./collision/narrowphase.hpp"
 #include "./collision/orirect.hpp"
 #include "./collision/rect.hpp"
+#include "./collision/rect_batch.hpp"
+#include "./collision/shape_set.hpp"
+#include "./collision/spatial_hash.hpp"
+#include "./collision/sweep_prune.hpp"
+#include "./collision/transform_batch.hpp"
 #include "./collision/triangle.hpp"
-#include "./collision/volume.hpp"
\ No newline at end of file
+#include "./collision/trimesh.hpp"
+#include "./collision/volume.hpp"
+#include "./collision/world.hpp"
\ No newline at end of file
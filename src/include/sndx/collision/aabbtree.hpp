@@ -0,0 +1,837 @@
+#pragma once
+
+#include "./collision.hpp"
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <execution>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace sndx::collision {
+
+	namespace detail {
+		// stack used while walking trees, avoids the heap unless the tree is very deep
+		template <class T, size_t inlineCapacity = 64>
+		class TraversalStack {
+		private:
+			std::array<T, inlineCapacity> m_inline{};
+			std::vector<T> m_overflow{};
+			size_t m_size = 0;
+
+		public:
+			void push(const T& value) {
+				if (m_size < inlineCapacity) {
+					m_inline[m_size] = value;
+				}
+				else {
+					m_overflow.push_back(value);
+				}
+				++m_size;
+			}
+
+			[[nodiscard]]
+			T pop() noexcept {
+				--m_size;
+				if (m_size < inlineCapacity) {
+					return m_inline[m_size];
+				}
+
+				auto out = m_overflow.back();
+				m_overflow.pop_back();
+				return out;
+			}
+
+			[[nodiscard]]
+			bool empty() const noexcept {
+				return m_size == 0;
+			}
+
+			[[nodiscard]]
+			size_t size() const noexcept {
+				return m_size;
+			}
+		};
+
+		// lets query callbacks either return nothing or return false to stop early
+		template <class Fn, class... Args>
+		bool invokeContinue(Fn&& fn, Args&&... args) {
+			if constexpr (std::is_void_v<std::invoke_result_t<Fn, Args...>>) {
+				std::forward<Fn>(fn)(std::forward<Args>(args)...);
+				return true;
+			}
+			else {
+				return bool(std::forward<Fn>(fn)(std::forward<Args>(args)...));
+			}
+		}
+	}
+
+	// A dynamic bounding volume hierarchy for broadphase.
+	// leaves store "fat" bounds so small movements don't require reinsertion,
+	// the tree is kept balanced with AVL style rotations.
+	template <class DataT = size_t, Vector VectorT = glm::vec3>
+		requires (VectorT::length() == 2 || VectorT::length() == 3)
+	class AABBTree {
+	public:
+		using Vec = VectorT;
+		using Precision = typename Vec::value_type;
+		using Bounds = Rect<Vec>;
+		using NodeId = uint32_t;
+
+		static constexpr NodeId null = std::numeric_limits<NodeId>::max();
+
+		static constexpr size_t dimensionality() noexcept {
+			return Vec::length();
+		}
+
+		struct Node {
+			Bounds bounds{ Vec{ Precision(0.0) }, Vec{ Precision(0.0) } };
+			DataT data{};
+
+			// parent doubles as the next free node when the node is unused
+			NodeId parent = null;
+			NodeId left = null;
+			NodeId right = null;
+
+			// leaves are 0, free nodes are -1
+			int32_t height = -1;
+
+			[[nodiscard]]
+			constexpr bool isLeaf() const noexcept {
+				return left == null;
+			}
+		};
+
+	private:
+		std::vector<Node> m_nodes{};
+		NodeId m_root = null;
+		NodeId m_free = null;
+		size_t m_leaves = 0;
+		Precision m_margin;
+
+		[[nodiscard]]
+		NodeId allocateNode() {
+			if (m_free == null) {
+				if (m_nodes.size() >= size_t(null)) [[unlikely]]
+					throw std::length_error("AABBTree ran out of node ids");
+
+				m_nodes.emplace_back();
+				m_nodes.back().height = 0;
+				return NodeId(m_nodes.size() - 1);
+			}
+
+			auto id = m_free;
+			auto& node = m_nodes[id];
+			m_free = node.parent;
+
+			node.parent = null;
+			node.left = null;
+			node.right = null;
+			node.height = 0;
+			return id;
+		}
+
+		void freeNode(NodeId id) noexcept {
+			auto& node = m_nodes[id];
+			node.parent = m_free;
+			node.left = null;
+			node.right = null;
+			node.height = -1;
+			node.data = DataT{};
+			m_free = id;
+		}
+
+		[[nodiscard]]
+		Bounds fatten(const Bounds& bounds, const Vec& displacement = Vec{ Precision(0.0) }) const noexcept {
+			auto p1 = bounds.getP1() - Vec{ m_margin };
+			auto p2 = bounds.getP2() + Vec{ m_margin };
+
+			// extend in the direction of travel so moving objects reinsert less often
+			p1 += glm::min(displacement, Precision(0.0));
+			p2 += glm::max(displacement, Precision(0.0));
+
+			return Bounds{ p1, p2 };
+		}
+
+		void refit(NodeId id) noexcept {
+			auto& node = m_nodes[id];
+			const auto& left = m_nodes[node.left];
+			const auto& right = m_nodes[node.right];
+
+			node.bounds = left.bounds.combine(right.bounds);
+			node.height = 1 + std::max(left.height, right.height);
+		}
+
+		void replaceChild(NodeId parent, NodeId oldChild, NodeId newChild) noexcept {
+			if (parent == null) {
+				m_root = newChild;
+				return;
+			}
+
+			auto& node = m_nodes[parent];
+			if (node.left == oldChild) {
+				node.left = newChild;
+			}
+			else {
+				node.right = newChild;
+			}
+		}
+
+		// performs a left or right rotation if a is imbalanced, returns the new subtree root
+		NodeId balance(NodeId iA) noexcept {
+			auto& a = m_nodes[iA];
+			if (a.isLeaf() || a.height < 2)
+				return iA;
+
+			auto iB = a.left;
+			auto iC = a.right;
+			auto& b = m_nodes[iB];
+			auto& c = m_nodes[iC];
+
+			auto imbalance = c.height - b.height;
+
+			// rotate c up
+			if (imbalance > 1) {
+				auto iF = c.left;
+				auto iG = c.right;
+				auto& f = m_nodes[iF];
+				auto& g = m_nodes[iG];
+
+				c.left = iA;
+				c.parent = a.parent;
+				a.parent = iC;
+				replaceChild(c.parent, iA, iC);
+
+				if (f.height > g.height) {
+					c.right = iF;
+					a.right = iG;
+					g.parent = iA;
+				}
+				else {
+					c.right = iG;
+					a.right = iF;
+					f.parent = iA;
+				}
+
+				refit(iA);
+				refit(iC);
+				return iC;
+			}
+
+			// rotate b up
+			if (imbalance < -1) {
+				auto iD = b.left;
+				auto iE = b.right;
+				auto& d = m_nodes[iD];
+				auto& e = m_nodes[iE];
+
+				b.left = iA;
+				b.parent = a.parent;
+				a.parent = iB;
+				replaceChild(b.parent, iA, iB);
+
+				if (d.height > e.height) {
+					b.right = iD;
+					a.left = iE;
+					e.parent = iA;
+				}
+				else {
+					b.right = iE;
+					a.left = iD;
+					d.parent = iA;
+				}
+
+				refit(iA);
+				refit(iB);
+				return iB;
+			}
+
+			return iA;
+		}
+
+		void fixUpwards(NodeId id) noexcept {
+			while (id != null) {
+				id = balance(id);
+				refit(id);
+				id = m_nodes[id].parent;
+			}
+		}
+
+		// picks a sibling using the surface area heuristic
+		[[nodiscard]]
+		NodeId findSibling(const Bounds& leafBounds) const noexcept {
+			auto id = m_root;
+			while (!m_nodes[id].isLeaf()) {
+				const auto& node = m_nodes[id];
+
+				auto area = node.bounds.getSurfaceArea();
+				auto combinedArea = node.bounds.combine(leafBounds).getSurfaceArea();
+
+				// cost of creating a new parent here
+				auto cost = Precision(2.0) * combinedArea;
+
+				// cost pushed down onto the children
+				auto inheritance = Precision(2.0) * (combinedArea - area);
+
+				auto childCost = [&](NodeId child) {
+					const auto& childNode = m_nodes[child];
+					auto grown = childNode.bounds.combine(leafBounds).getSurfaceArea();
+					if (childNode.isLeaf())
+						return grown + inheritance;
+
+					return grown - childNode.bounds.getSurfaceArea() + inheritance;
+				};
+
+				auto costLeft = childCost(node.left);
+				auto costRight = childCost(node.right);
+
+				if (cost < costLeft && cost < costRight)
+					break;
+
+				id = costLeft < costRight ? node.left : node.right;
+			}
+			return id;
+		}
+
+		void insertLeaf(NodeId leaf) {
+			if (m_root == null) {
+				m_root = leaf;
+				m_nodes[leaf].parent = null;
+				return;
+			}
+
+			auto sibling = findSibling(m_nodes[leaf].bounds);
+
+			// may reallocate, don't hold references across this
+			auto newParent = allocateNode();
+
+			auto oldParent = m_nodes[sibling].parent;
+			auto& parent = m_nodes[newParent];
+			parent.parent = oldParent;
+			parent.left = sibling;
+			parent.right = leaf;
+
+			replaceChild(oldParent, sibling, newParent);
+			m_nodes[sibling].parent = newParent;
+			m_nodes[leaf].parent = newParent;
+
+			fixUpwards(newParent);
+		}
+
+		void removeLeaf(NodeId leaf) noexcept {
+			if (leaf == m_root) {
+				m_root = null;
+				return;
+			}
+
+			auto parent = m_nodes[leaf].parent;
+			auto grandParent = m_nodes[parent].parent;
+			auto sibling = m_nodes[parent].left == leaf ? m_nodes[parent].right : m_nodes[parent].left;
+
+			replaceChild(grandParent, parent, sibling);
+			m_nodes[sibling].parent = grandParent;
+			freeNode(parent);
+
+			fixUpwards(grandParent);
+		}
+
+		void checkLeaf(NodeId id) const {
+			if (id >= m_nodes.size() || !m_nodes[id].isLeaf() || m_nodes[id].height != 0)
+				throw std::invalid_argument("NodeId does not refer to a leaf of this AABBTree");
+		}
+
+		// split whichever node is bigger, a leaf can't be split
+		template <class NodeT> [[nodiscard]]
+		static bool descendMine(const Node& mine, const NodeT& theirs) noexcept {
+			if (theirs.isLeaf())
+				return true;
+
+			return !mine.isLeaf() && mine.bounds.getArea() >= theirs.bounds.getArea();
+		}
+
+		template <class OtherT, class Fn>
+		bool descendPairs(const AABBTree<OtherT, VectorT>& other, NodeId mine, NodeId theirs, Fn& fn) const {
+			detail::TraversalStack<std::pair<NodeId, NodeId>> stack{};
+			stack.push({ mine, theirs });
+
+			while (!stack.empty()) {
+				auto [idA, idB] = stack.pop();
+				const auto& a = m_nodes[idA];
+				const auto& b = other.getNode(idB);
+				if (!a.bounds.overlaps(b.bounds))
+					continue;
+
+				if (a.isLeaf() && b.isLeaf()) {
+					if (!detail::invokeContinue(fn, idA, idB))
+						return false;
+				}
+				else if (descendMine(a, b)) {
+					stack.push({ a.right, idB });
+					stack.push({ a.left, idB });
+				}
+				else {
+					stack.push({ idA, b.right });
+					stack.push({ idA, b.left });
+				}
+			}
+			return true;
+		}
+
+	public:
+		// margin is how far leaf bounds are fattened in every direction
+		explicit AABBTree(Precision margin = Precision(0.1)) :
+			m_margin(margin) {
+
+			if (margin < Precision(0.0))
+				throw std::invalid_argument("AABBTree margin must be >= 0");
+		}
+
+		NodeId insert(const Bounds& bounds, const DataT& data) {
+			auto id = allocateNode();
+			auto& node = m_nodes[id];
+			node.bounds = fatten(bounds);
+			node.data = data;
+
+			insertLeaf(id);
+			++m_leaves;
+			return id;
+		}
+
+		// inserts any shape with a getBounds overload
+		template <class ShapeT>
+			requires requires(const ShapeT& shape) { { getBounds(shape) } -> std::convertible_to<Bounds>; }
+		NodeId insert(const ShapeT& shape, const DataT& data) {
+			return insert(Bounds(getBounds(shape)), data);
+		}
+
+		void remove(NodeId id) {
+			checkLeaf(id);
+
+			removeLeaf(id);
+			freeNode(id);
+			--m_leaves;
+		}
+
+		// returns true if the leaf had to be reinserted
+		bool move(NodeId id, const Bounds& bounds, const Vec& displacement = Vec{ Precision(0.0) }) {
+			checkLeaf(id);
+
+			if (m_nodes[id].bounds.contains(bounds))
+				return false;
+
+			removeLeaf(id);
+			m_nodes[id].bounds = fatten(bounds, displacement);
+			insertLeaf(id);
+			return true;
+		}
+
+		template <class ShapeT>
+			requires requires(const ShapeT& shape) { { getBounds(shape) } -> std::convertible_to<Bounds>; }
+		bool move(NodeId id, const ShapeT& shape, const Vec& displacement = Vec{ Precision(0.0) }) {
+			return move(id, Bounds(getBounds(shape)), displacement);
+		}
+
+		void clear() noexcept {
+			m_nodes.clear();
+			m_root = null;
+			m_free = null;
+			m_leaves = 0;
+		}
+
+		void reserve(size_t leaves) {
+			// n leaves require n - 1 internal nodes
+			m_nodes.reserve(leaves * 2);
+		}
+
+		/* Info Methods */
+
+		[[nodiscard]]
+		const DataT& getData(NodeId id) const {
+			checkLeaf(id);
+			return m_nodes[id].data;
+		}
+
+		[[nodiscard]]
+		DataT& getData(NodeId id) {
+			checkLeaf(id);
+			return m_nodes[id].data;
+		}
+
+		[[nodiscard]]
+		const Bounds& getFatBounds(NodeId id) const {
+			checkLeaf(id);
+			return m_nodes[id].bounds;
+		}
+
+		[[nodiscard]]
+		const Node& getNode(NodeId id) const {
+			return m_nodes.at(id);
+		}
+
+		[[nodiscard]]
+		NodeId getRoot() const noexcept {
+			return m_root;
+		}
+
+		[[nodiscard]]
+		int32_t getHeight() const noexcept {
+			return m_root == null ? 0 : m_nodes[m_root].height;
+		}
+
+		[[nodiscard]]
+		Precision getMargin() const noexcept {
+			return m_margin;
+		}
+
+		[[nodiscard]]
+		size_t size() const noexcept {
+			return m_leaves;
+		}
+
+		[[nodiscard]]
+		bool empty() const noexcept {
+			return m_leaves == 0;
+		}
+
+		/* Query Methods */
+
+		// calls fn(NodeId) for every leaf whose fat bounds overlap bounds.
+		// fn may return false to stop early.
+		template <class Fn>
+		void query(const Bounds& bounds, Fn&& fn) const {
+			if (m_root == null)
+				return;
+
+			detail::TraversalStack<NodeId> stack{};
+			stack.push(m_root);
+
+			while (!stack.empty()) {
+				const auto& node = m_nodes[stack.pop()];
+				if (!node.bounds.overlaps(bounds))
+					continue;
+
+				if (node.isLeaf()) {
+					if (!detail::invokeContinue(fn, NodeId(&node - m_nodes.data())))
+						return;
+				}
+				else {
+					stack.push(node.left);
+					stack.push(node.right);
+				}
+			}
+		}
+
+		// calls fn(NodeId, Precision distance) for every leaf whose fat bounds are hit by the ray within maxDist.
+		// if fn returns a Precision, it becomes the new maxDist (return <= 0 to stop).
+		// this allows closest hit searches to prune the remaining tree.
+		template <class Fn>
+		void raycast(const Vec& from, const Vec& dir, Fn&& fn, Precision maxDist = std::numeric_limits<Precision>::max()) const {
+			if (m_root == null)
+				return;
+
+			detail::TraversalStack<NodeId> stack{};
+			stack.push(m_root);
+
+			while (!stack.empty()) {
+				const auto& node = m_nodes[stack.pop()];
+
+				auto res = node.bounds.raycast(from, dir);
+				if (!res.hit() || res.far < Precision(0.0) || res.near > maxDist)
+					continue;
+
+				if (node.isLeaf()) {
+					auto id = NodeId(&node - m_nodes.data());
+					auto dist = std::max(res.near, Precision(0.0));
+
+					using ResultT = std::invoke_result_t<Fn, NodeId, Precision>;
+					if constexpr (std::is_void_v<ResultT>) {
+						fn(id, dist);
+					}
+					else if constexpr (std::is_same_v<ResultT, bool>) {
+						if (!fn(id, dist))
+							return;
+					}
+					else {
+						maxDist = std::min(maxDist, Precision(fn(id, dist)));
+						if (maxDist <= Precision(0.0))
+							return;
+					}
+				}
+				else {
+					stack.push(node.left);
+					stack.push(node.right);
+				}
+			}
+		}
+
+		// calls fn(NodeId, NodeId) once for every pair of leaves with overlapping fat bounds.
+		template <class Fn>
+		void queryPairs(Fn&& fn) const {
+			for (NodeId id = 0; id < m_nodes.size(); ++id) {
+				const auto& leaf = m_nodes[id];
+				if (leaf.height != 0)
+					continue;
+
+				query(leaf.bounds, [&](NodeId other) {
+					// only report each pair once
+					if (other > id) {
+						fn(id, other);
+					}
+				});
+			}
+		}
+
+		[[nodiscard]]
+		std::vector<std::pair<NodeId, NodeId>> getOverlappingPairs() const {
+			std::vector<std::pair<NodeId, NodeId>> out{};
+			queryPairs([&out](NodeId a, NodeId b) {
+				out.emplace_back(a, b);
+			});
+			return out;
+		}
+
+		/* Tree vs Tree Methods */
+
+		// calls fn(NodeId mine, NodeId theirs) for every pair of leaves, one from each tree, with overlapping fat bounds.
+		// walks both trees at once, descending into the larger node each step. fn may return false to stop early.
+		// pairs within a single tree come from queryPairs
+		template <class OtherT, class Fn>
+		void queryPairs(const AABBTree<OtherT, VectorT>& other, Fn&& fn) const {
+			if (m_root == null || other.getRoot() == other.null)
+				return;
+
+			descendPairs(other, m_root, other.getRoot(), fn);
+		}
+
+		// same pairs as queryPairs(other, fn), in no particular order.
+		// the first splitDepth levels of the walk run on the calling thread, every node pair left at that depth
+		// becomes a task with its own output buffer. buffers are merged into out at the end
+#ifndef __APPLE__
+		template <class OtherT>
+		void getOverlappingPairs(auto&& policy, const AABBTree<OtherT, VectorT>& other, std::vector<std::pair<NodeId, NodeId>>& out, uint32_t splitDepth = 8) const {
+			out.clear();
+			if (m_root == null || other.getRoot() == other.null)
+				return;
+
+			struct Task {
+				NodeId mine, theirs;
+				uint32_t depth;
+			};
+
+			std::vector<Task> tasks{};
+			detail::TraversalStack<Task> stack{};
+			stack.push(Task{ m_root, other.getRoot(), 0 });
+
+			while (!stack.empty()) {
+				auto task = stack.pop();
+				const auto& a = m_nodes[task.mine];
+				const auto& b = other.getNode(task.theirs);
+				if (!a.bounds.overlaps(b.bounds))
+					continue;
+
+				if (a.isLeaf() && b.isLeaf()) {
+					out.emplace_back(task.mine, task.theirs);
+				}
+				else if (task.depth >= splitDepth) {
+					tasks.push_back(task);
+				}
+				else if (descendMine(a, b)) {
+					stack.push(Task{ a.right, task.theirs, task.depth + 1 });
+					stack.push(Task{ a.left, task.theirs, task.depth + 1 });
+				}
+				else {
+					stack.push(Task{ task.mine, b.right, task.depth + 1 });
+					stack.push(Task{ task.mine, b.left, task.depth + 1 });
+				}
+			}
+
+			// the algorithm may hand out copies of the elements, so work by index instead of by address
+			std::vector<size_t> indices(tasks.size());
+			std::iota(indices.begin(), indices.end(), size_t(0));
+
+			std::vector<std::vector<std::pair<NodeId, NodeId>>> buffers(tasks.size());
+			std::for_each(policy, indices.begin(), indices.end(), [&](size_t i) {
+				const auto& task = tasks[i];
+				auto& buffer = buffers[i];
+				auto collect = [&buffer](NodeId mine, NodeId theirs) {
+					buffer.emplace_back(mine, theirs);
+				};
+				descendPairs(other, task.mine, task.theirs, collect);
+			});
+
+			// offsets[i] is where buffer i starts in out
+			std::vector<size_t> offsets(buffers.size());
+			auto total = out.size();
+			for (size_t i = 0; i < buffers.size(); ++i) {
+				offsets[i] = total;
+				total += buffers[i].size();
+			}
+
+			out.resize(total);
+			std::for_each(std::forward<decltype(policy)>(policy), indices.begin(), indices.end(), [&](size_t i) {
+				std::copy(buffers[i].begin(), buffers[i].end(), out.begin() + std::ptrdiff_t(offsets[i]));
+			});
+		}
+#endif
+
+		template <class OtherT> [[nodiscard]]
+		std::vector<std::pair<NodeId, NodeId>> getOverlappingPairs(const AABBTree<OtherT, VectorT>& other, uint32_t splitDepth = 8) const {
+			std::vector<std::pair<NodeId, NodeId>> out{};
+#ifndef __APPLE__
+			getOverlappingPairs(std::execution::par, other, out, splitDepth);
+#else
+			queryPairs(other, [&out](NodeId mine, NodeId theirs) {
+				out.emplace_back(mine, theirs);
+			});
+#endif
+			return out;
+		}
+
+		/* Nearest Neighbour Methods */
+
+		using Neighbour = std::pair<NodeId, Precision>;
+
+		// the k leaves closest to point no further than maxDist, closest first.
+		// fn(NodeId) is the exact distance of a leaf's shape and only runs on leaves whose fat bounds could still be close enough.
+		// signed distances work, a point inside a shape only visits the bounds containing it.
+		template <std::invocable<NodeId> Fn> [[nodiscard]]
+		std::vector<Neighbour> kNearest(const Vec& point, size_t k, Fn&& fn, Precision maxDist = std::numeric_limits<Precision>::max()) const {
+			std::vector<Neighbour> out{};
+			if (k == 0 || m_root == null)
+				return out;
+
+			out.reserve(std::min(k, m_leaves));
+
+			// results are a max heap on distance so the worst is at the front
+			auto furthest = [](const Neighbour& a, const Neighbour& b) {
+				return a.second < b.second;
+			};
+
+			// the fat bounds can't tell apart shapes the point is inside of
+			auto bound = [&]() {
+				auto worst = out.size() < k ? maxDist : out.front().second;
+				return std::max(worst, Precision(0.0));
+			};
+
+			// best first, the open list is a min heap on bounds distance
+			std::vector<Neighbour> open{};
+			auto nearer = [](const Neighbour& a, const Neighbour& b) {
+				return a.second > b.second;
+			};
+
+			auto boundsDist = [&](NodeId id) {
+				const auto& bounds = m_nodes[id].bounds;
+				return glm::distance(point, bounds.closestPoint(point));
+			};
+
+			open.emplace_back(m_root, boundsDist(m_root));
+
+			while (!open.empty()) {
+				std::pop_heap(open.begin(), open.end(), nearer);
+				auto [id, dist] = open.back();
+				open.pop_back();
+
+				// everything left is at least this far away
+				if (dist > bound())
+					break;
+
+				const auto& node = m_nodes[id];
+				if (node.isLeaf()) {
+					auto exact = Precision(std::invoke(fn, id));
+					if (exact > maxDist)
+						continue;
+
+					if (out.size() < k) {
+						out.emplace_back(id, exact);
+						std::push_heap(out.begin(), out.end(), furthest);
+					}
+					else if (exact < out.front().second) {
+						std::pop_heap(out.begin(), out.end(), furthest);
+						out.back() = Neighbour{ id, exact };
+						std::push_heap(out.begin(), out.end(), furthest);
+					}
+				}
+				else {
+					for (auto child : { node.left, node.right }) {
+						auto childDist = boundsDist(child);
+						if (childDist <= bound()) {
+							open.emplace_back(child, childDist);
+							std::push_heap(open.begin(), open.end(), nearer);
+						}
+					}
+				}
+			}
+
+			std::sort_heap(out.begin(), out.end(), furthest);
+			return out;
+		}
+
+		// uses data.distance(point) when DataT has one, otherwise the distance to the fat bounds
+		[[nodiscard]]
+		std::vector<Neighbour> kNearest(const Vec& point, size_t k, Precision maxDist = std::numeric_limits<Precision>::max()) const {
+			return kNearest(point, k, [&](NodeId id) {
+				if constexpr (requires (const DataT& data) { { data.distance(point) } -> std::convertible_to<Precision>; }) {
+					return Precision(m_nodes[id].data.distance(point));
+				}
+				else {
+					const auto& bounds = m_nodes[id].bounds;
+					return Precision(glm::distance(point, bounds.closestPoint(point)));
+				}
+			}, maxDist);
+		}
+
+		template <std::invocable<NodeId> Fn> [[nodiscard]]
+		std::optional<Neighbour> nearest(const Vec& point, Fn&& fn, Precision maxDist = std::numeric_limits<Precision>::max()) const {
+			auto res = kNearest(point, 1, std::forward<Fn>(fn), maxDist);
+			if (res.empty())
+				return std::nullopt;
+
+			return res.front();
+		}
+
+		[[nodiscard]]
+		std::optional<Neighbour> nearest(const Vec& point, Precision maxDist = std::numeric_limits<Precision>::max()) const {
+			auto res = kNearest(point, 1, maxDist);
+			if (res.empty())
+				return std::nullopt;
+
+			return res.front();
+		}
+
+#ifndef __APPLE__
+		// kNearest for many points, out[i] is the answer for points[i].
+		// fn(NodeId, const Vec& point) must be safe to call concurrently
+		template <class Fn>
+			requires std::invocable<Fn, NodeId, const Vec&>
+		void kNearest(auto&& policy, std::span<const Vec> points, size_t k, Fn&& fn, std::vector<std::vector<Neighbour>>& out, Precision maxDist = std::numeric_limits<Precision>::max()) const {
+			out.resize(points.size());
+			std::for_each(std::forward<decltype(policy)>(policy), out.begin(), out.end(), [&](std::vector<Neighbour>& slot) {
+				const auto& point = points[size_t(&slot - out.data())];
+				slot = kNearest(point, k, [&](NodeId id) { return fn(id, point); }, maxDist);
+			});
+		}
+#endif
+
+		template <class Fn>
+			requires std::invocable<Fn, NodeId, const Vec&>
+		void kNearest(std::span<const Vec> points, size_t k, Fn&& fn, std::vector<std::vector<Neighbour>>& out, Precision maxDist = std::numeric_limits<Precision>::max()) const {
+#ifndef __APPLE__
+			kNearest(std::execution::par, points, k, std::forward<Fn>(fn), out, maxDist);
+#else
+			out.resize(points.size());
+			for (size_t i = 0; i < points.size(); ++i) {
+				out[i] = kNearest(points[i], k, [&](NodeId id) { return fn(id, points[i]); }, maxDist);
+			}
+#endif
+		}
+	};
+}
\ No newline at end of file
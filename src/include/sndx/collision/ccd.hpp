@@ -0,0 +1,163 @@
+#pragma once
+
+#include "./collision.hpp"
+#include "./gjk.hpp"
+
+#include <glm/gtc/quaternion.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <optional>
+
+namespace sndx::collision {
+
+	struct TimeOfImpact {
+		// fraction of the step in [0, 1]
+		float toi = 0.0f;
+
+		// from a towards b at the time of impact
+		glm::vec3 normal{};
+
+		// world space contact point on a
+		glm::vec3 point{};
+
+		uint32_t iterations = 0;
+	};
+
+	struct ToiSettings {
+		// shapes closer than this count as touching, keeps the result just short of overlap
+		float tolerance = 0.005f;
+		uint32_t maxIterations = 32;
+	};
+
+	namespace detail {
+		template <bool uniformScale> [[nodiscard]]
+		Transform<uniformScale> lerpTransform(const Transform<uniformScale>& a, const Transform<uniformScale>& b, float t) {
+			return Transform<uniformScale>{
+				glm::mix(a.pos, b.pos, t),
+				glm::slerp(glm::normalize(a.rot), glm::normalize(b.rot), t),
+				a.scale + (b.scale - a.scale) * t
+			};
+		}
+
+		template <bool uniformScale> [[nodiscard]]
+		float maxScale(const Transform<uniformScale>& tform) {
+			if constexpr (uniformScale) {
+				return std::abs(tform.scale);
+			}
+			else {
+				return glm::compMax(glm::abs(tform.scale));
+			}
+		}
+
+		// largest change of any scale axis over the whole step
+		template <bool uniformScale> [[nodiscard]]
+		float scaleChange(const Transform<uniformScale>& from, const Transform<uniformScale>& to) {
+			if constexpr (uniformScale) {
+				return std::abs(to.scale - from.scale);
+			}
+			else {
+				return glm::compMax(glm::abs(to.scale - from.scale));
+			}
+		}
+
+		// angle swept by the rotation over the whole step
+		[[nodiscard]]
+		inline float sweptAngle(const glm::quat& from, const glm::quat& to) {
+			auto w = std::abs(glm::dot(glm::normalize(from), glm::normalize(to)));
+			return 2.0f * std::acos(std::min(w, 1.0f));
+		}
+
+		// furthest any point of the shape gets from its local origin
+		template <class ShapeT> [[nodiscard]]
+		float boundingRadius(const ShapeT& shape) {
+			auto bounds = sndx::collision::getBounds(shape);
+			auto extent = glm::max(glm::abs(bounds.getP1()), glm::abs(bounds.getP2()));
+			return glm::length(extent);
+		}
+
+		template <class ShapeT, bool uniformScale> [[nodiscard]]
+		auto supportAt(const ShapeT& shape, const Transform<uniformScale>& tform) {
+			auto m = tform.asMatrix();
+
+			// directions map through the transpose, which also handles non-uniform scale
+			return transformSupportFn(getSupportFn(shape), m, glm::mat4{ glm::transpose(glm::mat3{ m }) });
+		}
+	}
+
+	// Time of impact of two shapes moving from transform *0 to *1 over one step.
+	// shapes are in local space, motion is interpolated linearly with slerped rotation.
+	// uses conservative advancement, each iteration steps forward by the distance between
+	// the shapes divided by an upper bound of how fast they can approach each other.
+	// the bound covers translation, rotation and scale changing over the step.
+	template <class ShapeA, class ShapeB, bool uniformScale> [[nodiscard]]
+	std::optional<TimeOfImpact> timeOfImpact(
+		const ShapeA& shapeA, const detail::Transform<uniformScale>& a0, const detail::Transform<uniformScale>& a1,
+		const ShapeB& shapeB, const detail::Transform<uniformScale>& b0, const detail::Transform<uniformScale>& b1,
+		const ToiSettings& settings = {}) {
+
+		auto radiusA = detail::boundingRadius(shapeA) * std::max(detail::maxScale(a0), detail::maxScale(a1));
+		auto radiusB = detail::boundingRadius(shapeB) * std::max(detail::maxScale(b0), detail::maxScale(b1));
+
+		auto angularBound = detail::sweptAngle(a0.rot, a1.rot) * radiusA + detail::sweptAngle(b0.rot, b1.rot) * radiusB;
+
+		// a growing shape's surface moves out by at most its radius times the scale change
+		auto scaleBound = detail::boundingRadius(shapeA) * detail::scaleChange(a0, a1) + detail::boundingRadius(shapeB) * detail::scaleChange(b0, b1);
+		auto velA = a1.pos - a0.pos;
+		auto velB = b1.pos - b0.pos;
+
+		TimeOfImpact out{};
+
+		{
+			auto sptA = detail::supportAt(shapeA, a0);
+			auto sptB = detail::supportAt(shapeB, b0);
+
+			// already overlapping, report the penetration instead.
+			// epa's normal faces from a towards b, like the separated case
+			if (auto simplex = gjk(sptA, sptB)) {
+				out.iterations = 1;
+
+				auto res = epa(*simplex, sptA, sptB);
+				out.normal = res.normal;
+				out.point = res.a;
+				return out;
+			}
+		}
+
+		float t = 0.0f;
+		while (out.iterations < settings.maxIterations) {
+			++out.iterations;
+
+			auto ta = detail::lerpTransform(a0, a1, t);
+			auto tb = detail::lerpTransform(b0, b1, t);
+
+			auto res = gjkDist(detail::supportAt(shapeA, ta), detail::supportAt(shapeB, tb));
+			auto delta = res.b - res.a;
+			auto dist = glm::length(delta);
+
+			if (dist > 0.0f) {
+				out.normal = delta / dist;
+			}
+			out.point = res.a;
+
+			if (dist <= settings.tolerance) {
+				out.toi = t;
+				return out;
+			}
+
+			// upper bound of the closing speed along the separating direction
+			auto bound = glm::dot(velA - velB, out.normal) + angularBound + scaleBound;
+			if (bound <= 0.0f)
+				return std::nullopt;
+
+			t += (dist - settings.tolerance * 0.5f) / bound;
+			if (t > 1.0f)
+				return std::nullopt;
+		}
+
+		// ran out of iterations, the last safe time is still a valid conservative answer
+		out.toi = t;
+		return out;
+	}
+}
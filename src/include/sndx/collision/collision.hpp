@@ -11,7 +11,10 @@
 #include <glm/glm.hpp>
 #include <glm/gtx/matrix_decompose.hpp>
 
+#include <array>
 #include <optional>
+#include <span>
+#include <utility>
 
 namespace sndx::collision {
 
@@ -45,8 +48,92 @@ namespace sndx::collision {
 		}
 	};
 
+	using Collision2D = Collision<glm::vec2>;
 	using Collision3D = Collision<glm::vec3>;
 
+	// up to 4 contact points sharing one normal, enough to rest a face on a face
+	template <Vector VectorT = glm::vec3>
+	struct Manifold {
+		using Vec = VectorT;
+		using Precision = typename Vec::value_type;
+
+		static constexpr size_t maxPoints = 4;
+
+		struct Point {
+			// on the surfaces of a and b
+			VectorT a{}, b{};
+			Precision depth{};
+
+			// identifies the features that produced the point, 0 if unknown.
+			// it stays the same while the contact configuration does
+			uint32_t feature = 0;
+		};
+
+		// from a towards b
+		VectorT normal{};
+		std::array<Point, maxPoints> points{};
+		uint8_t count = 0;
+
+		constexpr Manifold() = default;
+
+		constexpr explicit Manifold(const Collision<VectorT>& collision) noexcept :
+			normal(collision.normal), count(1) {
+
+			points[0] = Point{ collision.a, collision.b, collision.depth, 0 };
+		}
+
+		[[nodiscard]]
+		constexpr std::span<const Point> getPoints() const noexcept {
+			return std::span<const Point>{ points.data(), count };
+		}
+
+		[[nodiscard]]
+		constexpr size_t size() const noexcept {
+			return count;
+		}
+
+		[[nodiscard]]
+		constexpr bool empty() const noexcept {
+			return count == 0;
+		}
+
+		[[nodiscard]]
+		constexpr const Point& deepest() const noexcept {
+			size_t best = 0;
+			for (size_t i = 1; i < count; ++i) {
+				if (points[i].depth > points[best].depth) {
+					best = i;
+				}
+			}
+			return points[best];
+		}
+
+		// the deepest point as a single Collision
+		[[nodiscard]]
+		constexpr Collision<VectorT> toCollision() const noexcept {
+			const auto& point = deepest();
+
+			Collision<VectorT> out{};
+			out.normal = normal;
+			out.depth = point.depth;
+			out.a = point.a;
+			out.b = point.b;
+			return out;
+		}
+
+		[[nodiscard]]
+		constexpr Manifold swapped() const noexcept {
+			Manifold out = *this;
+			out.normal *= Precision(-1.0);
+			for (auto& point : out.points) {
+				std::swap(point.a, point.b);
+			}
+			return out;
+		}
+	};
+
+	using Manifold3D = Manifold<glm::vec3>;
+
 	template <Vector VectorT> [[nodiscard]]
 	consteval VectorT getFallbackNormal() {
 		VectorT f{};
@@ -231,9 +318,8 @@ namespace sndx::collision {
 	}
 
 	template <Vector VectorT> [[nodiscard]]
-	constexpr bool hasCollision(const Circle<VectorT>& a, const OriRect<VectorT>& b) {
-		auto center = a.getCenter() - b.getCenter();
-		auto local = glm::inverse(b.getRotation()) * center;
+	constexpr bool hasCollision(const Circle<VectorT>& a, const BakedOriRect<VectorT>& b) {
+		auto local = b.toLocal(a.getCenter());
 
 		auto closest = glm::clamp(local, -b.getHalfExtents(), b.getHalfExtents());
 		auto delta = local - closest;
@@ -241,6 +327,11 @@ namespace sndx::collision {
 		return glm::length2(delta) <= a.getRadius() * a.getRadius();
 	}
 
+	template <Vector VectorT> [[nodiscard]]
+	constexpr bool hasCollision(const Circle<VectorT>& a, const OriRect<VectorT>& b) {
+		return hasCollision(a, BakedOriRect<VectorT>{ b });
+	}
+
 	template <Vector VectorT> [[nodiscard]]
 	constexpr std::optional<Collision<VectorT>> getCollision(const Circle<VectorT>& a, const Circle<VectorT>& b) {
 		using Precision = typename Circle<VectorT>::Precision;
@@ -310,6 +401,14 @@ namespace sndx::collision {
 		return std::nullopt;
 	}
 
+	template <Vector VectorT> [[nodiscard]]
+	constexpr std::optional<Collision<VectorT>> getCollision(const Circle<VectorT>& a, const BakedOriRect<VectorT>& b) {
+		if (auto r = getCollision(b, a)) {
+			return r->swapped();
+		}
+		return std::nullopt;
+	}
+
 	template <Vector VectorT> [[nodiscard]]
 	constexpr std::optional<Collision<VectorT>> getCollision(const Circle<VectorT>& a, const Capsule<VectorT>& b) {
 		if (auto r = getCollision(b, a)) {
@@ -443,13 +542,11 @@ namespace sndx::collision {
 	}
 
 	template <Vector VectorT> [[nodiscard]]
-	constexpr std::optional<Collision<VectorT>> getCollision(const Capsule<VectorT>& a, const OriRect<VectorT>& b) {
-		using Precision = typename OriRect<VectorT>::Precision;
+	constexpr std::optional<Collision<VectorT>> getCollision(const Capsule<VectorT>& a, const BakedOriRect<VectorT>& b) {
+		using Precision = typename BakedOriRect<VectorT>::Precision;
 
-		auto invRot = glm::inverse(b.getRotation());
-
-		auto localA = invRot * (a.getPointA() - b.getCenter());
-		auto localB = invRot * (a.getPointB() - b.getCenter());
+		auto localA = b.toLocal(a.getPointA());
+		auto localB = b.toLocal(a.getPointB());
 
 		auto localRect = Rect<VectorT>(-b.getHalfExtents(), b.getHalfExtents());
 		
@@ -459,14 +556,19 @@ namespace sndx::collision {
 		}
 
 		Collision<VectorT> out{};
-		out.normal = b.getRotation() * (localRes->normal * localRes->depth);
+		out.normal = b.getAxes() * (localRes->normal * localRes->depth);
 		out.depth = glm::length(out.normal);
 		out.normal = out.depth <= Precision(0.00001) ? getFallbackNormal<VectorT>() : out.normal / out.depth;
-		out.a = b.getCenter() + b.getRotation() * localRes->a;
-		out.b = b.getCenter() + b.getRotation() * localRes->b;
+		out.a = b.toWorld(localRes->a);
+		out.b = b.toWorld(localRes->b);
 		return out;
 	}
 
+	template <Vector VectorT> [[nodiscard]]
+	constexpr std::optional<Collision<VectorT>> getCollision(const Capsule<VectorT>& a, const OriRect<VectorT>& b) {
+		return getCollision(a, BakedOriRect<VectorT>{ b });
+	}
+
 	template <Vector VectorT> [[nodiscard]]
 	constexpr std::optional<Collision<VectorT>> getCollision(const Capsule<VectorT>& a, const Tri<VectorT>& b) {
 		using Precision = typename Tri<VectorT>::Precision;
@@ -606,21 +708,30 @@ namespace sndx::collision {
 	// ===============
 
 	[[nodiscard]]
-	inline Rect3D getBounds(const OriRect3D& obb) {
-		auto axes = glm::mat3_cast(obb.getRotation());
+	inline Rect3D getBounds(const BakedOriRect3D& obb) {
 		glm::vec3 extent{ 0.0f };
 		for (glm::length_t i = 0; i < 3; ++i) {
-			extent[i] = glm::dot(glm::abs(axes[i]), obb.getHalfExtents());
+			extent += glm::abs(obb.getAxis(i)) * obb.getHalfExtents()[i];
 		}
 
 		return Rect3D{ obb.getCenter() - extent, obb.getCenter() + extent };
 	}
 
+	[[nodiscard]]
+	inline Rect3D getBounds(const OriRect3D& obb) {
+		return getBounds(BakedOriRect3D{ obb });
+	}
+
 	template <Vector VectorT> [[nodiscard]]
 	constexpr bool hasCollision(const OriRect<VectorT>& a, const Circle<VectorT>& b) {
 		return hasCollision(b, a);
 	}
 
+	template <Vector VectorT> [[nodiscard]]
+	constexpr bool hasCollision(const BakedOriRect<VectorT>& a, const Circle<VectorT>& b) {
+		return hasCollision(b, a);
+	}
+
 	template <Vector VectorT> [[nodiscard]]
 	constexpr std::optional<Collision<VectorT>> getCollision(const OriRect<VectorT>& a, const Capsule<VectorT>& b) {
 		if (auto r = getCollision(b, a)) {
@@ -629,11 +740,19 @@ namespace sndx::collision {
 		return std::nullopt;
 	}
 
+	template <Vector VectorT> [[nodiscard]]
+	constexpr std::optional<Collision<VectorT>> getCollision(const BakedOriRect<VectorT>& a, const Capsule<VectorT>& b) {
+		if (auto r = getCollision(b, a)) {
+			return r->swapped();
+		}
+		return std::nullopt;
+	}
+
 	namespace detail {
 		// helper for SAT
 		template <Vector VectorT = glm::vec3> [[nodiscard]]
-		bool testAxis(VectorT axis, const OriRect<VectorT>& a, const OriRect<VectorT>& b, typename OriRect<VectorT>::Precision& minOverlap, VectorT& bestAxis) {
-			using Precision = typename OriRect<VectorT>::Precision;
+		bool testAxis(VectorT axis, const BakedOriRect<VectorT>& a, const BakedOriRect<VectorT>& b, typename BakedOriRect<VectorT>::Precision& minOverlap, VectorT& bestAxis) {
+			using Precision = typename BakedOriRect<VectorT>::Precision;
 			
 			auto len2 = glm::length2(axis);
 			if (len2 < Precision(0.00000001))
@@ -645,14 +764,11 @@ namespace sndx::collision {
 			auto ab = b.getCenter() - a.getCenter();
 			auto dist = std::abs(glm::dot(ab, axis));
 
-			auto axesA = glm::mat3_cast(a.getRotation());
-			auto axesB = glm::mat3_cast(b.getRotation());
-
 			Precision overlapA{};
 			Precision overlapB{};
 			for (uint8_t i = 0; i < a.dimensionality(); ++i) {
-				overlapA += a.getHalfExtents()[i] * std::abs(glm::dot(axesA[i], axis));
-				overlapB += b.getHalfExtents()[i] * std::abs(glm::dot(axesB[i], axis));
+				overlapA += a.getHalfExtents()[i] * std::abs(glm::dot(a.getAxis(i), axis));
+				overlapB += b.getHalfExtents()[i] * std::abs(glm::dot(b.getAxis(i), axis));
 			}
 
 			auto overlap = overlapA + overlapB - dist;
@@ -670,31 +786,28 @@ namespace sndx::collision {
 	}
 
 	template <Vector VectorT> [[nodiscard]]
-	constexpr bool hasCollision(const OriRect<VectorT>& a, const OriRect<VectorT>& b) {
-		using Precision = typename OriRect<VectorT>::Precision;
-
-		glm::mat3 axesA = glm::mat3_cast(a.getRotation());
-		glm::mat3 axesB = glm::mat3_cast(b.getRotation());
+	constexpr bool hasCollision(const BakedOriRect<VectorT>& a, const BakedOriRect<VectorT>& b) {
+		using Precision = typename BakedOriRect<VectorT>::Precision;
 
 		Precision minOverlap = std::numeric_limits<Precision>::max();
 		VectorT minAxis{};
 
 		// test a faces
-		for (uint8_t i = 0; i < axesA.length(); ++i) {
-			if (!detail::testAxis(axesA[i], a, b, minOverlap, minAxis))
+		for (uint8_t i = 0; i < 3; ++i) {
+			if (!detail::testAxis(a.getAxis(i), a, b, minOverlap, minAxis))
 				return false;
 		}
 
 		// test b faces
-		for (uint8_t i = 0; i < axesB.length(); ++i) {
-			if (!detail::testAxis(axesB[i], a, b, minOverlap, minAxis))
+		for (uint8_t i = 0; i < 3; ++i) {
+			if (!detail::testAxis(b.getAxis(i), a, b, minOverlap, minAxis))
 				return false;
 		}
 
 		// test edges
-		for (uint8_t i = 0; i < axesA.length(); ++i) {
-			for (uint8_t j = 0; j < axesB.length(); ++j) {
-				auto axis = glm::cross(axesA[i], axesB[j]);
+		for (uint8_t i = 0; i < 3; ++i) {
+			for (uint8_t j = 0; j < 3; ++j) {
+				auto axis = glm::cross(a.getAxis(i), b.getAxis(j));
 
 				if (!detail::testAxis(axis, a, b, minOverlap, minAxis))
 					return false;
@@ -705,74 +818,358 @@ namespace sndx::collision {
 	}
 
 	template <Vector VectorT> [[nodiscard]]
-	constexpr std::optional<Collision<VectorT>> getCollision(const OriRect<VectorT>& a, const OriRect<VectorT>& b) {
-		
-		using Precision = typename OriRect<VectorT>::Precision;
+	constexpr bool hasCollision(const OriRect<VectorT>& a, const OriRect<VectorT>& b) {
+		return hasCollision(BakedOriRect<VectorT>{ a }, BakedOriRect<VectorT>{ b });
+	}
 
-		glm::mat3 axesA = glm::mat3_cast(a.getRotation());
-		glm::mat3 axesB = glm::mat3_cast(b.getRotation());
+	namespace detail {
+		template <Vector VectorT>
+		struct ObbAxis {
+			using Precision = typename VectorT::value_type;
 
-		Precision minOverlap = std::numeric_limits<Precision>::max();
-		VectorT minAxis{};
+			// from a towards b
+			VectorT axis{};
+			Precision overlap = std::numeric_limits<Precision>::max();
 
-		// test a faces
-		for (uint8_t i = 0; i < axesA.length(); ++i) {
-			if (!detail::testAxis(axesA[i], a, b, minOverlap, minAxis))
-				return std::nullopt;
-		}
+			// 0 is a face of a, 1 a face of b, 2 an edge of each
+			uint8_t kind = 0;
+			uint8_t i = 0, j = 0;
+		};
 
-		// test b faces
-		for (uint8_t i = 0; i < axesB.length(); ++i) {
-			if (!detail::testAxis(axesB[i], a, b, minOverlap, minAxis))
-				return std::nullopt;
-		}
+		// SAT that remembers which features the minimum came from.
+		// later axes only win by a margin, so resting faces don't flicker between
+		// reference faces or edge contacts from one frame to the next.
+		template <Vector VectorT> [[nodiscard]]
+		std::optional<ObbAxis<VectorT>> findObbAxis(const BakedOriRect<VectorT>& a, const BakedOriRect<VectorT>& b) {
+			using Precision = typename BakedOriRect<VectorT>::Precision;
 
-		// test edges
-		for (uint8_t i = 0; i < axesA.length(); ++i) {
-			for (uint8_t j = 0; j < axesB.length(); ++j) {
-				auto axis = glm::cross(axesA[i], axesB[j]);
+			constexpr Precision relTolerance = Precision(0.95);
+			constexpr Precision absTolerance = Precision(0.0005);
 
-				if (!detail::testAxis(axis, a, b, minOverlap, minAxis))
+			ObbAxis<VectorT> best{};
+			bool first = true;
+
+			auto consider = [&](const VectorT& axis, uint8_t kind, uint8_t i, uint8_t j) {
+				Precision overlap = std::numeric_limits<Precision>::max();
+				VectorT found{};
+				if (!testAxis(axis, a, b, overlap, found))
+					return false;
+
+				// parallel edges
+				if (glm::length2(found) == Precision(0.0))
+					return true;
+
+				bool better = first ? true :
+					(kind == best.kind ? overlap < best.overlap : overlap < relTolerance * best.overlap - absTolerance);
+
+				if (better) {
+					best.axis = found;
+					best.overlap = overlap;
+					best.kind = kind;
+					best.i = i;
+					best.j = j;
+					first = false;
+				}
+				return true;
+			};
+
+			for (uint8_t i = 0; i < 3; ++i) {
+				if (!consider(a.getAxis(i), 0, i, 0))
 					return std::nullopt;
 			}
+
+			for (uint8_t j = 0; j < 3; ++j) {
+				if (!consider(b.getAxis(j), 1, j, 0))
+					return std::nullopt;
+			}
+
+			for (uint8_t i = 0; i < 3; ++i) {
+				for (uint8_t j = 0; j < 3; ++j) {
+					if (!consider(glm::cross(a.getAxis(i), b.getAxis(j)), 2, i, j))
+						return std::nullopt;
+				}
+			}
+
+			if (glm::dot(b.getCenter() - a.getCenter(), best.axis) < Precision(0.0)) {
+				best.axis = -best.axis;
+			}
+			return best;
 		}
 
-		auto ba = b.getCenter() - a.getCenter();
-		if (glm::dot(ba, minAxis) < Precision(0.0)) {
-			minAxis = -minAxis;
+		template <Vector VectorT>
+		struct ClipVertex {
+			VectorT p{};
+			uint8_t tag = 0;
+		};
+
+		template <Vector VectorT>
+		using ClipPolygon = std::array<ClipVertex<VectorT>, 8>;
+
+		// Sutherland-Hodgman, keeps the part of the polygon where dot(normal, p) <= offset.
+		// each plane adds at most one vertex, so a quad clipped by 4 planes fits in 8
+		template <Vector VectorT>
+		uint8_t clipPolygon(const ClipPolygon<VectorT>& in, uint8_t count, ClipPolygon<VectorT>& out, const VectorT& normal, typename VectorT::value_type offset, uint8_t plane) {
+			using Precision = typename VectorT::value_type;
+
+			uint8_t outCount = 0;
+			for (uint8_t k = 0; k < count; ++k) {
+				const auto& v0 = in[k];
+				const auto& v1 = in[(k + 1) % count];
+
+				auto d0 = glm::dot(normal, v0.p) - offset;
+				auto d1 = glm::dot(normal, v1.p) - offset;
+
+				if (d0 <= Precision(0.0)) {
+					out[outCount++] = v0;
+				}
+
+				if ((d0 <= Precision(0.0)) != (d1 <= Precision(0.0))) {
+					auto t = d0 / (d0 - d1);
+					out[outCount++] = ClipVertex<VectorT>{ v0.p + (v1.p - v0.p) * t, uint8_t(16 + plane * 16 + v0.tag % 16) };
+				}
+			}
+			return outCount;
 		}
 
-		Collision<VectorT> out{};
-		out.normal = minAxis;
-		out.depth = minOverlap * 2.0f;
+		// keeps the deepest point, the one furthest from it and the two that span the most area on either side
+		template <class PointT, Vector VectorT>
+		uint8_t reduceContacts(std::array<PointT, 8>& points, uint8_t count, const VectorT& normal) {
+			using Precision = typename VectorT::value_type;
+
+			if (count <= 4)
+				return count;
+
+			auto argBest = [&](auto&& score) {
+				uint8_t best = 0;
+				auto bestScore = score(points[0]);
+				for (uint8_t k = 1; k < count; ++k) {
+					auto s = score(points[k]);
+					if (s > bestScore) {
+						bestScore = s;
+						best = k;
+					}
+				}
+				return best;
+			};
 
-		// @TODO figure out why GJK-EPA MTV is wrong (but collision points are right)
-		auto points = getCollision(getSupportFn(a), getSupportFn(b), 8 + 8);
-		if (!points) {
+			auto i0 = argBest([](const PointT& p) { return p.depth; });
+			auto p0 = points[i0].b;
+
+			auto i1 = argBest([&](const PointT& p) { return glm::distance2(p.b, p0); });
+			auto edge = points[i1].b - p0;
+
+			auto area = [&](const PointT& p) {
+				return glm::dot(glm::cross(edge, p.b - p0), normal);
+			};
+
+			auto i2 = argBest(area);
+			auto i3 = argBest([&](const PointT& p) { return -area(p); });
+
+			std::array<PointT, 8> out{};
+			uint8_t outCount = 0;
+			for (auto idx : { i0, i1, i2, i3 }) {
+				bool duplicate = false;
+				for (uint8_t k = 0; k < outCount; ++k) {
+					duplicate |= glm::distance2(out[k].b, points[idx].b) <= Precision(0.0);
+				}
+
+				if (!duplicate) {
+					out[outCount++] = points[idx];
+				}
+			}
+
+			points = out;
+			return outCount;
+		}
+	}
+
+	// Contact manifold from the SAT axis, face contacts clip the incident face against the reference face.
+	// edge contacts produce the single closest point between the two edges
+	template <Vector VectorT> [[nodiscard]]
+	constexpr std::optional<Manifold<VectorT>> getManifold(const BakedOriRect<VectorT>& a, const BakedOriRect<VectorT>& b) {
+		using Precision = typename BakedOriRect<VectorT>::Precision;
+		using Point = typename Manifold<VectorT>::Point;
+
+		// keeps feature ids nonzero
+		constexpr uint32_t known = 0x80000000u;
+
+		const auto& axesA = a.getAxes();
+		const auto& axesB = b.getAxes();
+
+		auto sat = detail::findObbAxis(a, b);
+		if (!sat)
 			return std::nullopt;
+
+		Manifold<VectorT> out{};
+		out.normal = sat->axis;
+
+		if (sat->kind == 2) {
+			auto dirA = axesA[sat->i];
+			auto dirB = axesB[sat->j];
+			auto extentA = a.getHalfExtents()[sat->i];
+			auto extentB = b.getHalfExtents()[sat->j];
+
+			// the edges furthest along the normal on a and against it on b
+			auto edgeA = a.getCenter();
+			auto edgeB = b.getCenter();
+			for (glm::length_t k = 0; k < 3; ++k) {
+				if (k != sat->i) {
+					auto sign = glm::dot(axesA[k], sat->axis) > Precision(0.0) ? Precision(1.0) : Precision(-1.0);
+					edgeA += axesA[k] * (sign * a.getHalfExtents()[k]);
+				}
+				if (k != sat->j) {
+					auto sign = glm::dot(axesB[k], sat->axis) > Precision(0.0) ? Precision(-1.0) : Precision(1.0);
+					edgeB += axesB[k] * (sign * b.getHalfExtents()[k]);
+				}
+			}
+
+			auto r = edgeA - edgeB;
+			auto d = glm::dot(dirA, dirB);
+			auto c = glm::dot(dirA, r);
+			auto f = glm::dot(dirB, r);
+			auto denom = Precision(1.0) - d * d;
+
+			auto s = denom > Precision(0.000001) ? std::clamp((d * f - c) / denom, -extentA, extentA) : Precision(0.0);
+			auto t = std::clamp(d * s + f, -extentB, extentB);
+			s = std::clamp(d * t - c, -extentA, extentA);
+
+			out.points[0] = Point{ edgeA + dirA * s, edgeB + dirB * t, sat->overlap, known | (2u << 24) | (uint32_t(sat->i) << 16) | (uint32_t(sat->j) << 8) };
+			out.count = 1;
+			return out;
+		}
+
+		bool refIsA = sat->kind == 0;
+		const auto& ref = refIsA ? a : b;
+		const auto& inc = refIsA ? b : a;
+		const auto& axesR = refIsA ? axesA : axesB;
+		const auto& axesI = refIsA ? axesB : axesA;
+		auto refNormal = refIsA ? sat->axis : -sat->axis;
+		auto refAxis = glm::length_t(sat->i);
+		auto hR = ref.getHalfExtents();
+		auto hI = inc.getHalfExtents();
+
+		// the incident face is the one most anti-parallel to the reference face
+		glm::length_t incAxis = 0;
+		Precision bestAlign = Precision(-1.0);
+		for (glm::length_t k = 0; k < 3; ++k) {
+			auto align = std::abs(glm::dot(axesI[k], refNormal));
+			if (align > bestAlign) {
+				bestAlign = align;
+				incAxis = k;
+			}
 		}
-		out.a = points->a;
-		out.b = points->b;
+
+		auto incSign = glm::dot(axesI[incAxis], refNormal) > Precision(0.0) ? Precision(-1.0) : Precision(1.0);
+		auto faceCenter = inc.getCenter() + axesI[incAxis] * (incSign * hI[incAxis]);
+		auto u = axesI[(incAxis + 1) % 3] * hI[(incAxis + 1) % 3];
+		auto v = axesI[(incAxis + 2) % 3] * hI[(incAxis + 2) % 3];
+
+		detail::ClipPolygon<VectorT> poly{};
+		poly[0] = { faceCenter + u + v, 0 };
+		poly[1] = { faceCenter - u + v, 1 };
+		poly[2] = { faceCenter - u - v, 2 };
+		poly[3] = { faceCenter + u - v, 3 };
+		uint8_t count = 4;
+
+		detail::ClipPolygon<VectorT> tmp{};
+		uint8_t plane = 0;
+		for (glm::length_t k = 1; k < 3 && count > 0; ++k) {
+			auto side = axesR[(refAxis + k) % 3];
+			auto extent = hR[(refAxis + k) % 3];
+			auto offset = glm::dot(side, ref.getCenter());
+
+			count = detail::clipPolygon(poly, count, tmp, side, offset + extent, plane++);
+			count = detail::clipPolygon(tmp, count, poly, -side, -offset + extent, plane++);
+		}
+
+		auto faceOffset = glm::dot(refNormal, ref.getCenter()) + hR[refAxis];
+		auto refFace = uint32_t(refAxis * 2) + (glm::dot(refNormal, axesR[refAxis]) > Precision(0.0) ? 1u : 0u);
+		auto incFace = uint32_t(incAxis * 2) + (incSign > Precision(0.0) ? 1u : 0u);
+
+		std::array<Point, 8> found{};
+		uint8_t foundCount = 0;
+		for (uint8_t k = 0; k < count; ++k) {
+			const auto& p = poly[k].p;
+			auto separation = glm::dot(refNormal, p) - faceOffset;
+			if (separation > Precision(0.0))
+				continue;
+
+			auto onRef = p - refNormal * separation;
+
+			auto& point = found[foundCount++];
+			point.a = refIsA ? onRef : p;
+			point.b = refIsA ? p : onRef;
+			point.depth = -separation;
+			point.feature = known | (uint32_t(sat->kind) << 24) | (refFace << 16) | (incFace << 8) | poly[k].tag;
+		}
+
+		if (foundCount == 0) [[unlikely]] {
+			// the axis only barely overlapped, fall back to the closest points
+			auto points = getCollision(getSupportFn(a), getSupportFn(b), 8 + 8);
+			if (!points)
+				return std::nullopt;
+
+			out.points[0] = Point{ points->a, points->b, sat->overlap, 0 };
+			out.count = 1;
+			return out;
+		}
+
+		foundCount = detail::reduceContacts(found, foundCount, out.normal);
+		for (uint8_t k = 0; k < foundCount; ++k) {
+			out.points[k] = found[k];
+		}
+		out.count = foundCount;
 		return out;
 	}
 
+	template <Vector VectorT> [[nodiscard]]
+	constexpr std::optional<Manifold<VectorT>> getManifold(const OriRect<VectorT>& a, const OriRect<VectorT>& b) {
+		return getManifold(BakedOriRect<VectorT>{ a }, BakedOriRect<VectorT>{ b });
+	}
+
+	template <Vector VectorT> [[nodiscard]]
+	constexpr std::optional<Manifold<VectorT>> getManifold(const OriRect<VectorT>& a, const Rect<VectorT>& b) {
+		return getManifold(a, OriRect<VectorT>{ b, glm::quat{ 1.0f, 0.0f, 0.0f, 0.0f } });
+	}
+
+	template <Vector VectorT> [[nodiscard]]
+	constexpr std::optional<Manifold<VectorT>> getManifold(const Rect<VectorT>& a, const OriRect<VectorT>& b) {
+		return getManifold(OriRect<VectorT>{ a, glm::quat{ 1.0f, 0.0f, 0.0f, 0.0f } }, b);
+	}
+
+	template <Vector VectorT> [[nodiscard]]
+	constexpr std::optional<Manifold<VectorT>> getManifold(const Rect<VectorT>& a, const Rect<VectorT>& b) requires (VectorT::length() == 3) {
+		return getManifold(OriRect<VectorT>{ a, glm::quat{ 1.0f, 0.0f, 0.0f, 0.0f } }, b);
+	}
+
+	template <Vector VectorT> [[nodiscard]]
+	constexpr std::optional<Collision<VectorT>> getCollision(const BakedOriRect<VectorT>& a, const BakedOriRect<VectorT>& b) {
+		if (auto manifold = getManifold(a, b)) {
+			return manifold->toCollision();
+		}
+		return std::nullopt;
+	}
+
+	template <Vector VectorT> [[nodiscard]]
+	constexpr std::optional<Collision<VectorT>> getCollision(const OriRect<VectorT>& a, const OriRect<VectorT>& b) {
+		return getCollision(BakedOriRect<VectorT>{ a }, BakedOriRect<VectorT>{ b });
+	}
+
 	template <Vector VectorT> [[nodiscard]]
 	constexpr std::optional<Collision<VectorT>> getCollision(const OriRect<VectorT>& a, const Rect<VectorT>& b) {
 		return getCollision(a, OriRect<VectorT>(b));
 	}
 
 	template <Vector VectorT> [[nodiscard]]
-	constexpr std::optional<Collision<VectorT>> getCollision(const OriRect<VectorT>& a, const Circle<VectorT>& b) {
-		using Precision = typename Rect<VectorT>::Precision;
-
-		auto basis = glm::mat3_cast(glm::normalize(a.getRotation()));
+	constexpr std::optional<Collision<VectorT>> getCollision(const BakedOriRect<VectorT>& a, const Circle<VectorT>& b) {
+		using Precision = typename BakedOriRect<VectorT>::Precision;
 
-		auto ab = b.getCenter() - a.getCenter();
+		const auto& basis = a.getAxes();
 
-		VectorT local = glm::transpose(basis) * ab;
+		VectorT local = a.toLocal(b.getCenter());
 
 		auto closest = glm::clamp(local, -a.getHalfExtents(), a.getHalfExtents());
-		auto world = a.getCenter() + basis * closest;
+		auto world = a.toWorld(closest);
 
 		auto delta = b.getCenter() - world;
 		auto len2 = glm::length2(delta);
@@ -804,6 +1201,11 @@ namespace sndx::collision {
 		return out;
 	}
 
+	template <Vector VectorT> [[nodiscard]]
+	constexpr std::optional<Collision<VectorT>> getCollision(const OriRect<VectorT>& a, const Circle<VectorT>& b) {
+		return getCollision(BakedOriRect<VectorT>{ a }, b);
+	}
+
 	template <Vector VectorT> [[nodiscard]]
 	constexpr std::optional<Collision<VectorT>> getCollision(const OriRect<VectorT>& a, const Tri<VectorT>& b) {
 		// GJK + EPA wins over SAT in this case
@@ -855,18 +1257,23 @@ namespace sndx::collision {
 	// ==========================
 	// = Arbitrary Convex (gjk) =
 	// ==========================
-	template <std::invocable<glm::vec3> FnA, std::invocable<glm::vec3> FnB> [[nodiscard]]
+	template <SupportFn<glm::vec3> FnA, SupportFn<glm::vec3> FnB> [[nodiscard]]
 	bool hasCollision(FnA&& sptA, FnB&& sptB, uint16_t maxIterations = 32) {
 		return bool(gjk(sptA, sptB, maxIterations));
 	}
 
+	template <SupportFn<glm::vec2> FnA, SupportFn<glm::vec2> FnB> [[nodiscard]]
+	bool hasCollision(FnA&& sptA, FnB&& sptB, uint16_t maxIterations = 32) {
+		return bool(gjk2D(sptA, sptB, maxIterations));
+	}
+
 	template <class T, class U> [[nodiscard]]
 	bool hasCollision(const T& a, const U& b) {
 		// slow fallback, avoid where possible
 		return bool(getCollision(a, b));
 	}
 
-	template <std::invocable<glm::vec3> FnA, std::invocable<glm::vec3> FnB> [[nodiscard]]
+	template <SupportFn<glm::vec3> FnA, SupportFn<glm::vec3> FnB> [[nodiscard]]
 	std::optional<Collision3D> getCollision(FnA&& sptA, FnB&& sptB, uint16_t maxIterations = 32) {
 		if (auto simplex = gjk(sptA, sptB, maxIterations)) {
 			EpaResult res = epa(*simplex, std::forward<FnA>(sptA), std::forward<FnB>(sptB));
@@ -878,4 +1285,18 @@ namespace sndx::collision {
 		}
 		return std::nullopt;
 	}
+
+	template <SupportFn<glm::vec2> FnA, SupportFn<glm::vec2> FnB> [[nodiscard]]
+	std::optional<Collision2D> getCollision(FnA&& sptA, FnB&& sptB, uint16_t maxIterations = 32) {
+		if (auto simplex = gjk2D(sptA, sptB, maxIterations)) {
+			EpaResult2D res = epa2D(*simplex, std::forward<FnA>(sptA), std::forward<FnB>(sptB));
+
+			// res.normal faces out of a - b, the same convention as the analytic tests
+			return Collision2D{
+				.normal = res.normal, .depth = res.depth,
+				.a = res.a, .b = res.b,
+			};
+		}
+		return std::nullopt;
+	}
 }
\ No newline at end of file
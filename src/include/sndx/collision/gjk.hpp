@@ -3,9 +3,14 @@
 #include "./triangle.hpp"
 
 #include <array>
+#include <cfloat>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
 #include <optional>
 #include <span>
 #include <stdexcept>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -38,6 +43,12 @@ namespace sndx::collision {
 		}
 	}
 
+	// a support function of a shape in the space of VectorT.
+	// the return type decides the dimension, glm will happily convert the argument
+	template <class Fn, class VectorT>
+	concept SupportFn = std::invocable<Fn, VectorT> &&
+		std::same_as<std::remove_cvref_t<std::invoke_result_t<Fn, VectorT>>, VectorT>;
+
 	struct SimplexGJK {
 		using Vec = glm::vec3;
 		
@@ -381,39 +392,171 @@ namespace sndx::collision {
 		}
 	};
 
+	namespace detail {
+		// gjk continuing from a partial simplex with the origin in direction dir.
+		// supports counts every support evaluation, lastDir is the last search direction
+		template <class SFnA, class SFnB> [[nodiscard]]
+		std::optional<SimplexGJK> gjkFrom(const SFnA& supportA, const SFnB& supportB, SimplexGJK simplex, glm::vec3 dir, uint16_t maxIterations, uint32_t& supports, glm::vec3& lastDir) {
+			size_t iterations = 0;
+
+			while (iterations < maxIterations) {
+				auto support = detail::gjkMinkowski(supportA, supportB, dir);
+				++supports;
+				lastDir = dir;
+
+				// some unalignment is okay
+				auto align = glm::dot(support.out, dir);
+				auto lenSq = glm::dot(dir, dir) * glm::dot(support.out, support.out);
+
+				constexpr float threshold = -0.05f;
+				// a lone starting point can't tell which side the origin is on yet, a seeded face can
+				if (align < 0.0f && align * align > threshold * threshold * lenSq && (iterations > 0 || simplex.size > 1)) {
+					return std::nullopt;
+				}
+
+				assert(!std::isnan(support.out.x));
+			
+
+				simplex.push_front(support);
+				if (simplex.gjkOrigin(dir)) {
+					return simplex;
+				}
+
+				++iterations;
+			}
+			return std::nullopt;
+		}
+
+		// gjk starting from an already evaluated support point
+		template <class SFnA, class SFnB> [[nodiscard]]
+		std::optional<SimplexGJK> gjkFrom(const SFnA& supportA, const SFnB& supportB, MinkowskiDiff support, uint16_t maxIterations, uint32_t& supports, glm::vec3& lastDir) {
+			SimplexGJK simplex{};
+			simplex.push_front(support);
+
+			return gjkFrom(supportA, supportB, simplex, glm::normalize(-support.out), maxIterations, supports, lastDir);
+		}
+	}
+
 	template <class SFnA, class SFnB> [[nodiscard]]
 	std::optional<SimplexGJK> gjk(const SFnA& supportA, const SFnB& supportB, uint16_t maxIterations = 32) {
 		auto support = detail::gjkMinkowski(supportA, supportB, glm::vec3(1.0, 0.0, 0.0));
 
-		SimplexGJK simplex{};
-		simplex.push_front(support);
+		uint32_t supports = 1;
+		glm::vec3 lastDir{};
+		return detail::gjkFrom(supportA, supportB, support, maxIterations, supports, lastDir);
+	}
 
-		size_t iterations = 0;
+	// what gjk remembers about a pair between queries
+	struct GjkWarmStart {
+		// last search direction of the previous query, zero if there wasn't one
+		glm::vec3 axis{ 0.0f };
 
-		auto dir = glm::normalize(-support.out);
-		while (iterations < maxIterations) {
-			support = detail::gjkMinkowski(supportA, supportB, dir);
+		// directions that find the corners of the simplex that enclosed the origin last time
+		std::array<glm::vec3, 4> corners{};
 
-			// some unalignment is okay
-			auto align = glm::dot(support.out, dir);
-			auto lenSq = glm::dot(dir, dir) * glm::dot(support.out, support.out);
+		// the previous query missed, so axis was separating the shapes
+		bool separating = false;
 
-			constexpr float threshold = -0.05f;
-			if (align < 0.0f && align * align > threshold * threshold * lenSq && iterations > 0) {
-				return std::nullopt;
+		// the previous query hit, corners are set
+		bool enclosed = false;
+
+		// support evaluations used by the last query
+		uint32_t supports = 0;
+	};
+
+	namespace detail {
+		// full containment test, unlike gjkOrigin it makes no assumption about which side the origin was found on.
+		// if the origin is outside, simplex is reduced to the face it is furthest outside of and dir points at it
+		[[nodiscard]]
+		inline bool tetrahedronContainsOrigin(SimplexGJK& simplex, glm::vec3& dir) {
+			constexpr std::array<std::array<uint8_t, 4>, 4> faces{ {
+				{ 0, 1, 2, 3 }, { 0, 1, 3, 2 }, { 0, 2, 3, 1 }, { 1, 2, 3, 0 }
+			} };
+
+			float furthest = 0.0f;
+			std::optional<std::array<uint8_t, 3>> outside{};
+
+			for (const auto& [i, j, k, opposite] : faces) {
+				const auto& p = simplex.points[i].out;
+				auto normal = glm::cross(simplex.points[j].out - p, simplex.points[k].out - p);
+
+				// face the normal away from the opposite corner,
+				// the winding has to follow since gjk expects cross(ab, ac) to face the search direction
+				bool flipped = glm::dot(normal, simplex.points[opposite].out - p) > 0.0f;
+				if (flipped)
+					normal = -normal;
+
+				auto len = glm::length(normal);
+				if (len <= 0.0f) // flat, can't enclose anything
+					return false;
+
+				auto distance = glm::dot(normal, -p) / len;
+				if (distance > furthest) {
+					furthest = distance;
+					outside = flipped ? std::array<uint8_t, 3>{ i, k, j } : std::array<uint8_t, 3>{ i, j, k };
+					dir = normal / len;
+				}
 			}
 
-			assert(!std::isnan(support.out.x));
-			
+			if (!outside)
+				return true;
 
-			simplex.push_front(support);
-			if (simplex.gjkOrigin(dir)) {
-				return simplex;
+			const auto& [i, j, k] = *outside;
+			simplex = SimplexGJK{ { simplex.points[i], simplex.points[j], simplex.points[k] }, 3 };
+			return false;
+		}
+	}
+
+	// gjk seeded from the previous query of the same pair.
+	// a pair that touched last time re-evaluates the simplex that enclosed the origin, four supports if it still does.
+	// otherwise the first support is taken along the last search direction,
+	// if the pair was separated and that axis still separates them this costs a single support evaluation
+	template <class SFnA, class SFnB> [[nodiscard]]
+	std::optional<SimplexGJK> gjk(const SFnA& supportA, const SFnB& supportB, GjkWarmStart& warm, uint16_t maxIterations = 32) {
+		glm::vec3 lastDir{};
+		std::optional<SimplexGJK> out{};
+
+		if (warm.enclosed) {
+			SimplexGJK simplex{};
+			for (const auto& dir : warm.corners) {
+				simplex.push_front(detail::gjkMinkowski(supportA, supportB, dir));
 			}
+			warm.supports = 4;
 
-			++iterations;
+			glm::vec3 dir{};
+			if (detail::tetrahedronContainsOrigin(simplex, dir))
+				return simplex;
+
+			// carry on from the face the origin slipped out of
+			out = detail::gjkFrom(supportA, supportB, simplex, dir, maxIterations, warm.supports, lastDir);
 		}
-		return std::nullopt;
+		else {
+			bool hasAxis = glm::length2(warm.axis) > 0.0f;
+			auto start = hasAxis ? warm.axis : glm::vec3(1.0, 0.0, 0.0);
+
+			auto support = detail::gjkMinkowski(supportA, supportB, start);
+			warm.supports = 1;
+
+			// every point of the minkowski difference is behind the axis, so the origin is too
+			if (hasAxis && warm.separating && glm::dot(support.out, start) < 0.0f)
+				return std::nullopt;
+
+			out = detail::gjkFrom(supportA, supportB, support, maxIterations, warm.supports, lastDir);
+		}
+
+		warm.axis = lastDir;
+		warm.separating = !out;
+		warm.enclosed = out && out->size == 4;
+
+		if (warm.enclosed) {
+			// pointing from the middle of the simplex out through a corner finds it again while the shapes barely move
+			auto center = (out->points[0].out + out->points[1].out + out->points[2].out + out->points[3].out) * 0.25f;
+			for (size_t i = 0; i < 4; ++i) {
+				warm.corners[3 - i] = out->points[i].out - center;
+			}
+		}
+
+		return out;
 	}
 
 	struct ResDistGJK {
@@ -529,21 +672,243 @@ namespace sndx::collision {
 		}
 	}
 
-	template <class SFnA, class SFnB> [[nodiscard]]
-	EpaResult epa(const SimplexGJK& simplex, const SFnA& supportA, const SFnB& supportB) {
-		std::vector<detail::MinkowskiDiff> polytope{ simplex.points[0], simplex.points[1], simplex.points[2], simplex.points[3] };
-		std::vector<size_t> faces{
-			0, 1, 2,
-			0, 3, 1,
-			0, 2, 3,
-			1, 3, 2,
+	namespace detail {
+		// fixed capacity storage that moves to the heap if it overflows.
+		// heap storage is kept around, so a spilled buffer only allocates again if it needs to grow
+		template <class T, size_t capacity>
+		class ArenaVector {
+		private:
+			std::array<T, capacity> m_inline{};
+			std::vector<T> m_heap{};
+			size_t m_size = 0;
+			bool m_spilled = false;
+
+			void spill(size_t& allocations) {
+				if (m_heap.capacity() < capacity * 2) {
+					m_heap.reserve(capacity * 2);
+					++allocations;
+				}
+
+				m_heap.assign(m_inline.begin(), m_inline.begin() + m_size);
+				m_spilled = true;
+			}
+
+		public:
+			void push_back(const T& value, size_t& allocations) {
+				if (!m_spilled) {
+					if (m_size < capacity) {
+						m_inline[m_size++] = value;
+						return;
+					}
+					spill(allocations);
+				}
+
+				if (m_heap.size() == m_heap.capacity())
+					++allocations;
+
+				m_heap.push_back(value);
+				++m_size;
+			}
+
+			void pop_back() noexcept {
+				if (m_spilled)
+					m_heap.pop_back();
+
+				--m_size;
+			}
+
+			void clear() noexcept {
+				m_heap.clear();
+				m_spilled = false;
+				m_size = 0;
+			}
+
+			[[nodiscard]]
+			T* data() noexcept {
+				return m_spilled ? m_heap.data() : m_inline.data();
+			}
+
+			[[nodiscard]]
+			const T* data() const noexcept {
+				return m_spilled ? m_heap.data() : m_inline.data();
+			}
+
+			[[nodiscard]]
+			T& operator[](size_t i) noexcept {
+				return data()[i];
+			}
+
+			[[nodiscard]]
+			const T& operator[](size_t i) const noexcept {
+				return data()[i];
+			}
+
+			[[nodiscard]]
+			T& back() noexcept {
+				return data()[m_size - 1];
+			}
+
+			[[nodiscard]]
+			size_t size() const noexcept {
+				return m_size;
+			}
+
+			[[nodiscard]]
+			bool empty() const noexcept {
+				return m_size == 0;
+			}
+
+			[[nodiscard]]
+			bool spilled() const noexcept {
+				return m_spilled;
+			}
 		};
+	}
+
+	// Scratch storage for epa, reuse one per thread to keep epa off the heap.
+	// the capacities cover the 64 iteration limit for typical shapes, anything past them spills to the heap.
+	class EpaArena {
+	public:
+		static constexpr size_t maxPoints = 64 + 4;
+		static constexpr size_t maxFaces = 256;
+		static constexpr size_t maxEdges = 128;
+
+		struct Stats {
+			uint64_t calls = 0;
+			uint64_t iterations = 0;
+			uint64_t allocations = 0;
+
+			// from the most recent call
+			uint32_t lastIterations = 0;
+			uint32_t lastAllocations = 0;
+		};
+
+	private:
+		template <class SFnA, class SFnB>
+		friend EpaResult epa(const SimplexGJK&, const SFnA&, const SFnB&, EpaArena&);
+
+		detail::ArenaVector<detail::MinkowskiDiff, maxPoints> m_polytope{};
+		detail::ArenaVector<uint32_t, maxFaces * 3> m_faces{};
+		detail::ArenaVector<glm::vec4, maxFaces> m_normals{};
+		detail::ArenaVector<std::pair<uint32_t, uint32_t>, maxEdges> m_edges{};
+
+		Stats m_stats{};
+
+		void record(uint32_t iterations, size_t allocations) noexcept {
+			++m_stats.calls;
+			m_stats.iterations += iterations;
+			m_stats.allocations += allocations;
+			m_stats.lastIterations = iterations;
+			m_stats.lastAllocations = uint32_t(allocations);
+		}
+
+		void begin() noexcept {
+			m_polytope.clear();
+			m_faces.clear();
+			m_normals.clear();
+			m_edges.clear();
+		}
+
+		// appends normals for faces from firstFace on, returns the closest of those
+		[[nodiscard]]
+		size_t appendFaceNormals(size_t firstFace, size_t& allocations) {
+			size_t minTriangle = 0;
+			float minDistance = FLT_MAX;
+
+			for (size_t i = firstFace * 3; i < m_faces.size(); i += 3) {
+				glm::vec3 a = m_polytope[m_faces[i]].out;
+				glm::vec3 b = m_polytope[m_faces[i + 1]].out;
+				glm::vec3 c = m_polytope[m_faces[i + 2]].out;
+
+				glm::vec3 normal = glm::cross(b - a, c - a);
+				auto l = glm::length(normal);
+
+				float distance = 0.0f;
+				if (l > 0.000001f) {
+					normal /= l;
+					distance = dot(normal, a);
+				}
+
+				if (distance < 0) {
+					normal *= -1;
+					distance *= -1;
+				}
+
+				m_normals.push_back(glm::vec4(normal, distance), allocations);
+
+				if (distance < minDistance) {
+					minTriangle = i / 3 - firstFace;
+					minDistance = distance;
+				}
+			}
+
+			return minTriangle;
+		}
+
+		void addIfUniqueEdge(size_t a, size_t b, size_t& allocations) {
+			auto reversed = std::pair{ m_faces[b], m_faces[a] };
+
+			for (size_t i = 0; i < m_edges.size(); ++i) {
+				if (m_edges[i] == reversed) {
+					// keep the order, it decides the order of the new faces
+					for (size_t j = i + 1; j < m_edges.size(); ++j) {
+						m_edges[j - 1] = m_edges[j];
+					}
+					m_edges.pop_back();
+					return;
+				}
+			}
+
+			m_edges.push_back(std::pair{ m_faces[a], m_faces[b] }, allocations);
+		}
+
+	public:
+		[[nodiscard]]
+		const Stats& getStats() const noexcept {
+			return m_stats;
+		}
+
+		void resetStats() noexcept {
+			m_stats = Stats{};
+		}
+
+		// true if the last call overflowed the fixed capacity somewhere
+		[[nodiscard]]
+		bool spilled() const noexcept {
+			return m_polytope.spilled() || m_faces.spilled() || m_normals.spilled() || m_edges.spilled();
+		}
+
+		// the arena used by epa calls that don't provide their own
+		[[nodiscard]]
+		static EpaArena& threadLocal() {
+			thread_local EpaArena arena{};
+			return arena;
+		}
+	};
+
+	// same algorithm as epa() but all scratch space comes from arena
+	template <class SFnA, class SFnB> [[nodiscard]]
+	EpaResult epa(const SimplexGJK& simplex, const SFnA& supportA, const SFnB& supportB, EpaArena& arena) {
+		size_t allocations = 0;
+		arena.begin();
+
+		auto& polytope = arena.m_polytope;
+		auto& faces = arena.m_faces;
+		auto& normals = arena.m_normals;
+		auto& uniqueEdges = arena.m_edges;
+
+		for (const auto& point : simplex.points) {
+			polytope.push_back(point, allocations);
+		}
+		for (uint32_t f : { 0, 1, 2, 0, 3, 1, 0, 2, 3, 1, 3, 2 }) {
+			faces.push_back(f, allocations);
+		}
 
-		auto [normals, minFace] = GetFaceNormals(polytope, faces);
+		auto minFace = arena.appendFaceNormals(0, allocations);
 
 		glm::vec3 minNormal{};
 		float minDistance = FLT_MAX;
-		size_t i = 0;
+		uint32_t i = 0;
 
 		while (minDistance == FLT_MAX) {
 			++i;
@@ -557,67 +922,65 @@ namespace sndx::collision {
 			auto support = detail::gjkMinkowski(supportA, supportB, minNormal);
 			float sDistance = glm::dot(minNormal, support.out);
 
-			for (const auto& pnt : polytope) {
-				if (glm::distance2(pnt.out, support.out) < 0.000001f) {
+			for (size_t p = 0; p < polytope.size(); ++p) {
+				if (glm::distance2(polytope[p].out, support.out) < 0.000001f) {
 					sDistance = minDistance;
 					break;
 				}
 			}
 
-			if (abs(sDistance - minDistance) > 0.0001f) {
-				std::vector<std::pair<size_t, size_t>> uniqueEdges;
+			if (std::abs(sDistance - minDistance) > 0.0001f) {
+				uniqueEdges.clear();
 
-				for (size_t i = 0; i < normals.size(); i++) {
-					if (detail::similarDir(glm::vec3(normals[i]), support.out - polytope[faces[i * 3]].out)) {
-						size_t f = i * 3;
+				for (size_t n = 0; n < normals.size(); n++) {
+					if (detail::similarDir(glm::vec3(normals[n]), support.out - polytope[faces[n * 3]].out)) {
+						size_t f = n * 3;
 
-						AddIfUniqueEdge(uniqueEdges, faces, f, f + 1);
-						AddIfUniqueEdge(uniqueEdges, faces, f + 1, f + 2);
-						AddIfUniqueEdge(uniqueEdges, faces, f + 2, f);
+						arena.addIfUniqueEdge(f, f + 1, allocations);
+						arena.addIfUniqueEdge(f + 1, f + 2, allocations);
+						arena.addIfUniqueEdge(f + 2, f, allocations);
 
 						faces[f + 2] = faces.back(); faces.pop_back();
 						faces[f + 1] = faces.back(); faces.pop_back();
 						faces[f] = faces.back(); faces.pop_back();
 
-						normals[i] = normals.back(); // pop-erase
+						normals[n] = normals.back(); // pop-erase
 						normals.pop_back();
 
-						i--;
+						n--;
 					}
 				}
 
 				if (uniqueEdges.empty()) {
 					// @TODO figure out why this happens
+					arena.record(i, allocations);
 					return EpaResult{};
 				}
-				assert(uniqueEdges.size() > 0);
 
-				std::vector<size_t> newFaces;
-				for (auto [edgeIndex1, edgeIndex2] : uniqueEdges) {
-					newFaces.emplace_back(edgeIndex1);
-					newFaces.emplace_back(edgeIndex2);
-					newFaces.emplace_back(polytope.size());
+				auto oldFaces = normals.size();
+				auto newPoint = uint32_t(polytope.size());
+				for (size_t e = 0; e < uniqueEdges.size(); ++e) {
+					faces.push_back(uniqueEdges[e].first, allocations);
+					faces.push_back(uniqueEdges[e].second, allocations);
+					faces.push_back(newPoint, allocations);
 				}
 
-				polytope.emplace_back(support);
+				polytope.push_back(support, allocations);
 
-				auto [newNormals, newMinFace] = GetFaceNormals(polytope, newFaces);
+				auto newMinFace = arena.appendFaceNormals(oldFaces, allocations);
 
 				float oldMinDistance = FLT_MAX;
-				for (size_t i = 0; i < normals.size(); i++) {
-					if (normals[i].w < oldMinDistance) {
-						oldMinDistance = normals[i].w;
-						minFace = i;
+				for (size_t n = 0; n < oldFaces; n++) {
+					if (normals[n].w < oldMinDistance) {
+						oldMinDistance = normals[n].w;
+						minFace = n;
 					}
 				}
 
-				if (newNormals[newMinFace].w < oldMinDistance) {
-					minFace = newMinFace + normals.size();
+				if (normals[oldFaces + newMinFace].w < oldMinDistance) {
+					minFace = newMinFace + oldFaces;
 				}
 
-				faces.insert(faces.end(), newFaces.begin(), newFaces.end());
-				normals.insert(normals.end(), newNormals.begin(), newNormals.end());
-
 				minDistance = FLT_MAX;
 			}
 		}
@@ -634,9 +997,267 @@ namespace sndx::collision {
 		result.normal = minNormal;
 		result.depth = minDistance + 0.00001f;
 
+		arena.record(i, allocations);
 		return result;
 	}
 
+	// uses the calling thread's EpaArena
+	template <class SFnA, class SFnB> [[nodiscard]]
+	EpaResult epa(const SimplexGJK& simplex, const SFnA& supportA, const SFnB& supportB) {
+		return epa(simplex, supportA, supportB, EpaArena::threadLocal());
+	}
+
+	// ==========================
+	// =        2D gjk/epa      =
+	// ==========================
+	namespace detail {
+		struct MinkowskiDiff2D {
+			glm::vec2 a, b, out;
+		};
+
+		template <class SFnA, class SFnB> [[nodiscard]]
+		MinkowskiDiff2D gjkMinkowski(SFnA&& supportA, SFnB&& supportB, glm::vec2 direction) {
+			auto a = std::forward<SFnA>(supportA)(direction);
+			auto b = std::forward<SFnB>(supportB)(-direction);
+			return MinkowskiDiff2D{ a, b, a - b };
+		}
+
+		// z of the 3d cross product
+		[[nodiscard]]
+		inline float cross2D(glm::vec2 a, glm::vec2 b) {
+			return a.x * b.y - a.y * b.x;
+		}
+
+		// perpendicular to v, on the side of towards
+		[[nodiscard]]
+		inline glm::vec2 perpTowards(glm::vec2 v, glm::vec2 towards) {
+			glm::vec2 perp{ -v.y, v.x };
+			return glm::dot(perp, towards) < 0.0f ? -perp : perp;
+		}
+	}
+
+	// a triangle is all it takes to enclose the origin in 2d
+	struct SimplexGJK2D {
+		using Vec = glm::vec2;
+
+		[[nodiscard]]
+		static constexpr size_t dimensionality() noexcept {
+			return Vec::length();
+		}
+
+		std::array<detail::MinkowskiDiff2D, 2 + 1> points{};
+		uint8_t size = 0;
+
+		void push_front(detail::MinkowskiDiff2D point) {
+			for (size_t i = points.size() - 1; i > 0; --i) {
+				points[i] = points[i - 1];
+			}
+			points[0] = point;
+			size = std::min(uint8_t(size + 1u), uint8_t(points.size()));
+		}
+
+		bool lineOrigin(Vec& newDirection) {
+			auto ab = points[1].out - points[0].out;
+			auto ao = -points[0].out;
+
+			if (detail::similarDir(ab, ao)) {
+				// the origin on the line still needs a triangle for epa, either side works
+				newDirection = detail::perpTowards(ab, ao);
+			}
+			else {
+				size = 1;
+				newDirection = ao;
+			}
+			return false;
+		}
+
+		bool triangleOrigin(Vec& newDirection) {
+			auto ab = points[1].out - points[0].out;
+			auto ac = points[2].out - points[0].out;
+			auto ao = -points[0].out;
+
+			// outwards from the edges touching the newest point
+			auto abPerp = detail::perpTowards(ab, -ac);
+			if (detail::similarDir(abPerp, ao)) {
+				size = 2;
+				newDirection = abPerp;
+				return false;
+			}
+
+			auto acPerp = detail::perpTowards(ac, -ab);
+			if (detail::similarDir(acPerp, ao)) {
+				points[1] = points[2];
+				size = 2;
+				newDirection = acPerp;
+				return false;
+			}
+
+			return true;
+		}
+
+		[[nodiscard]]
+		bool gjkOrigin(Vec& newDirection) {
+			switch (size) {
+			case 2: return lineOrigin(newDirection);
+			case 3: return triangleOrigin(newDirection);
+			default:
+				throw std::logic_error("GJK had weird number of points in simplex");
+			}
+		}
+	};
+
+	template <SupportFn<glm::vec2> SFnA, SupportFn<glm::vec2> SFnB> [[nodiscard]]
+	std::optional<SimplexGJK2D> gjk2D(const SFnA& supportA, const SFnB& supportB, uint16_t maxIterations = 32) {
+		auto support = detail::gjkMinkowski(supportA, supportB, glm::vec2(1.0f, 0.0f));
+
+		SimplexGJK2D simplex{};
+		simplex.push_front(support);
+
+		// the origin on a support point is a touch, search away from it anyways
+		auto dir = glm::length2(support.out) > 0.0f ? -support.out : glm::vec2(-1.0f, 0.0f);
+
+		for (uint16_t iterations = 0; iterations < maxIterations; ++iterations) {
+			support = detail::gjkMinkowski(supportA, supportB, dir);
+
+			if (glm::dot(support.out, dir) < 0.0f)
+				return std::nullopt;
+
+			simplex.push_front(support);
+			if (simplex.gjkOrigin(dir)) {
+				return simplex;
+			}
+		}
+		return std::nullopt;
+	}
+
+	struct EpaResult2D {
+		glm::vec2 a, b;
+		glm::vec2 normal;
+		float depth;
+	};
+
+	namespace detail {
+		// contact points where the closest point of edge pq to the origin came from
+		[[nodiscard]]
+		inline EpaResult2D epaEdgeResult(const MinkowskiDiff2D& p, const MinkowskiDiff2D& q, glm::vec2 normal, float depth) {
+			auto pq = q.out - p.out;
+			auto len = glm::dot(pq, pq);
+			auto t = len > 0.0f ? glm::clamp(glm::dot(-p.out, pq) / len, 0.0f, 1.0f) : 0.0f;
+
+			return EpaResult2D{
+				p.a + (q.a - p.a) * t,
+				p.b + (q.b - p.b) * t,
+				normal, depth + 0.00001f
+			};
+		}
+	}
+
+	// epa expanding a polygon instead of a polytope.
+	// the polygon is kept in counter clockwise order with every edge's outward normal and distance cached,
+	// so each iteration only computes the two edges it creates. never allocates
+	template <SupportFn<glm::vec2> SFnA, SupportFn<glm::vec2> SFnB> [[nodiscard]]
+	EpaResult2D epa2D(const SimplexGJK2D& simplex, const SFnA& supportA, const SFnB& supportB) {
+		constexpr uint32_t maxIterations = 64;
+		constexpr size_t maxPoints = maxIterations + 4;
+
+		std::array<detail::MinkowskiDiff2D, maxPoints> polygon{};
+		std::array<glm::vec3, maxPoints> edges{}; // outward normal, distance
+		size_t size = 0;
+
+		const auto& p = simplex.points;
+		auto area = detail::cross2D(p[1].out - p[0].out, p[2].out - p[0].out);
+
+		if (std::abs(area) > 0.000001f) {
+			polygon = { p[0], area > 0.0f ? p[1] : p[2], area > 0.0f ? p[2] : p[1] };
+			size = 3;
+		}
+		else {
+			// the origin is on a flat triangle, rebuild around it from both sides of the line
+			size_t lo = 0, hi = 0;
+			auto line = p[1].out - p[0].out;
+			if (glm::length2(p[2].out - p[0].out) > glm::length2(line)) {
+				line = p[2].out - p[0].out;
+			}
+			for (size_t i = 1; i < 3; ++i) {
+				auto d = glm::dot(p[i].out, line);
+				if (d < glm::dot(p[lo].out, line)) lo = i;
+				if (d > glm::dot(p[hi].out, line)) hi = i;
+			}
+
+			glm::vec2 left{ -line.y, line.x };
+			if (glm::length2(left) <= 0.0f) {
+				left = glm::vec2(0.0f, 1.0f);
+			}
+			left = glm::normalize(left);
+
+			auto right = detail::gjkMinkowski(supportA, supportB, -left);
+			auto above = detail::gjkMinkowski(supportA, supportB, left);
+
+			// a side without any extent means the origin is on the boundary
+			if (glm::dot(right.out, -left) <= 0.000001f)
+				return detail::epaEdgeResult(p[lo], p[hi], -left, 0.0f);
+
+			if (glm::dot(above.out, left) <= 0.000001f)
+				return detail::epaEdgeResult(p[lo], p[hi], left, 0.0f);
+
+			polygon = { p[lo], right, p[hi], above };
+			size = 4;
+		}
+
+		auto computeEdge = [&](size_t i) {
+			const auto& a = polygon[i].out;
+			auto ab = polygon[(i + 1) % size].out - a;
+			glm::vec2 normal{ ab.y, -ab.x };
+
+			auto l = glm::length(normal);
+			if (l <= 0.000001f) {
+				// zero length edges can't be closest
+				edges[i] = glm::vec3(0.0f, 0.0f, FLT_MAX);
+				return;
+			}
+
+			normal /= l;
+			edges[i] = glm::vec3(normal, std::max(glm::dot(normal, a), 0.0f));
+		};
+
+		for (size_t i = 0; i < size; ++i) {
+			computeEdge(i);
+		}
+
+		size_t minEdge = 0;
+		for (uint32_t iterations = 0; ; ++iterations) {
+			minEdge = 0;
+			for (size_t i = 1; i < size; ++i) {
+				if (edges[i].z < edges[minEdge].z) {
+					minEdge = i;
+				}
+			}
+
+			if (iterations >= maxIterations || size == maxPoints)
+				break;
+
+			glm::vec2 normal{ edges[minEdge] };
+			auto support = detail::gjkMinkowski(supportA, supportB, normal);
+
+			if (glm::dot(normal, support.out) - edges[minEdge].z <= 0.0001f)
+				break;
+
+			// insert after the closest edge, splitting it in two
+			auto at = minEdge + 1;
+			for (size_t i = size; i > at; --i) {
+				polygon[i] = polygon[i - 1];
+				edges[i] = edges[i - 1];
+			}
+			polygon[at] = support;
+			++size;
+
+			computeEdge(minEdge);
+			computeEdge(at);
+		}
+
+		return detail::epaEdgeResult(polygon[minEdge], polygon[(minEdge + 1) % size], glm::vec2(edges[minEdge]), edges[minEdge].z);
+	}
+
 	template <class Fn> [[nodiscard]]
 	auto transformSupportFn(Fn&& fnc, const glm::mat4& t, const glm::mat4& invT) {
 		return [f = std::forward<Fn>(fnc), t, iT = glm::mat3{ invT }](glm::vec3 dir) {
@@ -650,10 +1271,15 @@ namespace sndx::collision {
 		return [&](glm::vec3 dir) { return volume.supportPoint(dir); };
 	}
 
+	template <VolumeN<2> T> [[nodiscard]]
+	auto getSupportFn(const T& volume) {
+		return [&](glm::vec2 dir) { return volume.supportPoint(dir); };
+	}
+
 	template <size_t extent> [[nodiscard]]
 	auto getSupportFn(std::span<const glm::vec3, extent> points) {
 		return [points](glm::vec3 dir) {
-			auto best = std::numeric_limits<float>::min();
+			auto best = std::numeric_limits<float>::lowest();
 			glm::vec3 out{};
 			for (const auto& point : points) {
 				auto d = glm::dot(point, dir);
@@ -0,0 +1,128 @@
+#pragma once
+
+#include "./gjk.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+
+namespace sndx::collision {
+
+	// Persistent per pair gjk warm start data for temporally coherent scenes.
+	// pairs are keyed by the ids the broadphase uses, (a, b) and (b, a) are different entries.
+	// evict pairs as the broadphase reports them leaving, or call evictStale once per frame.
+	class GjkCache {
+	public:
+		using Id = uint32_t;
+
+		struct Stats {
+			uint64_t queries = 0;
+			uint64_t hits = 0; // queries seeded by an earlier query of the pair, touching or not
+			uint64_t earlyOuts = 0; // hits that were resolved by the separating axis alone
+			uint64_t supports = 0;
+
+			[[nodiscard]]
+			double hitRate() const noexcept {
+				return queries == 0 ? 0.0 : double(hits) / double(queries);
+			}
+
+			[[nodiscard]]
+			double averageSupports() const noexcept {
+				return queries == 0 ? 0.0 : double(supports) / double(queries);
+			}
+		};
+
+	private:
+		struct Entry {
+			GjkWarmStart warm{};
+			uint64_t lastFrame = 0;
+		};
+
+		std::unordered_map<uint64_t, Entry> m_entries{};
+		uint64_t m_frame = 0;
+		Stats m_stats{};
+
+		[[nodiscard]]
+		static constexpr uint64_t pairKey(Id a, Id b) noexcept {
+			return (uint64_t(a) << 32) | uint64_t(b);
+		}
+
+	public:
+		// gjk for the pair (a, b), seeded from and updating its entry
+		template <class SFnA, class SFnB> [[nodiscard]]
+		std::optional<SimplexGJK> query(Id a, Id b, const SFnA& supportA, const SFnB& supportB, uint16_t maxIterations = 32) {
+			auto& entry = m_entries[pairKey(a, b)];
+			entry.lastFrame = m_frame;
+
+			bool seeded = entry.warm.enclosed || glm::length2(entry.warm.axis) > 0.0f;
+			bool separating = seeded && entry.warm.separating;
+
+			auto out = gjk(supportA, supportB, entry.warm, maxIterations);
+
+			++m_stats.queries;
+			m_stats.supports += entry.warm.supports;
+			if (seeded) {
+				++m_stats.hits;
+				if (separating && entry.warm.supports == 1 && !out) {
+					++m_stats.earlyOuts;
+				}
+			}
+
+			return out;
+		}
+
+		// advances the frame counter used by evictStale
+		void nextFrame() noexcept {
+			++m_frame;
+		}
+
+		// call when the broadphase stops reporting the pair
+		void evict(Id a, Id b) {
+			m_entries.erase(pairKey(a, b));
+		}
+
+		// removes every entry involving id
+		void evictId(Id id) {
+			std::erase_if(m_entries, [id](const auto& kv) {
+				return Id(kv.first >> 32) == id || Id(kv.first & 0xffffffff) == id;
+			});
+		}
+
+		// removes entries that haven't been queried in the last maxAge frames
+		void evictStale(uint64_t maxAge = 1) {
+			std::erase_if(m_entries, [this, maxAge](const auto& kv) {
+				return m_frame - kv.second.lastFrame > maxAge;
+			});
+		}
+
+		void clear() noexcept {
+			m_entries.clear();
+		}
+
+		void reserve(size_t pairs) {
+			m_entries.reserve(pairs);
+		}
+
+		/* Info Methods */
+
+		[[nodiscard]]
+		bool contains(Id a, Id b) const {
+			return m_entries.contains(pairKey(a, b));
+		}
+
+		[[nodiscard]]
+		size_t size() const noexcept {
+			return m_entries.size();
+		}
+
+		[[nodiscard]]
+		const Stats& getStats() const noexcept {
+			return m_stats;
+		}
+
+		void resetStats() noexcept {
+			m_stats = Stats{};
+		}
+	};
+}
\ No newline at end of file
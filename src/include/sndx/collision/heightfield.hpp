@@ -0,0 +1,657 @@
+#pragma once
+
+#include "./aabbtree.hpp"
+#include "./collision.hpp"
+#include "./triangle.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace sndx::collision {
+
+	// A terrain collider made of a regular grid of heights, triangles are only built for the cells a query touches.
+	// sample (i, j) sits at origin + (i * cellSize.x, height * heightScale, j * cellSize.y), every cell is split
+	// along its (i, j) to (i + 1, j + 1) diagonal into two triangles facing +y.
+	// a min/max pyramid over the cells rejects whole blocks of terrain before any triangle is touched.
+	// HeightT may be uint16_t to halve the memory of float heights, see quantize.
+	template <class HeightT = float>
+		requires (std::same_as<HeightT, float> || std::same_as<HeightT, uint16_t>)
+	class HeightField {
+	public:
+		using Vec = glm::vec3;
+		using Precision = float;
+		using Height = HeightT;
+		using TriIndex = uint32_t;
+
+		static constexpr TriIndex npos = std::numeric_limits<TriIndex>::max();
+
+		// sphere casts stop once this close to a triangle
+		static constexpr Precision castTolerance = Precision(0.0001);
+		static constexpr uint32_t maxCastIterations = 64;
+
+		struct RaycastResult {
+			TriIndex index = npos;
+
+			// face normal for rays, from the surface to the sphere's center for sphere casts
+			Vec norm{};
+			float dist = std::numeric_limits<float>::max();
+
+			[[nodiscard]]
+			constexpr bool hit() const noexcept {
+				return index != npos;
+			}
+
+			[[nodiscard]]
+			constexpr float distance() const noexcept {
+				return dist;
+			}
+		};
+		using result_type = RaycastResult;
+
+	private:
+		struct Level {
+			size_t offset;
+			uint32_t width, depth;
+		};
+
+		// row major, m_width samples per row
+		std::vector<HeightT> m_heights{};
+
+		// levels 1 and up, level n covers 2^n x 2^n cells. level 0 is read straight from the samples
+		std::vector<std::pair<HeightT, HeightT>> m_pyramid{};
+		std::vector<Level> m_levels{};
+
+		uint32_t m_width, m_depth;
+		Vec m_origin;
+		glm::vec2 m_cellSize;
+		Precision m_heightScale;
+
+		[[nodiscard]]
+		uint32_t cellsX() const noexcept {
+			return m_width - 1;
+		}
+
+		[[nodiscard]]
+		uint32_t cellsZ() const noexcept {
+			return m_depth - 1;
+		}
+
+		[[nodiscard]]
+		Precision toWorld(HeightT h) const noexcept {
+			return m_origin.y + Precision(h) * m_heightScale;
+		}
+
+		[[nodiscard]]
+		uint32_t topLevel() const noexcept {
+			return uint32_t(m_levels.size());
+		}
+
+		[[nodiscard]]
+		std::pair<HeightT, HeightT> rawRange(uint32_t level, uint32_t x, uint32_t z) const noexcept {
+			if (level == 0) {
+				auto a = getSample(x, z), b = getSample(x + 1, z);
+				auto c = getSample(x, z + 1), d = getSample(x + 1, z + 1);
+				return { std::min(std::min(a, b), std::min(c, d)), std::max(std::max(a, b), std::max(c, d)) };
+			}
+
+			const auto& lvl = m_levels[level - 1];
+			return m_pyramid[lvl.offset + size_t(z) * lvl.width + x];
+		}
+
+		// world space height range of a pyramid node
+		[[nodiscard]]
+		std::pair<Precision, Precision> nodeRange(uint32_t level, uint32_t x, uint32_t z) const noexcept {
+			auto [lo, hi] = rawRange(level, x, z);
+			return { toWorld(lo), toWorld(hi) };
+		}
+
+		[[nodiscard]]
+		uint32_t levelWidth(uint32_t level) const noexcept {
+			return level == 0 ? cellsX() : m_levels[level - 1].width;
+		}
+
+		[[nodiscard]]
+		uint32_t levelDepth(uint32_t level) const noexcept {
+			return level == 0 ? cellsZ() : m_levels[level - 1].depth;
+		}
+
+		// world space xz bounds of a pyramid node
+		[[nodiscard]]
+		std::pair<glm::vec2, glm::vec2> nodeArea(uint32_t level, uint32_t x, uint32_t z) const noexcept {
+			auto x0 = x << level, z0 = z << level;
+			auto x1 = std::min((x + 1) << level, cellsX()), z1 = std::min((z + 1) << level, cellsZ());
+			return {
+				glm::vec2{ m_origin.x + Precision(x0) * m_cellSize.x, m_origin.z + Precision(z0) * m_cellSize.y },
+				glm::vec2{ m_origin.x + Precision(x1) * m_cellSize.x, m_origin.z + Precision(z1) * m_cellSize.y }
+			};
+		}
+
+		void buildPyramid() {
+			uint32_t prevWidth = cellsX(), prevDepth = cellsZ();
+			uint32_t level = 0;
+
+			while (prevWidth > 1 || prevDepth > 1) {
+				Level next{ m_pyramid.size(), (prevWidth + 1) / 2, (prevDepth + 1) / 2 };
+				m_pyramid.resize(next.offset + size_t(next.width) * next.depth);
+
+				for (uint32_t z = 0; z < next.depth; ++z) {
+					for (uint32_t x = 0; x < next.width; ++x) {
+						auto range = rawRange(level, x * 2, z * 2);
+						for (auto [cx, cz] : { std::pair{ x * 2 + 1, z * 2 }, std::pair{ x * 2, z * 2 + 1 }, std::pair{ x * 2 + 1, z * 2 + 1 } }) {
+							if (cx < prevWidth && cz < prevDepth) {
+								auto child = rawRange(level, cx, cz);
+								range.first = std::min(range.first, child.first);
+								range.second = std::max(range.second, child.second);
+							}
+						}
+						m_pyramid[next.offset + size_t(z) * next.width + x] = range;
+					}
+				}
+
+				m_levels.push_back(next);
+				prevWidth = next.width;
+				prevDepth = next.depth;
+				++level;
+			}
+		}
+
+		[[nodiscard]]
+		Tri3D cellTri(uint32_t x, uint32_t z, uint32_t half) const noexcept {
+			auto p00 = getPoint(x, z), p11 = getPoint(x + 1, z + 1);
+			if (half == 0)
+				return Tri3D{ p00, getPoint(x, z + 1), p11 };
+
+			return Tri3D{ p00, p11, getPoint(x + 1, z) };
+		}
+
+		[[nodiscard]]
+		static TriIndex cellTriIndex(uint32_t cellsPerRow, uint32_t x, uint32_t z, uint32_t half) noexcept {
+			return (z * cellsPerRow + x) * 2 + half;
+		}
+
+		// ray entry and exit of an axis aligned box, empty when first > second
+		[[nodiscard]]
+		static std::pair<Precision, Precision> slab(const Vec& from, const Vec& inv, const Vec& min, const Vec& max) noexcept {
+			auto t0 = (min - from) * inv;
+			auto t1 = (max - from) * inv;
+			auto lo = glm::min(t0, t1);
+			auto hi = glm::max(t0, t1);
+			return { std::max(std::max(lo.x, lo.y), lo.z), std::min(std::min(hi.x, hi.y), hi.z) };
+		}
+
+		// sphere tracing against one triangle, the distance to a convex shape along a line is convex
+		// so stepping by it never passes the first touch
+		[[nodiscard]]
+		static std::optional<Precision> sweepSphere(const Tri3D& tri, const Vec& from, const Vec& dir, Precision speed, Precision radius, Precision t, Precision maxT, Vec& normal) noexcept {
+			for (uint32_t i = 0; i < maxCastIterations; ++i) {
+				auto center = from + dir * t;
+				auto delta = center - tri.closestPoint(center);
+				auto dist = glm::length(delta);
+
+				if (dist - radius <= castTolerance) {
+					normal = dist > Precision(0.0) ? delta / dist : Vec{ 0.0f, 1.0f, 0.0f };
+					return t;
+				}
+
+				t += (dist - radius) / speed;
+				if (t > maxT)
+					return std::nullopt;
+			}
+
+			return std::nullopt;
+		}
+
+	public:
+		// heights is row major with width samples per row, depth rows.
+		// cellSize is the spacing along x and z
+		HeightField(uint32_t width, uint32_t depth, std::vector<HeightT> heights, const Vec& origin, const glm::vec2& cellSize, Precision heightScale = Precision(1.0)) :
+			m_heights(std::move(heights)), m_width(width), m_depth(depth), m_origin(origin), m_cellSize(cellSize), m_heightScale(heightScale) {
+
+			if (width < 2 || depth < 2)
+				throw std::invalid_argument("HeightField needs at least 2x2 samples");
+
+			if (m_heights.size() != size_t(width) * depth)
+				throw std::invalid_argument("HeightField sample count must be width * depth");
+
+			if (size_t(width - 1) * (depth - 1) * 2 >= size_t(npos))
+				throw std::length_error("Too many cells for HeightField");
+
+			if (!(cellSize.x > 0.0f) || !(cellSize.y > 0.0f))
+				throw std::invalid_argument("HeightField cell size must be positive");
+
+			if (!(heightScale > 0.0f))
+				throw std::invalid_argument("HeightField height scale must be positive");
+
+			if constexpr (std::is_same_v<HeightT, float>) {
+				for (auto h : m_heights) {
+					if (!std::isfinite(h))
+						throw std::invalid_argument("HeightField heights must be finite");
+				}
+			}
+
+			buildPyramid();
+		}
+
+		// stores float heights as uint16_t, the error is at most (max - min) / 131070
+		[[nodiscard]]
+		static HeightField quantize(uint32_t width, uint32_t depth, std::span<const float> heights, Vec origin, const glm::vec2& cellSize)
+			requires std::same_as<HeightT, uint16_t> {
+
+			if (heights.empty())
+				throw std::invalid_argument("HeightField needs at least 2x2 samples");
+
+			auto [lo, hi] = std::minmax_element(heights.begin(), heights.end());
+			if (!std::isfinite(*lo) || !std::isfinite(*hi))
+				throw std::invalid_argument("HeightField heights must be finite");
+
+			auto range = *hi - *lo;
+			auto scale = range > 0.0f ? range / 65535.0f : 1.0f;
+
+			std::vector<uint16_t> quantized{};
+			quantized.reserve(heights.size());
+			for (auto h : heights) {
+				quantized.push_back(uint16_t(std::clamp(std::round((h - *lo) / scale), 0.0f, 65535.0f)));
+			}
+
+			origin.y += *lo;
+			return HeightField{ width, depth, std::move(quantized), origin, cellSize, scale };
+		}
+
+		/* Raycasting */
+
+		// closest hit no further than maxDist, steps through the cells under the ray and
+		// skips every pyramid node the ray passes entirely above or below
+		[[nodiscard]]
+		RaycastResult raycast(const Vec& from, const Vec& dir, bool cull = false, Precision maxDist = std::numeric_limits<Precision>::max()) const {
+			RaycastResult out{};
+
+			auto [lo, hi] = nodeRange(topLevel(), 0, 0);
+			auto area = nodeArea(topLevel(), 0, 0);
+			auto inv = Precision(1.0) / dir;
+
+			auto [tEnter, tExit] = slab(from, inv, Vec{ area.first.x, lo, area.first.y }, Vec{ area.second.x, hi, area.second.y });
+			tEnter = std::max(tEnter, Precision(0.0));
+			tExit = std::min(tExit, maxDist);
+			if (!(tEnter <= tExit))
+				return out;
+
+			auto testCell = [&](uint32_t x, uint32_t z) {
+				for (uint32_t half = 0; half < 2; ++half) {
+					auto tri = cellTri(x, z, half);
+					auto res = tri.raycast(from, dir, cull);
+					if (res.hit() && res.dist <= maxDist && res.dist < out.dist) {
+						out.index = cellTriIndex(cellsX(), x, z, half);
+						out.norm = glm::normalize(res.norm);
+						out.dist = res.dist;
+					}
+				}
+			};
+
+			auto cellOf = [&](Precision t) {
+				auto p = from + dir * t;
+				auto x = std::floor((p.x - m_origin.x) / m_cellSize.x);
+				auto z = std::floor((p.z - m_origin.z) / m_cellSize.y);
+				return std::pair{
+					uint32_t(std::clamp(x, Precision(0.0), Precision(cellsX() - 1))),
+					uint32_t(std::clamp(z, Precision(0.0), Precision(cellsZ() - 1)))
+				};
+			};
+
+			auto [cx, cz] = cellOf(tEnter);
+
+			// straight up or down never leaves its cell
+			if (dir.x == Precision(0.0) && dir.z == Precision(0.0)) {
+				testCell(cx, cz);
+				return out;
+			}
+
+			auto t = tEnter;
+			auto level = topLevel();
+			while (t <= tExit) {
+				auto nx = cx >> level, nz = cz >> level;
+				auto [areaMin, areaMax] = nodeArea(level, nx, nz);
+
+				auto tx = dir.x > 0.0f ? (areaMax.x - from.x) * inv.x : dir.x < 0.0f ? (areaMin.x - from.x) * inv.x : std::numeric_limits<Precision>::max();
+				auto tz = dir.z > 0.0f ? (areaMax.y - from.z) * inv.z : dir.z < 0.0f ? (areaMin.y - from.z) * inv.z : std::numeric_limits<Precision>::max();
+				auto tLeave = std::min(std::min(tx, tz), tExit);
+
+				auto y0 = from.y + dir.y * t, y1 = from.y + dir.y * tLeave;
+				auto [hMin, hMax] = nodeRange(level, nx, nz);
+				bool overlaps = std::max(y0, y1) >= hMin && std::min(y0, y1) <= hMax;
+
+				if (overlaps) {
+					if (level > 0) {
+						--level;
+						continue;
+					}
+
+					testCell(cx, cz);
+					if (out.hit())
+						return out;
+				}
+
+				if (tLeave >= tExit)
+					break;
+
+				// step into the next node, the exit axis always moves forward so this terminates
+				auto [px, pz] = cellOf(tLeave);
+				if (tx <= tz) {
+					if (dir.x > 0.0f) {
+						if (((nx + 1) << level) >= cellsX())
+							break;
+						cx = (nx + 1) << level;
+					}
+					else {
+						if ((nx << level) == 0)
+							break;
+						cx = (nx << level) - 1;
+					}
+					cz = dir.z >= 0.0f ? std::max(cz, pz) : std::min(cz, pz);
+				}
+				else {
+					if (dir.z > 0.0f) {
+						if (((nz + 1) << level) >= cellsZ())
+							break;
+						cz = (nz + 1) << level;
+					}
+					else {
+						if ((nz << level) == 0)
+							break;
+						cz = (nz << level) - 1;
+					}
+					cx = dir.x >= 0.0f ? std::max(cx, px) : std::min(cx, px);
+				}
+
+				t = tLeave;
+				level = std::min(level + 1, topLevel());
+			}
+
+			return out;
+		}
+
+		// first contact of a sphere of radius moving from from along dir, dist is in units of dir.
+		// a sphere touching at the start reports dist 0.
+		// descends the pyramid nearest node first with nodes grown by radius
+		[[nodiscard]]
+		RaycastResult spherecast(const Vec& from, const Vec& dir, Precision radius, Precision maxDist = std::numeric_limits<Precision>::max()) const {
+			if (radius < Precision(0.0))
+				throw std::invalid_argument("HeightField spherecast radius must not be negative");
+
+			RaycastResult out{};
+			auto speed = glm::length(dir);
+			if (!(speed > Precision(0.0)))
+				return out;
+
+			auto inv = Precision(1.0) / dir;
+			auto best = maxDist;
+
+			auto entry = [&](uint32_t level, uint32_t x, uint32_t z) {
+				auto [areaMin, areaMax] = nodeArea(level, x, z);
+				auto [hMin, hMax] = nodeRange(level, x, z);
+				auto [t0, t1] = slab(from, inv,
+					Vec{ areaMin.x - radius, hMin - radius, areaMin.y - radius },
+					Vec{ areaMax.x + radius, hMax + radius, areaMax.y + radius });
+
+				t0 = std::max(t0, Precision(0.0));
+				return t0 <= t1 && t0 <= best ? t0 : std::numeric_limits<Precision>::infinity();
+			};
+
+			struct Node {
+				uint32_t level, x, z;
+				Precision t;
+			};
+
+			detail::TraversalStack<Node> stack{};
+			if (auto t = entry(topLevel(), 0, 0); t <= best) {
+				stack.push(Node{ topLevel(), 0, 0, t });
+			}
+
+			while (!stack.empty()) {
+				auto node = stack.pop();
+				if (node.t > best)
+					continue;
+
+				if (node.level == 0) {
+					for (uint32_t half = 0; half < 2; ++half) {
+						Vec normal{};
+						if (auto t = sweepSphere(cellTri(node.x, node.z, half), from, dir, speed, radius, node.t, best, normal)) {
+							if (*t < best || !out.hit()) {
+								best = *t;
+								out.index = cellTriIndex(cellsX(), node.x, node.z, half);
+								out.norm = normal;
+								out.dist = *t;
+							}
+						}
+					}
+					continue;
+				}
+
+				// push the furthest child first so the nearest is popped first
+				std::array<Node, 4> children{};
+				size_t count = 0;
+				auto childLevel = node.level - 1;
+				for (uint32_t dz = 0; dz < 2; ++dz) {
+					for (uint32_t dx = 0; dx < 2; ++dx) {
+						auto x = node.x * 2 + dx, z = node.z * 2 + dz;
+						if (x >= levelWidth(childLevel) || z >= levelDepth(childLevel))
+							continue;
+
+						if (auto t = entry(childLevel, x, z); t <= best) {
+							children[count++] = Node{ childLevel, x, z, t };
+						}
+					}
+				}
+
+				std::sort(children.begin(), children.begin() + count, [](const Node& a, const Node& b) {
+					return a.t > b.t;
+				});
+				for (size_t i = 0; i < count; ++i) {
+					stack.push(children[i]);
+				}
+			}
+
+			return out;
+		}
+
+		/* Mid Phase */
+
+		// calls fn(TriIndex, const Tri3D&) for every cell triangle whose bounds overlap, fn may return false to stop
+		template <class Fn>
+		void query(const Rect3D& bounds, Fn&& fn) const {
+			const auto& min = bounds.getP1();
+			const auto& max = bounds.getP2();
+
+			detail::TraversalStack<std::array<uint32_t, 3>> stack{};
+			stack.push({ topLevel(), 0, 0 });
+
+			while (!stack.empty()) {
+				auto [level, x, z] = stack.pop();
+
+				auto [areaMin, areaMax] = nodeArea(level, x, z);
+				if (areaMin.x > max.x || areaMax.x < min.x || areaMin.y > max.z || areaMax.y < min.z)
+					continue;
+
+				auto [hMin, hMax] = nodeRange(level, x, z);
+				if (hMin > max.y || hMax < min.y)
+					continue;
+
+				if (level == 0) {
+					for (uint32_t half = 0; half < 2; ++half) {
+						auto tri = cellTri(x, z, half);
+						if (!tri.getBounds().overlaps(bounds))
+							continue;
+
+						if (!detail::invokeContinue(fn, cellTriIndex(cellsX(), x, z, half), tri))
+							return;
+					}
+					continue;
+				}
+
+				auto childLevel = level - 1;
+				for (uint32_t dz = 0; dz < 2; ++dz) {
+					for (uint32_t dx = 0; dx < 2; ++dx) {
+						auto cx = x * 2 + dx, cz = z * 2 + dz;
+						if (cx < levelWidth(childLevel) && cz < levelDepth(childLevel)) {
+							stack.push({ childLevel, cx, cz });
+						}
+					}
+				}
+			}
+		}
+
+		// narrowphase only runs on cell triangles whose bounds overlap the shape's.
+		// calls fn(TriIndex, const Collision3D&) for every colliding triangle, fn may return false to stop
+		template <class ShapeT, class Fn>
+			requires requires (const ShapeT& s, const Tri3D& t) { sndx::collision::getBounds(s); getCollision(s, t); }
+		void collide(const ShapeT& shape, Fn&& fn) const {
+			query(sndx::collision::getBounds(shape), [&](TriIndex index, const Tri3D& tri) {
+				if (auto res = getCollision(shape, tri)) {
+					return detail::invokeContinue(fn, index, *res);
+				}
+				return true;
+			});
+		}
+
+		template <class ShapeT>
+			requires requires (const ShapeT& s, const Tri3D& t) { sndx::collision::getBounds(s); getCollision(s, t); }
+		[[nodiscard]]
+		std::vector<std::pair<TriIndex, Collision3D>> getCollisions(const ShapeT& shape) const {
+			std::vector<std::pair<TriIndex, Collision3D>> out{};
+			collide(shape, [&out](TriIndex index, const Collision3D& res) {
+				out.emplace_back(index, res);
+			});
+			return out;
+		}
+
+		/* Info Methods */
+
+		[[nodiscard]]
+		HeightT getSample(uint32_t x, uint32_t z) const noexcept {
+			return m_heights[size_t(z) * m_width + x];
+		}
+
+		// world space position of sample (x, z)
+		[[nodiscard]]
+		Vec getPoint(uint32_t x, uint32_t z) const noexcept {
+			return Vec{
+				m_origin.x + Precision(x) * m_cellSize.x,
+				toWorld(getSample(x, z)),
+				m_origin.z + Precision(z) * m_cellSize.y
+			};
+		}
+
+		// surface height below (x, z), nullopt outside the grid
+		[[nodiscard]]
+		std::optional<Precision> heightAt(Precision x, Precision z) const noexcept {
+			auto fx = (x - m_origin.x) / m_cellSize.x;
+			auto fz = (z - m_origin.z) / m_cellSize.y;
+			if (!(fx >= 0.0f && fz >= 0.0f && fx <= Precision(cellsX()) && fz <= Precision(cellsZ())))
+				return std::nullopt;
+
+			auto cx = std::min(uint32_t(fx), cellsX() - 1);
+			auto cz = std::min(uint32_t(fz), cellsZ() - 1);
+			auto u = fx - Precision(cx), v = fz - Precision(cz);
+
+			auto h00 = getPoint(cx, cz).y, h10 = getPoint(cx + 1, cz).y;
+			auto h01 = getPoint(cx, cz + 1).y, h11 = getPoint(cx + 1, cz + 1).y;
+
+			if (v >= u)
+				return h00 + (h11 - h01) * u + (h01 - h00) * v;
+
+			return h00 + (h10 - h00) * u + (h11 - h10) * v;
+		}
+
+		[[nodiscard]]
+		Tri3D getTri(TriIndex index) const {
+			if (index >= triCount())
+				throw std::out_of_range("HeightField triangle index out of range");
+
+			auto cell = index / 2;
+			return cellTri(cell % cellsX(), cell / cellsX(), index % 2);
+		}
+
+		[[nodiscard]]
+		Rect3D getBounds() const noexcept {
+			auto [lo, hi] = nodeRange(topLevel(), 0, 0);
+			auto [areaMin, areaMax] = nodeArea(topLevel(), 0, 0);
+			return Rect3D{ Vec{ areaMin.x, lo, areaMin.y }, Vec{ areaMax.x, hi, areaMax.y } };
+		}
+
+		[[nodiscard]]
+		uint32_t getWidth() const noexcept {
+			return m_width;
+		}
+
+		[[nodiscard]]
+		uint32_t getDepth() const noexcept {
+			return m_depth;
+		}
+
+		[[nodiscard]]
+		const Vec& getOrigin() const noexcept {
+			return m_origin;
+		}
+
+		[[nodiscard]]
+		const glm::vec2& getCellSize() const noexcept {
+			return m_cellSize;
+		}
+
+		[[nodiscard]]
+		Precision getHeightScale() const noexcept {
+			return m_heightScale;
+		}
+
+		// pyramid levels above the cells
+		[[nodiscard]]
+		size_t getLevelCount() const noexcept {
+			return m_levels.size();
+		}
+
+		[[nodiscard]]
+		size_t triCount() const noexcept {
+			return size_t(cellsX()) * cellsZ() * 2;
+		}
+	};
+
+	template <class HeightT> [[nodiscard]]
+	Rect3D getBounds(const HeightField<HeightT>& field) noexcept {
+		return field.getBounds();
+	}
+
+	// the deepest contact of shape against the terrain
+	template <class ShapeT, class HeightT>
+		requires requires (const ShapeT& s, const Tri3D& t) { sndx::collision::getBounds(s); getCollision(s, t); }
+	[[nodiscard]]
+	std::optional<Collision3D> getCollision(const ShapeT& shape, const HeightField<HeightT>& field) {
+		std::optional<Collision3D> out{};
+		field.collide(shape, [&out](auto, const Collision3D& res) {
+			if (!out || res.depth > out->depth) {
+				out = res;
+			}
+		});
+		return out;
+	}
+
+	template <class ShapeT, class HeightT>
+		requires requires (const ShapeT& s, const Tri3D& t) { sndx::collision::getBounds(s); getCollision(s, t); }
+	[[nodiscard]]
+	std::optional<Collision3D> getCollision(const HeightField<HeightT>& field, const ShapeT& shape) {
+		if (auto res = getCollision(shape, field))
+			return res->swapped();
+
+		return std::nullopt;
+	}
+
+	using HeightField16 = HeightField<uint16_t>;
+}
\ No newline at end of file
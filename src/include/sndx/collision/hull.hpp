@@ -0,0 +1,602 @@
+#pragma once
+
+#include "./collision.hpp"
+#include "./rect.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// define SNDX_NO_SIMD to force the scalar kernels
+#ifndef SNDX_NO_SIMD
+#if defined(__AVX2__)
+#define SNDX_HULL_SIMD 2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SNDX_HULL_SIMD 1
+#include <emmintrin.h>
+#endif
+#endif
+
+#ifndef SNDX_HULL_SIMD
+#define SNDX_HULL_SIMD 0
+#endif
+
+namespace sndx::collision {
+
+	// Convex polyhedron that knows which vertices share an edge.
+	// support queries hill-climb from a starting vertex, which is close to O(1) when it's the previous result,
+	// small hulls are scanned brute force instead since that beats climbing below bruteForceLimit vertices.
+	class ConvexHull {
+	public:
+		using Vec = glm::vec3;
+		using Precision = float;
+		using Index = uint32_t;
+
+		static constexpr size_t bruteForceLimit = 32;
+		static constexpr size_t laneWidth = 8;
+
+		struct Face {
+			// counter clockwise seen from outside
+			std::array<Index, 3> indices{};
+
+			// outward, points inside satisfy dot(normal, p) <= offset
+			glm::vec3 normal{};
+			float offset = 0.0f;
+		};
+
+	private:
+		std::vector<glm::vec3> m_vertices{};
+		std::vector<Face> m_faces{};
+
+		// neighbours of vertex i are m_adjacency[m_adjStart[i], m_adjStart[i + 1])
+		std::vector<Index> m_adjStart{};
+		std::vector<Index> m_adjacency{};
+
+		// vertex components padded to laneWidth for the brute force scan
+		std::vector<float> m_x{}, m_y{}, m_z{};
+
+		Rect3D m_bounds{ glm::vec3{ 0.0f }, glm::vec3{ 0.0f } };
+
+		[[nodiscard]]
+		static constexpr uint64_t edgeKey(Index a, Index b) noexcept {
+			return (uint64_t(a) << 32) | uint64_t(b);
+		}
+
+		struct BuildFace {
+			std::array<Index, 3> v{};
+			glm::vec3 normal{};
+			float offset = 0.0f;
+			std::vector<Index> outside{};
+			bool alive = true;
+
+			[[nodiscard]]
+			float distance(const glm::vec3& point) const noexcept {
+				return glm::dot(normal, point) - offset;
+			}
+		};
+
+		// quickhull, see Barber et al. "The Quickhull Algorithm for Convex Hulls"
+		void build(std::span<const glm::vec3> points) {
+			if (points.size() < 4)
+				throw std::invalid_argument("ConvexHull needs at least 4 points");
+
+			if (points.size() >= size_t(std::numeric_limits<Index>::max()))
+				throw std::length_error("Too many points for ConvexHull");
+
+			glm::vec3 maxAbs{ 0.0f };
+			for (const auto& p : points) {
+				if (!std::isfinite(p.x) || !std::isfinite(p.y) || !std::isfinite(p.z))
+					throw std::invalid_argument("ConvexHull points must be finite");
+
+				maxAbs = glm::max(maxAbs, glm::abs(p));
+			}
+
+			const float eps = 3.0f * FLT_EPSILON * (maxAbs.x + maxAbs.y + maxAbs.z);
+
+			// initial tetrahedron from the extreme points
+			std::array<Index, 6> extremes{};
+			for (Index i = 0; i < points.size(); ++i) {
+				for (glm::length_t axis = 0; axis < 3; ++axis) {
+					if (points[i][axis] < points[extremes[axis * 2]][axis])
+						extremes[axis * 2] = i;
+					if (points[i][axis] > points[extremes[axis * 2 + 1]][axis])
+						extremes[axis * 2 + 1] = i;
+				}
+			}
+
+			Index i0 = 0, i1 = 0;
+			float widest = -1.0f;
+			for (glm::length_t axis = 0; axis < 3; ++axis) {
+				auto width = points[extremes[axis * 2 + 1]][axis] - points[extremes[axis * 2]][axis];
+				if (width > widest) {
+					widest = width;
+					i0 = extremes[axis * 2];
+					i1 = extremes[axis * 2 + 1];
+				}
+			}
+
+			if (widest <= eps)
+				throw std::invalid_argument("ConvexHull points are all the same");
+
+			auto lineDir = glm::normalize(points[i1] - points[i0]);
+			Index i2 = 0;
+			float furthest = -1.0f;
+			for (Index i = 0; i < points.size(); ++i) {
+				auto dist = glm::length2(glm::cross(points[i] - points[i0], lineDir));
+				if (dist > furthest) {
+					furthest = dist;
+					i2 = i;
+				}
+			}
+
+			if (std::sqrt(furthest) <= eps)
+				throw std::invalid_argument("ConvexHull points are collinear");
+
+			auto planeNormal = glm::normalize(glm::cross(points[i1] - points[i0], points[i2] - points[i0]));
+			Index i3 = 0;
+			furthest = -1.0f;
+			for (Index i = 0; i < points.size(); ++i) {
+				auto dist = std::abs(glm::dot(points[i] - points[i0], planeNormal));
+				if (dist > furthest) {
+					furthest = dist;
+					i3 = i;
+				}
+			}
+
+			if (furthest <= eps)
+				throw std::invalid_argument("ConvexHull points are coplanar");
+
+			if (glm::dot(points[i3] - points[i0], planeNormal) < 0.0f) {
+				std::swap(i1, i2);
+			}
+
+			std::vector<BuildFace> faces{};
+			std::unordered_map<uint64_t, uint32_t> edges{};
+
+			auto addFace = [&](Index a, Index b, Index c) {
+				BuildFace face{};
+				face.v = { a, b, c };
+
+				auto n = glm::cross(points[b] - points[a], points[c] - points[a]);
+				auto len = glm::length(n);
+				face.normal = len > 0.0f ? n / len : glm::vec3{ 0.0f };
+				face.offset = glm::dot(face.normal, points[a]);
+
+				auto id = uint32_t(faces.size());
+				faces.push_back(std::move(face));
+				edges[edgeKey(a, b)] = id;
+				edges[edgeKey(b, c)] = id;
+				edges[edgeKey(c, a)] = id;
+				return id;
+			};
+
+			auto assign = [&](Index point, std::span<const uint32_t> candidates) {
+				uint32_t best = 0;
+				float bestDist = eps;
+				bool found = false;
+				for (auto id : candidates) {
+					auto dist = faces[id].distance(points[point]);
+					if (dist > bestDist) {
+						bestDist = dist;
+						best = id;
+						found = true;
+					}
+				}
+
+				if (found) {
+					faces[best].outside.push_back(point);
+				}
+			};
+
+			std::vector<uint32_t> created{
+				addFace(i0, i2, i1),
+				addFace(i0, i1, i3),
+				addFace(i1, i2, i3),
+				addFace(i2, i0, i3)
+			};
+
+			for (Index i = 0; i < points.size(); ++i) {
+				if (i != i0 && i != i1 && i != i2 && i != i3) {
+					assign(i, created);
+				}
+			}
+
+			std::vector<uint32_t> pending = created;
+			std::vector<uint8_t> state{};
+			std::vector<uint32_t> visible{};
+			std::vector<uint32_t> stack{};
+			std::vector<std::pair<Index, Index>> horizon{};
+			std::vector<Index> orphans{};
+
+			// 0 unknown, 1 visible, 2 hidden
+			constexpr uint8_t unknown = 0, seen = 1, hidden = 2;
+
+			while (!pending.empty()) {
+				auto current = pending.back();
+				pending.pop_back();
+
+				if (!faces[current].alive || faces[current].outside.empty())
+					continue;
+
+				Index eye = faces[current].outside.front();
+				float eyeDist = -1.0f;
+				for (auto point : faces[current].outside) {
+					auto dist = faces[current].distance(points[point]);
+					if (dist > eyeDist) {
+						eyeDist = dist;
+						eye = point;
+					}
+				}
+
+				// flood the faces the eye can see, their border with the rest is the horizon
+				state.assign(faces.size(), unknown);
+				visible.clear();
+				horizon.clear();
+				stack.clear();
+
+				state[current] = seen;
+				visible.push_back(current);
+				stack.push_back(current);
+
+				while (!stack.empty()) {
+					auto id = stack.back();
+					stack.pop_back();
+
+					for (size_t e = 0; e < 3; ++e) {
+						auto a = faces[id].v[e];
+						auto b = faces[id].v[(e + 1) % 3];
+						auto twin = edges.at(edgeKey(b, a));
+
+						if (state[twin] == unknown) {
+							state[twin] = faces[twin].distance(points[eye]) > eps ? seen : hidden;
+							if (state[twin] == seen) {
+								visible.push_back(twin);
+								stack.push_back(twin);
+							}
+						}
+
+						if (state[twin] == hidden) {
+							horizon.emplace_back(a, b);
+						}
+					}
+				}
+
+				orphans.clear();
+				for (auto id : visible) {
+					auto& face = faces[id];
+					face.alive = false;
+					for (auto point : face.outside) {
+						if (point != eye) {
+							orphans.push_back(point);
+						}
+					}
+					face.outside.clear();
+					face.outside.shrink_to_fit();
+
+					for (size_t e = 0; e < 3; ++e) {
+						auto key = edgeKey(face.v[e], face.v[(e + 1) % 3]);
+						if (auto it = edges.find(key); it != edges.end() && it->second == id) {
+							edges.erase(it);
+						}
+					}
+				}
+
+				created.clear();
+				for (const auto& [a, b] : horizon) {
+					created.push_back(addFace(a, b, eye));
+				}
+
+				for (auto point : orphans) {
+					assign(point, created);
+				}
+
+				pending.insert(pending.end(), created.begin(), created.end());
+			}
+
+			// compact to the vertices that made it onto the hull, in input order
+			std::vector<Index> remap(points.size(), std::numeric_limits<Index>::max());
+			for (const auto& face : faces) {
+				if (face.alive) {
+					for (auto v : face.v) {
+						remap[v] = 0;
+					}
+				}
+			}
+
+			m_vertices.clear();
+			for (Index i = 0; i < points.size(); ++i) {
+				if (remap[i] == 0) {
+					remap[i] = Index(m_vertices.size());
+					m_vertices.push_back(points[i]);
+				}
+			}
+
+			m_faces.clear();
+			for (const auto& face : faces) {
+				if (face.alive) {
+					m_faces.push_back(Face{ { remap[face.v[0]], remap[face.v[1]], remap[face.v[2]] }, face.normal, face.offset });
+				}
+			}
+
+			// every edge is shared by two faces, once in each direction
+			m_adjStart.assign(m_vertices.size() + 1, 0);
+			for (const auto& face : m_faces) {
+				for (auto v : face.indices) {
+					++m_adjStart[v + 1];
+				}
+			}
+
+			for (size_t i = 1; i < m_adjStart.size(); ++i) {
+				m_adjStart[i] += m_adjStart[i - 1];
+			}
+
+			m_adjacency.resize(m_adjStart.back());
+			std::vector<Index> fill(m_adjStart.begin(), m_adjStart.end() - 1);
+			for (const auto& face : m_faces) {
+				for (size_t e = 0; e < 3; ++e) {
+					auto a = face.indices[e];
+					m_adjacency[fill[a]++] = face.indices[(e + 1) % 3];
+				}
+			}
+
+			auto padded = (m_vertices.size() + laneWidth - 1) / laneWidth * laneWidth;
+			m_x.assign(padded, m_vertices.front().x);
+			m_y.assign(padded, m_vertices.front().y);
+			m_z.assign(padded, m_vertices.front().z);
+
+			glm::vec3 lo{ std::numeric_limits<float>::max() };
+			glm::vec3 hi{ std::numeric_limits<float>::lowest() };
+			for (size_t i = 0; i < m_vertices.size(); ++i) {
+				m_x[i] = m_vertices[i].x;
+				m_y[i] = m_vertices[i].y;
+				m_z[i] = m_vertices[i].z;
+				lo = glm::min(lo, m_vertices[i]);
+				hi = glm::max(hi, m_vertices[i]);
+			}
+			m_bounds = Rect3D{ lo, hi };
+		}
+
+	public:
+		// builds the hull of a point cloud, interior and duplicate points are dropped.
+		// throws std::invalid_argument if the points don't span a volume
+		explicit ConvexHull(std::span<const glm::vec3> points) {
+			build(points);
+		}
+
+		explicit ConvexHull(const std::vector<glm::vec3>& points) :
+			ConvexHull(std::span<const glm::vec3>{ points }) {}
+
+		/* Query Methods */
+
+		// index of the vertex furthest along direction, checking every vertex.
+		// ties go to the lowest index
+		[[nodiscard]]
+		Index supportBruteForce(const glm::vec3& direction) const noexcept {
+			Index best = 0;
+			size_t i = 0;
+
+#if SNDX_HULL_SIMD == 2
+			const auto dx = _mm256_set1_ps(direction.x), dy = _mm256_set1_ps(direction.y), dz = _mm256_set1_ps(direction.z);
+			auto bestVal = _mm256_set1_ps(std::numeric_limits<float>::lowest());
+			auto bestIdx = _mm256_setzero_si256();
+			auto idx = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+			const auto step = _mm256_set1_epi32(8);
+
+			for (; i < m_vertices.size(); i += 8) {
+				auto dot = _mm256_add_ps(_mm256_add_ps(
+					_mm256_mul_ps(_mm256_loadu_ps(m_x.data() + i), dx),
+					_mm256_mul_ps(_mm256_loadu_ps(m_y.data() + i), dy)),
+					_mm256_mul_ps(_mm256_loadu_ps(m_z.data() + i), dz));
+
+				auto better = _mm256_cmp_ps(dot, bestVal, _CMP_GT_OQ);
+				bestVal = _mm256_blendv_ps(bestVal, dot, better);
+				bestIdx = _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(bestIdx), _mm256_castsi256_ps(idx), better));
+				idx = _mm256_add_epi32(idx, step);
+			}
+
+			alignas(32) float vals[8];
+			alignas(32) int32_t idxs[8];
+			_mm256_store_ps(vals, bestVal);
+			_mm256_store_si256(reinterpret_cast<__m256i*>(idxs), bestIdx);
+			constexpr size_t lanes = 8;
+#elif SNDX_HULL_SIMD == 1
+			const auto dx = _mm_set1_ps(direction.x), dy = _mm_set1_ps(direction.y), dz = _mm_set1_ps(direction.z);
+			auto bestVal = _mm_set1_ps(std::numeric_limits<float>::lowest());
+			auto bestIdx = _mm_setzero_si128();
+			auto idx = _mm_setr_epi32(0, 1, 2, 3);
+			const auto step = _mm_set1_epi32(4);
+
+			for (; i < m_vertices.size(); i += 4) {
+				auto dot = _mm_add_ps(_mm_add_ps(
+					_mm_mul_ps(_mm_loadu_ps(m_x.data() + i), dx),
+					_mm_mul_ps(_mm_loadu_ps(m_y.data() + i), dy)),
+					_mm_mul_ps(_mm_loadu_ps(m_z.data() + i), dz));
+
+				auto better = _mm_cmpgt_ps(dot, bestVal);
+				bestVal = _mm_or_ps(_mm_and_ps(better, dot), _mm_andnot_ps(better, bestVal));
+				bestIdx = _mm_or_si128(
+					_mm_and_si128(_mm_castps_si128(better), idx),
+					_mm_andnot_si128(_mm_castps_si128(better), bestIdx));
+				idx = _mm_add_epi32(idx, step);
+			}
+
+			alignas(16) float vals[4];
+			alignas(16) int32_t idxs[4];
+			_mm_store_ps(vals, bestVal);
+			_mm_store_si128(reinterpret_cast<__m128i*>(idxs), bestIdx);
+			constexpr size_t lanes = 4;
+#else
+			float bestDot = std::numeric_limits<float>::lowest();
+			for (; i < m_vertices.size(); ++i) {
+				auto dot = m_x[i] * direction.x + m_y[i] * direction.y + m_z[i] * direction.z;
+				if (dot > bestDot) {
+					bestDot = dot;
+					best = Index(i);
+				}
+			}
+#endif
+
+#if SNDX_HULL_SIMD != 0
+			// padding lanes repeat vertex 0, so they can only tie with it
+			float bestDot = vals[0];
+			best = Index(idxs[0]);
+			for (size_t lane = 1; lane < lanes; ++lane) {
+				if (vals[lane] > bestDot || (vals[lane] == bestDot && Index(idxs[lane]) < best)) {
+					bestDot = vals[lane];
+					best = Index(idxs[lane]);
+				}
+			}
+			best = std::min(best, Index(m_vertices.size() - 1));
+#endif
+			return best;
+		}
+
+		// index of the vertex furthest along direction, walking the edges from start.
+		// steps counts the vertices moved through
+		[[nodiscard]]
+		Index supportHillClimb(const glm::vec3& direction, Index start, uint32_t& steps) const noexcept {
+			auto current = start < m_vertices.size() ? start : Index(0);
+			auto best = glm::dot(m_vertices[current], direction);
+
+			// the hull is convex, so a vertex with no better neighbour is the global maximum
+			bool moved = true;
+			while (moved) {
+				moved = false;
+				for (auto i = m_adjStart[current]; i < m_adjStart[current + 1]; ++i) {
+					auto neighbour = m_adjacency[i];
+					auto dot = glm::dot(m_vertices[neighbour], direction);
+					if (dot > best) {
+						best = dot;
+						current = neighbour;
+						moved = true;
+						++steps;
+						break;
+					}
+				}
+			}
+			return current;
+		}
+
+		// picks brute force or hill climbing based on the vertex count, start is only used by the latter
+		[[nodiscard]]
+		Index supportIndex(const glm::vec3& direction, Index start = 0) const noexcept {
+			if (m_vertices.size() <= bruteForceLimit)
+				return supportBruteForce(direction);
+
+			uint32_t steps = 0;
+			return supportHillClimb(direction, start, steps);
+		}
+
+		[[nodiscard]]
+		const glm::vec3& supportPoint(const glm::vec3& direction) const noexcept {
+			return m_vertices[supportIndex(direction)];
+		}
+
+		// tolerance > 0 also accepts points slightly outside
+		[[nodiscard]]
+		bool contains(const glm::vec3& point, float tolerance = 0.0f) const noexcept {
+			for (const auto& face : m_faces) {
+				if (glm::dot(face.normal, point) - face.offset > tolerance)
+					return false;
+			}
+			return true;
+		}
+
+		/* Info Methods */
+
+		[[nodiscard]]
+		const std::vector<glm::vec3>& getVertices() const noexcept {
+			return m_vertices;
+		}
+
+		[[nodiscard]]
+		const glm::vec3& getVertex(Index index) const {
+			return m_vertices.at(index);
+		}
+
+		[[nodiscard]]
+		const std::vector<Face>& getFaces() const noexcept {
+			return m_faces;
+		}
+
+		// vertices sharing an edge with index
+		[[nodiscard]]
+		std::span<const Index> getNeighbours(Index index) const {
+			if (index >= m_vertices.size())
+				throw std::out_of_range("ConvexHull vertex index out of range");
+
+			return std::span<const Index>{ m_adjacency.data() + m_adjStart[index], m_adjacency.data() + m_adjStart[index + 1] };
+		}
+
+		[[nodiscard]]
+		const Rect3D& getBounds() const noexcept {
+			return m_bounds;
+		}
+
+		[[nodiscard]]
+		size_t size() const noexcept {
+			return m_vertices.size();
+		}
+
+		[[nodiscard]]
+		bool usesHillClimbing() const noexcept {
+			return m_vertices.size() > bruteForceLimit;
+		}
+	};
+
+	// Support function that starts each query from the previous answer.
+	// gjk and epa directions change little between iterations, so most queries take a step or two.
+	// keep one per shape per query, it's cheap to copy but not thread safe to share
+	class HullSupport {
+	private:
+		const ConvexHull* m_hull;
+		mutable ConvexHull::Index m_last = 0;
+		mutable uint64_t m_steps = 0;
+
+	public:
+		explicit HullSupport(const ConvexHull& hull) noexcept :
+			m_hull(&hull) {}
+
+		glm::vec3 operator()(const glm::vec3& direction) const noexcept {
+			if (m_hull->usesHillClimbing()) {
+				uint32_t steps = 0;
+				m_last = m_hull->supportHillClimb(direction, m_last, steps);
+				m_steps += steps;
+			}
+			else {
+				m_last = m_hull->supportBruteForce(direction);
+			}
+			return m_hull->getVertices()[m_last];
+		}
+
+		[[nodiscard]]
+		ConvexHull::Index getLast() const noexcept {
+			return m_last;
+		}
+
+		// total vertices walked, 0 for brute force hulls
+		[[nodiscard]]
+		uint64_t getSteps() const noexcept {
+			return m_steps;
+		}
+	};
+
+	[[nodiscard]]
+	inline HullSupport getSupportFn(const ConvexHull& hull) noexcept {
+		return HullSupport{ hull };
+	}
+
+	[[nodiscard]]
+	inline Rect3D getBounds(const ConvexHull& hull) noexcept {
+		return hull.getBounds();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,120 @@
+#pragma once
+
+#include "./collision.hpp"
+
+#include <array>
+#include <cstdint>
+#include <span>
+
+namespace sndx::collision {
+
+	// Contact points of one pair carried across frames, so a solver can warm start every point.
+	// fresh points inherit the accumulated impulses of the old point with the same feature id,
+	// or failing that the closest old point within the match distance.
+	class PersistentManifold {
+	public:
+		struct Point : Manifold3D::Point {
+			float normalImpulse = 0.0f;
+			glm::vec2 tangentImpulse{ 0.0f };
+
+			// updates the point has survived
+			uint32_t age = 0;
+		};
+
+		// normals further apart than this (as a cosine) are a different contact
+		static constexpr float normalTolerance = 0.95f;
+
+	private:
+		glm::vec3 m_normal{};
+		std::array<Point, Manifold3D::maxPoints> m_points{};
+		uint8_t m_count = 0;
+		float m_matchDistance2;
+
+	public:
+		explicit PersistentManifold(float matchDistance = 0.02f) :
+			m_matchDistance2(matchDistance * matchDistance) {}
+
+		// replaces the points with fresh ones, returns how many were matched to an old point
+		size_t update(const Manifold3D& fresh) {
+			std::array<Point, Manifold3D::maxPoints> next{};
+			std::array<bool, Manifold3D::maxPoints> used{};
+			size_t matched = 0;
+
+			bool coherent = m_count > 0 && glm::dot(m_normal, fresh.normal) >= normalTolerance;
+
+			for (uint8_t i = 0; i < fresh.count; ++i) {
+				const auto& point = fresh.points[i];
+				static_cast<Manifold3D::Point&>(next[i]) = point;
+
+				if (!coherent)
+					continue;
+
+				uint8_t best = m_count;
+				if (point.feature != 0) {
+					for (uint8_t j = 0; j < m_count; ++j) {
+						if (!used[j] && m_points[j].feature == point.feature) {
+							best = j;
+							break;
+						}
+					}
+				}
+
+				if (best == m_count) {
+					auto bestDist = m_matchDistance2;
+					for (uint8_t j = 0; j < m_count; ++j) {
+						auto dist = glm::distance2(m_points[j].b, point.b);
+						if (!used[j] && dist <= bestDist) {
+							bestDist = dist;
+							best = j;
+						}
+					}
+				}
+
+				if (best != m_count) {
+					used[best] = true;
+					next[i].normalImpulse = m_points[best].normalImpulse;
+					next[i].tangentImpulse = m_points[best].tangentImpulse;
+					next[i].age = m_points[best].age + 1;
+					++matched;
+				}
+			}
+
+			m_normal = fresh.normal;
+			m_points = next;
+			m_count = fresh.count;
+			return matched;
+		}
+
+		void clear() noexcept {
+			m_count = 0;
+		}
+
+		/* Info Methods */
+
+		// from a towards b
+		[[nodiscard]]
+		const glm::vec3& getNormal() const noexcept {
+			return m_normal;
+		}
+
+		[[nodiscard]]
+		std::span<Point> getPoints() noexcept {
+			return std::span<Point>{ m_points.data(), m_count };
+		}
+
+		[[nodiscard]]
+		std::span<const Point> getPoints() const noexcept {
+			return std::span<const Point>{ m_points.data(), m_count };
+		}
+
+		[[nodiscard]]
+		size_t size() const noexcept {
+			return m_count;
+		}
+
+		[[nodiscard]]
+		bool empty() const noexcept {
+			return m_count == 0;
+		}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,198 @@
+#pragma once
+
+#include "./collision.hpp"
+
+#include <algorithm>
+#include <concepts>
+#include <cstdint>
+#include <execution>
+#include <limits>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace sndx::collision {
+
+	using Shape3D = std::variant<Circle3D, Capsule3D, Rect3D, OriRect3D, Tri3D>;
+
+	// picks the specialized overload when there is one, otherwise falls back to gjk + epa
+	template <class... Ts> [[nodiscard]]
+	std::optional<Collision3D> getCollision(const std::variant<Ts...>& a, const std::variant<Ts...>& b) {
+		return std::visit([](const auto& sa, const auto& sb) -> std::optional<Collision3D> {
+			if constexpr (requires { { getCollision(sa, sb) } -> std::same_as<std::optional<Collision3D>>; }) {
+				return getCollision(sa, sb);
+			}
+			else {
+				return getCollision(getSupportFn(sa), getSupportFn(sb));
+			}
+		}, a, b);
+	}
+
+	// the multi point manifold when the pair has one, otherwise the single getCollision point
+	template <class... Ts> [[nodiscard]]
+	std::optional<Manifold3D> getManifold(const std::variant<Ts...>& a, const std::variant<Ts...>& b) {
+		return std::visit([](const auto& sa, const auto& sb) -> std::optional<Manifold3D> {
+			if constexpr (requires { { getManifold(sa, sb) } -> std::same_as<std::optional<Manifold3D>>; }) {
+				return getManifold(sa, sb);
+			}
+			else {
+				std::optional<Collision3D> res{};
+				if constexpr (requires { { getCollision(sa, sb) } -> std::same_as<std::optional<Collision3D>>; }) {
+					res = getCollision(sa, sb);
+				}
+				else {
+					res = getCollision(getSupportFn(sa), getSupportFn(sb));
+				}
+
+				if (res) {
+					return Manifold3D{ *res };
+				}
+				return std::nullopt;
+			}
+		}, a, b);
+	}
+
+	// Runs getCollision over a list of candidate pairs from a broadphase.
+	// pairs are split into chunks that run in parallel, every pair writes only its own slot
+	// and the hit list is compacted in pair order, so results don't depend on the thread count.
+	// ResultT may be Manifold3D to run getManifold instead.
+	template <class ShapeT = Shape3D, class ResultT = Collision3D>
+	class Narrowphase {
+	public:
+		using Index = uint32_t;
+		using Pair = std::pair<Index, Index>;
+
+		static constexpr size_t defaultChunkSize = 64;
+
+	private:
+		std::vector<ResultT> m_results{};
+		std::vector<uint8_t> m_hit{};
+		std::vector<Index> m_hits{};
+		std::vector<size_t> m_chunks{};
+		size_t m_chunkSize;
+
+		[[nodiscard]]
+		static std::optional<ResultT> test(const ShapeT& a, const ShapeT& b) {
+			if constexpr (std::is_same_v<ResultT, Manifold3D>) {
+				return getManifold(a, b);
+			}
+			else {
+				return getCollision(a, b);
+			}
+		}
+
+		void prepare(std::span<const ShapeT> shapes, std::span<const Pair> pairs) {
+			if (pairs.size() > size_t(std::numeric_limits<Index>::max()))
+				throw std::length_error("Too many pairs for Narrowphase");
+
+			// exceptions can't escape a parallel algorithm, check up front
+			for (const auto& [a, b] : pairs) {
+				if (a >= shapes.size() || b >= shapes.size())
+					throw std::out_of_range("Narrowphase pair refers to a missing shape");
+			}
+
+			m_results.resize(pairs.size());
+			m_hit.assign(pairs.size(), 0);
+			m_hits.clear();
+
+			m_chunks.clear();
+			for (size_t start = 0; start < pairs.size(); start += m_chunkSize) {
+				m_chunks.push_back(start);
+			}
+		}
+
+		auto chunkFn(std::span<const ShapeT> shapes, std::span<const Pair> pairs) {
+			return [this, shapes, pairs](size_t start) {
+				auto end = std::min(start + m_chunkSize, pairs.size());
+				for (auto i = start; i < end; ++i) {
+					const auto& [a, b] = pairs[i];
+					if (auto res = test(shapes[a], shapes[b])) {
+						m_results[i] = *res;
+						m_hit[i] = 1;
+					}
+				}
+			};
+		}
+
+		void compact() {
+			for (size_t i = 0; i < m_hit.size(); ++i) {
+				if (m_hit[i]) {
+					m_hits.push_back(Index(i));
+				}
+			}
+		}
+
+	public:
+		explicit Narrowphase(size_t chunkSize = defaultChunkSize) :
+			m_chunkSize(std::max(chunkSize, size_t(1))) {}
+
+		void reserve(size_t pairs) {
+			m_results.reserve(pairs);
+			m_hit.reserve(pairs);
+			m_hits.reserve(pairs);
+			m_chunks.reserve(pairs / m_chunkSize + 1);
+		}
+
+#ifndef __APPLE__
+		void run(auto&& policy, std::span<const ShapeT> shapes, std::span<const Pair> pairs) {
+			prepare(shapes, pairs);
+			std::for_each(std::forward<decltype(policy)>(policy), m_chunks.begin(), m_chunks.end(), chunkFn(shapes, pairs));
+			compact();
+		}
+#endif
+
+		// epa allocates, so this defaults to par rather than par_unseq
+		void run(std::span<const ShapeT> shapes, std::span<const Pair> pairs) {
+#ifndef __APPLE__
+			run(std::execution::par, shapes, pairs);
+#else
+			prepare(shapes, pairs);
+			std::for_each(m_chunks.begin(), m_chunks.end(), chunkFn(shapes, pairs));
+			compact();
+#endif
+		}
+
+		void run(const std::vector<ShapeT>& shapes, const std::vector<Pair>& pairs) {
+			run(std::span<const ShapeT>{ shapes }, std::span<const Pair>{ pairs });
+		}
+
+		/* Info Methods */
+
+		// indices into the pair list of every colliding pair, ascending
+		[[nodiscard]]
+		const std::vector<Index>& getHits() const noexcept {
+			return m_hits;
+		}
+
+		[[nodiscard]]
+		bool isHit(size_t pairIdx) const {
+			return m_hit.at(pairIdx) != 0;
+		}
+
+		// only meaningful when isHit(pairIdx)
+		[[nodiscard]]
+		const ResultT& getResult(size_t pairIdx) const {
+			return m_results.at(pairIdx);
+		}
+
+		// one slot per pair from the last run
+		[[nodiscard]]
+		std::span<const ResultT> getResults() const noexcept {
+			return m_results;
+		}
+
+		[[nodiscard]]
+		size_t hitCount() const noexcept {
+			return m_hits.size();
+		}
+
+		[[nodiscard]]
+		size_t getChunkSize() const noexcept {
+			return m_chunkSize;
+		}
+	};
+}
\ No newline at end of file
@@ -223,4 +223,101 @@ namespace sndx::collision {
 
 		return OriRect3D{center, in.getHalfExtents() * lens, glm::quat_cast(basis) };
 	}
+
+	// An OriRect with its rotation matrix precomputed, for SAT heavy loops.
+	// bake each box once per frame and reuse it for every pair it's in,
+	// the OriRect collision functions bake internally and give the same results.
+	template <Vector VectorT = glm::vec3>
+		requires (VectorT::length() == 3)
+	class BakedOriRect {
+	public:
+		using Vec = VectorT;
+		using Precision = Vec::value_type;
+		using Axes = glm::mat<3, 3, Precision>;
+
+		static constexpr size_t dimensionality() noexcept {
+			return Vec::length();
+		}
+
+	protected:
+		Axes axes;
+		Vec center;
+		Vec halfExtents;
+
+	public:
+		constexpr explicit BakedOriRect(const OriRect<Vec>& rect) :
+			axes(glm::mat3_cast(glm::normalize(rect.getRotation()))), center(rect.getCenter()), halfExtents(rect.getHalfExtents()) {}
+
+		[[nodiscard]]
+		OriRect<Vec> unbake() const {
+			return OriRect<Vec>{ center, halfExtents, glm::quat_cast(axes) };
+		}
+
+		/* Info Methods */
+
+		[[nodiscard]]
+		constexpr const Vec& getCenter() const noexcept {
+			return center;
+		}
+
+		[[nodiscard]]
+		constexpr const Vec& getHalfExtents() const noexcept {
+			return halfExtents;
+		}
+
+		// columns are the world space axes
+		[[nodiscard]]
+		constexpr const Axes& getAxes() const noexcept {
+			return axes;
+		}
+
+		[[nodiscard]]
+		constexpr const Vec& getAxis(glm::length_t axis) const noexcept {
+			return axes[axis];
+		}
+
+		[[nodiscard]] // does not account for orientation
+		constexpr Vec getSize() const noexcept {
+			return halfExtents * Precision(2.0);
+		}
+
+		[[nodiscard]]
+		constexpr Precision getArea() const noexcept {
+			return glm::compMul(getSize());
+		}
+
+		[[nodiscard]]
+		constexpr Vec toLocal(const Vec& point) const noexcept {
+			return glm::transpose(axes) * (point - center);
+		}
+
+		[[nodiscard]]
+		constexpr Vec toWorld(const Vec& local) const noexcept {
+			return center + axes * local;
+		}
+
+		[[nodiscard]] // unsigned, like OriRect
+		constexpr Precision distance(const Vec& point) const noexcept {
+			auto local = toLocal(point);
+
+			Vec clamped = glm::clamp(local, -halfExtents, halfExtents);
+			return glm::distance(local, clamped);
+		}
+
+		[[nodiscard]]
+		constexpr bool contains(const Vec& point) const noexcept {
+			return distance(point) <= Precision(0.0);
+		}
+
+		[[nodiscard]]
+		constexpr Vec supportPoint(const Vec& direction) const noexcept {
+			Vec out = center;
+			for (glm::length_t axis = 0; axis < 3; ++axis) {
+				out += axes[axis] * (glm::dot(direction, axes[axis]) <= Precision(0.0) ? -halfExtents[axis] : halfExtents[axis]);
+			}
+			return out;
+		}
+	};
+
+	using BakedOriRect3D = BakedOriRect<glm::vec3>;
 }
\ No newline at end of file
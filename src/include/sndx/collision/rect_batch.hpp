@@ -0,0 +1,431 @@
+#pragma once
+
+#include "./rect.hpp"
+
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// define SNDX_NO_SIMD to force the scalar kernels
+#ifndef SNDX_NO_SIMD
+#if defined(__AVX2__)
+#define SNDX_RECT_BATCH_SIMD 2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SNDX_RECT_BATCH_SIMD 1
+#include <emmintrin.h>
+#endif
+#endif
+
+#ifndef SNDX_RECT_BATCH_SIMD
+#define SNDX_RECT_BATCH_SIMD 0
+#endif
+
+namespace sndx::collision {
+
+	// Structure of arrays storage for many Rect3Ds, tested against a single query at a time.
+	// hit/miss results match Rect3D::overlaps and Rect3D::raycast exactly.
+	class RectBatch3D {
+	public:
+		using Vec = glm::vec3;
+		using Precision = float;
+
+		static constexpr size_t laneWidth = 8;
+
+		static constexpr Precision miss = std::numeric_limits<Precision>::infinity();
+
+	private:
+		// padded to a multiple of laneWidth so the kernels can always load full lanes
+		std::vector<Precision> m_minX{}, m_minY{}, m_minZ{};
+		std::vector<Precision> m_maxX{}, m_maxY{}, m_maxZ{};
+		size_t m_size = 0;
+
+		[[nodiscard]]
+		static constexpr size_t padded(size_t count) noexcept {
+			return (count + laneWidth - 1) / laneWidth * laneWidth;
+		}
+
+		void resizeStorage(size_t count) {
+			// padding boxes are inverted so they never overlap anything finite
+			for (auto* arr : { &m_minX, &m_minY, &m_minZ }) {
+				arr->resize(count, miss);
+			}
+			for (auto* arr : { &m_maxX, &m_maxY, &m_maxZ }) {
+				arr->resize(count, -miss);
+			}
+		}
+
+		// same comparisons and order as Rect::overlaps
+		[[nodiscard]]
+		bool overlapsScalar(const Vec& qMin, const Vec& qMax, size_t i) const noexcept {
+			if (qMin.x > m_maxX[i] || qMax.x < m_minX[i]) return false;
+			if (qMin.y > m_maxY[i] || qMax.y < m_minY[i]) return false;
+			if (qMin.z > m_maxZ[i] || qMax.z < m_minZ[i]) return false;
+			return true;
+		}
+
+		// same arithmetic as Rect::raycast, testing far < near once at the end is equivalent
+		// to the early out since near only grows and far only shrinks
+		[[nodiscard]]
+		Precision raycastScalar(const Vec& from, const Vec& inv, size_t i) const noexcept {
+			auto near = std::numeric_limits<Precision>::min();
+			auto far = std::numeric_limits<Precision>::max();
+
+			auto slab = [&](Precision lo, Precision hi, Precision f, Precision invD) {
+				auto n = (lo - f) * invD;
+				auto x = (hi - f) * invD;
+				if (invD < Precision(0.0))
+					std::swap(n, x);
+
+				if (n > near) near = n;
+				if (x < far) far = x;
+			};
+
+			slab(m_minX[i], m_maxX[i], from.x, inv.x);
+			slab(m_minY[i], m_maxY[i], from.y, inv.y);
+			slab(m_minZ[i], m_maxZ[i], from.z, inv.z);
+
+			return far < near ? miss : near;
+		}
+
+	public:
+		RectBatch3D() = default;
+
+		explicit RectBatch3D(const std::vector<Rect3D>& rects) {
+			reserve(rects.size());
+			for (const auto& rect : rects) {
+				push_back(rect);
+			}
+		}
+
+		void reserve(size_t count) {
+			auto n = padded(count);
+			for (auto* arr : { &m_minX, &m_minY, &m_minZ, &m_maxX, &m_maxY, &m_maxZ }) {
+				arr->reserve(n);
+			}
+		}
+
+		size_t push_back(const Rect3D& rect) {
+			auto idx = m_size;
+			++m_size;
+			resizeStorage(padded(m_size));
+			set(idx, rect);
+			return idx;
+		}
+
+		void set(size_t idx, const Rect3D& rect) {
+			if (idx >= m_size)
+				throw std::out_of_range("RectBatch3D index out of range");
+
+			const auto& p1 = rect.getP1();
+			const auto& p2 = rect.getP2();
+			m_minX[idx] = p1.x; m_minY[idx] = p1.y; m_minZ[idx] = p1.z;
+			m_maxX[idx] = p2.x; m_maxY[idx] = p2.y; m_maxZ[idx] = p2.z;
+		}
+
+		// moves the last box into idx
+		void swapRemove(size_t idx) {
+			if (idx >= m_size)
+				throw std::out_of_range("RectBatch3D index out of range");
+
+			--m_size;
+			for (auto* arr : { &m_minX, &m_minY, &m_minZ, &m_maxX, &m_maxY, &m_maxZ }) {
+				(*arr)[idx] = (*arr)[m_size];
+			}
+
+			m_minX[m_size] = m_minY[m_size] = m_minZ[m_size] = miss;
+			m_maxX[m_size] = m_maxY[m_size] = m_maxZ[m_size] = -miss;
+			resizeStorage(padded(m_size));
+		}
+
+		void clear() noexcept {
+			for (auto* arr : { &m_minX, &m_minY, &m_minZ, &m_maxX, &m_maxY, &m_maxZ }) {
+				arr->clear();
+			}
+			m_size = 0;
+		}
+
+		[[nodiscard]]
+		Rect3D get(size_t idx) const {
+			if (idx >= m_size)
+				throw std::out_of_range("RectBatch3D index out of range");
+
+			return Rect3D{ Vec{ m_minX[idx], m_minY[idx], m_minZ[idx] }, Vec{ m_maxX[idx], m_maxY[idx], m_maxZ[idx] } };
+		}
+
+		[[nodiscard]]
+		size_t size() const noexcept {
+			return m_size;
+		}
+
+		[[nodiscard]]
+		bool empty() const noexcept {
+			return m_size == 0;
+		}
+
+		/* Query Methods */
+
+		// bit i of out is set if box i overlaps query, returns the number of overlaps
+		size_t overlapMask(const Rect3D& query, std::vector<uint64_t>& out) const {
+			out.assign((m_size + 63) / 64, 0);
+
+			const auto& qMin = query.getP1();
+			const auto& qMax = query.getP2();
+
+			size_t i = 0;
+#if SNDX_RECT_BATCH_SIMD == 2
+			const auto qMinX = _mm256_set1_ps(qMin.x), qMinY = _mm256_set1_ps(qMin.y), qMinZ = _mm256_set1_ps(qMin.z);
+			const auto qMaxX = _mm256_set1_ps(qMax.x), qMaxY = _mm256_set1_ps(qMax.y), qMaxZ = _mm256_set1_ps(qMax.z);
+
+			for (; i < m_size; i += 8) {
+				auto sep = _mm256_or_ps(
+					_mm256_cmp_ps(qMinX, _mm256_loadu_ps(m_maxX.data() + i), _CMP_GT_OQ),
+					_mm256_cmp_ps(qMaxX, _mm256_loadu_ps(m_minX.data() + i), _CMP_LT_OQ));
+				sep = _mm256_or_ps(sep, _mm256_or_ps(
+					_mm256_cmp_ps(qMinY, _mm256_loadu_ps(m_maxY.data() + i), _CMP_GT_OQ),
+					_mm256_cmp_ps(qMaxY, _mm256_loadu_ps(m_minY.data() + i), _CMP_LT_OQ)));
+				sep = _mm256_or_ps(sep, _mm256_or_ps(
+					_mm256_cmp_ps(qMinZ, _mm256_loadu_ps(m_maxZ.data() + i), _CMP_GT_OQ),
+					_mm256_cmp_ps(qMaxZ, _mm256_loadu_ps(m_minZ.data() + i), _CMP_LT_OQ)));
+
+				auto bits = uint64_t(~_mm256_movemask_ps(sep) & 0xff);
+				out[i / 64] |= bits << (i % 64);
+			}
+#elif SNDX_RECT_BATCH_SIMD == 1
+			const auto qMinX = _mm_set1_ps(qMin.x), qMinY = _mm_set1_ps(qMin.y), qMinZ = _mm_set1_ps(qMin.z);
+			const auto qMaxX = _mm_set1_ps(qMax.x), qMaxY = _mm_set1_ps(qMax.y), qMaxZ = _mm_set1_ps(qMax.z);
+
+			for (; i < m_size; i += 4) {
+				auto sep = _mm_or_ps(
+					_mm_cmpgt_ps(qMinX, _mm_loadu_ps(m_maxX.data() + i)),
+					_mm_cmplt_ps(qMaxX, _mm_loadu_ps(m_minX.data() + i)));
+				sep = _mm_or_ps(sep, _mm_or_ps(
+					_mm_cmpgt_ps(qMinY, _mm_loadu_ps(m_maxY.data() + i)),
+					_mm_cmplt_ps(qMaxY, _mm_loadu_ps(m_minY.data() + i))));
+				sep = _mm_or_ps(sep, _mm_or_ps(
+					_mm_cmpgt_ps(qMinZ, _mm_loadu_ps(m_maxZ.data() + i)),
+					_mm_cmplt_ps(qMaxZ, _mm_loadu_ps(m_minZ.data() + i))));
+
+				auto bits = uint64_t(~_mm_movemask_ps(sep) & 0xf);
+				out[i / 64] |= bits << (i % 64);
+			}
+#else
+			for (; i < m_size; ++i) {
+				out[i / 64] |= uint64_t(overlapsScalar(qMin, qMax, i)) << (i % 64);
+			}
+#endif
+
+			// the padding lanes of the last block aren't real boxes
+			if (m_size % 64 != 0) {
+				out.back() &= (uint64_t(1) << (m_size % 64)) - 1;
+			}
+
+			size_t count = 0;
+			for (auto word : out) {
+				count += size_t(std::popcount(word));
+			}
+			return count;
+		}
+
+		// calls fn(index) for every box that overlaps query, in index order
+		template <class Fn>
+		void forEachOverlap(const Rect3D& query, Fn&& fn) const {
+			std::vector<uint64_t> mask{};
+			overlapMask(query, mask);
+
+			for (size_t word = 0; word < mask.size(); ++word) {
+				for (auto bits = mask[word]; bits != 0; bits &= bits - 1) {
+					fn(word * 64 + size_t(std::countr_zero(bits)));
+				}
+			}
+		}
+
+		// out[i] is the entry distance into box i, or miss. returns the number of hits
+		size_t raycast(const Vec& from, const Vec& dir, std::vector<Precision>& out) const {
+			const Vec inv{ Precision(1.0) / dir.x, Precision(1.0) / dir.y, Precision(1.0) / dir.z };
+
+			out.resize(padded(m_size));
+
+			size_t i = 0;
+#if SNDX_RECT_BATCH_SIMD == 2
+			const auto fromX = _mm256_set1_ps(from.x), fromY = _mm256_set1_ps(from.y), fromZ = _mm256_set1_ps(from.z);
+			const auto invX = _mm256_set1_ps(inv.x), invY = _mm256_set1_ps(inv.y), invZ = _mm256_set1_ps(inv.z);
+
+			// the ray is uniform across lanes so the near/far swap is decided once per axis
+			const auto* nearX = inv.x < 0.0f ? m_maxX.data() : m_minX.data();
+			const auto* farX = inv.x < 0.0f ? m_minX.data() : m_maxX.data();
+			const auto* nearY = inv.y < 0.0f ? m_maxY.data() : m_minY.data();
+			const auto* farY = inv.y < 0.0f ? m_minY.data() : m_maxY.data();
+			const auto* nearZ = inv.z < 0.0f ? m_maxZ.data() : m_minZ.data();
+			const auto* farZ = inv.z < 0.0f ? m_minZ.data() : m_maxZ.data();
+
+			const auto missV = _mm256_set1_ps(miss);
+
+			for (; i < m_size; i += 8) {
+				// max/min(a, b) return b unless the comparison holds, same as the scalar ifs
+				auto near = _mm256_set1_ps(std::numeric_limits<Precision>::min());
+				auto far = _mm256_set1_ps(std::numeric_limits<Precision>::max());
+
+				near = _mm256_max_ps(_mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(nearX + i), fromX), invX), near);
+				far = _mm256_min_ps(_mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(farX + i), fromX), invX), far);
+				near = _mm256_max_ps(_mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(nearY + i), fromY), invY), near);
+				far = _mm256_min_ps(_mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(farY + i), fromY), invY), far);
+				near = _mm256_max_ps(_mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(nearZ + i), fromZ), invZ), near);
+				far = _mm256_min_ps(_mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(farZ + i), fromZ), invZ), far);
+
+				auto missed = _mm256_cmp_ps(far, near, _CMP_LT_OQ);
+				_mm256_storeu_ps(out.data() + i, _mm256_blendv_ps(near, missV, missed));
+			}
+#elif SNDX_RECT_BATCH_SIMD == 1
+			const auto fromX = _mm_set1_ps(from.x), fromY = _mm_set1_ps(from.y), fromZ = _mm_set1_ps(from.z);
+			const auto invX = _mm_set1_ps(inv.x), invY = _mm_set1_ps(inv.y), invZ = _mm_set1_ps(inv.z);
+
+			// the ray is uniform across lanes so the near/far swap is decided once per axis
+			const auto* nearX = inv.x < 0.0f ? m_maxX.data() : m_minX.data();
+			const auto* farX = inv.x < 0.0f ? m_minX.data() : m_maxX.data();
+			const auto* nearY = inv.y < 0.0f ? m_maxY.data() : m_minY.data();
+			const auto* farY = inv.y < 0.0f ? m_minY.data() : m_maxY.data();
+			const auto* nearZ = inv.z < 0.0f ? m_maxZ.data() : m_minZ.data();
+			const auto* farZ = inv.z < 0.0f ? m_minZ.data() : m_maxZ.data();
+
+			const auto missV = _mm_set1_ps(miss);
+
+			for (; i < m_size; i += 4) {
+				// max/min(a, b) return b unless the comparison holds, same as the scalar ifs
+				auto near = _mm_set1_ps(std::numeric_limits<Precision>::min());
+				auto far = _mm_set1_ps(std::numeric_limits<Precision>::max());
+
+				near = _mm_max_ps(_mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(nearX + i), fromX), invX), near);
+				far = _mm_min_ps(_mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(farX + i), fromX), invX), far);
+				near = _mm_max_ps(_mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(nearY + i), fromY), invY), near);
+				far = _mm_min_ps(_mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(farY + i), fromY), invY), far);
+				near = _mm_max_ps(_mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(nearZ + i), fromZ), invZ), near);
+				far = _mm_min_ps(_mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(farZ + i), fromZ), invZ), far);
+
+				auto missed = _mm_cmplt_ps(far, near);
+				_mm_storeu_ps(out.data() + i, _mm_or_ps(_mm_and_ps(missed, missV), _mm_andnot_ps(missed, near)));
+			}
+#else
+			for (; i < m_size; ++i) {
+				out[i] = raycastScalar(from, inv, i);
+			}
+#endif
+
+			out.resize(m_size);
+
+			size_t hits = 0;
+			for (auto dist : out) {
+				hits += dist != miss;
+			}
+			return hits;
+		}
+
+		// index and distance of the nearest box the ray enters, ties go to the lowest index
+		[[nodiscard]]
+		std::optional<std::pair<size_t, Precision>> raycastClosest(const Vec& from, const Vec& dir) const {
+			std::vector<Precision> dists{};
+			if (raycast(from, dir, dists) == 0)
+				return std::nullopt;
+
+			size_t best = 0;
+			for (size_t i = 1; i < dists.size(); ++i) {
+				if (dists[i] < dists[best])
+					best = i;
+			}
+
+			return std::pair{ best, dists[best] };
+		}
+
+		// bit i of out is set unless box i is entirely on the negative side of some plane,
+		// planes are (normal, offset) with dot(normal, p) + offset >= 0 on the positive side.
+		// returns the number of set bits
+		size_t planeMask(std::span<const glm::vec4> planes, std::vector<uint64_t>& out) const {
+			out.assign((m_size + 63) / 64, 0);
+
+			// the corner furthest along each normal decides, so pick its arrays once per plane
+			struct Corner {
+				const Precision* x;
+				const Precision* y;
+				const Precision* z;
+			};
+
+			std::vector<Corner> corners{};
+			corners.reserve(planes.size());
+			for (const auto& plane : planes) {
+				corners.push_back(Corner{
+					plane.x >= Precision(0.0) ? m_maxX.data() : m_minX.data(),
+					plane.y >= Precision(0.0) ? m_maxY.data() : m_minY.data(),
+					plane.z >= Precision(0.0) ? m_maxZ.data() : m_minZ.data()
+				});
+			}
+
+			size_t i = 0;
+#if SNDX_RECT_BATCH_SIMD == 2
+			const auto zero = _mm256_setzero_ps();
+
+			for (; i < m_size; i += 8) {
+				auto outside = zero;
+				for (size_t p = 0; p < planes.size(); ++p) {
+					const auto& plane = planes[p];
+					const auto& corner = corners[p];
+
+					auto d = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(
+						_mm256_mul_ps(_mm256_set1_ps(plane.x), _mm256_loadu_ps(corner.x + i)),
+						_mm256_mul_ps(_mm256_set1_ps(plane.y), _mm256_loadu_ps(corner.y + i))),
+						_mm256_mul_ps(_mm256_set1_ps(plane.z), _mm256_loadu_ps(corner.z + i))),
+						_mm256_set1_ps(plane.w));
+					outside = _mm256_or_ps(outside, _mm256_cmp_ps(d, zero, _CMP_LT_OQ));
+				}
+
+				auto bits = uint64_t(~_mm256_movemask_ps(outside) & 0xff);
+				out[i / 64] |= bits << (i % 64);
+			}
+#elif SNDX_RECT_BATCH_SIMD == 1
+			const auto zero = _mm_setzero_ps();
+
+			for (; i < m_size; i += 4) {
+				auto outside = zero;
+				for (size_t p = 0; p < planes.size(); ++p) {
+					const auto& plane = planes[p];
+					const auto& corner = corners[p];
+
+					auto d = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+						_mm_mul_ps(_mm_set1_ps(plane.x), _mm_loadu_ps(corner.x + i)),
+						_mm_mul_ps(_mm_set1_ps(plane.y), _mm_loadu_ps(corner.y + i))),
+						_mm_mul_ps(_mm_set1_ps(plane.z), _mm_loadu_ps(corner.z + i))),
+						_mm_set1_ps(plane.w));
+					outside = _mm_or_ps(outside, _mm_cmplt_ps(d, zero));
+				}
+
+				auto bits = uint64_t(~_mm_movemask_ps(outside) & 0xf);
+				out[i / 64] |= bits << (i % 64);
+			}
+#else
+			for (; i < m_size; ++i) {
+				bool inside = true;
+				for (size_t p = 0; p < planes.size() && inside; ++p) {
+					const auto& plane = planes[p];
+					const auto& corner = corners[p];
+					inside = !(plane.x * corner.x[i] + plane.y * corner.y[i] + plane.z * corner.z[i] + plane.w < Precision(0.0));
+				}
+				out[i / 64] |= uint64_t(inside) << (i % 64);
+			}
+#endif
+
+			if (m_size % 64 != 0) {
+				out.back() &= (uint64_t(1) << (m_size % 64)) - 1;
+			}
+
+			size_t count = 0;
+			for (auto word : out) {
+				count += size_t(std::popcount(word));
+			}
+			return count;
+		}
+	};
+}
\ No newline at end of file
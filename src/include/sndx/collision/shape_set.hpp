@@ -0,0 +1,237 @@
+#pragma once
+
+#include "./narrowphase.hpp"
+
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace sndx::collision {
+
+	namespace detail {
+		// the explicit template argument keeps the generic getCollision based hasCollision out of overload resolution
+		template <class A, class B>
+		concept DedicatedHasCollision = requires (const A& a, const B& b) {
+			{ hasCollision<glm::vec3>(a, b) } -> std::same_as<bool>;
+		};
+
+		template <class A, class B>
+		concept DedicatedGetCollision = requires (const A& a, const B& b) {
+			{ getCollision(a, b) } -> std::same_as<std::optional<Collision3D>>;
+		};
+
+		// direct overload, then the mirrored one, then gjk + epa
+		template <class A, class B> [[nodiscard]]
+		std::optional<Collision3D> cheapestCollision(const A& a, const B& b) {
+			if constexpr (DedicatedGetCollision<A, B>) {
+				return getCollision(a, b);
+			}
+			else if constexpr (DedicatedGetCollision<B, A>) {
+				if (auto r = getCollision(b, a))
+					return r->swapped();
+
+				return std::nullopt;
+			}
+			else {
+				return getCollision(getSupportFn(a), getSupportFn(b));
+			}
+		}
+
+		// a boolean test skips computing the contact, so gjk alone beats any getCollision that falls back to epa
+		template <class A, class B> [[nodiscard]]
+		bool cheapestTest(const A& a, const B& b) {
+			if constexpr (DedicatedHasCollision<A, B>) {
+				return hasCollision(a, b);
+			}
+			else if constexpr (DedicatedHasCollision<B, A>) {
+				return hasCollision(b, a);
+			}
+			else if constexpr (DedicatedGetCollision<A, B>) {
+				return bool(getCollision(a, b));
+			}
+			else if constexpr (DedicatedGetCollision<B, A>) {
+				return bool(getCollision(b, a));
+			}
+			else {
+				return hasCollision(getSupportFn(a), getSupportFn(b));
+			}
+		}
+	}
+
+	template <class VariantT>
+	class ShapeSet;
+
+	// Double dispatch for a closed set of shapes through an NxN function pointer table built at compile time.
+	// every entry calls the cheapest overload for its pair directly, no nested std::visit.
+	// the batch functions bucket pairs by their type pair first, so each kernel loops over pairs of one kind.
+	template <class... Ts>
+	class ShapeSet<std::variant<Ts...>> {
+	public:
+		using Shape = std::variant<Ts...>;
+		using Index = uint32_t;
+		using Pair = std::pair<Index, Index>;
+
+		using CollisionFn = std::optional<Collision3D>(*)(const Shape&, const Shape&);
+		using TestFn = bool(*)(const Shape&, const Shape&);
+
+		static constexpr size_t typeCount = sizeof...(Ts);
+		static constexpr size_t pairTypeCount = typeCount * typeCount;
+
+	private:
+		template <size_t I, size_t J>
+		static std::optional<Collision3D> collisionEntry(const Shape& a, const Shape& b) {
+			return detail::cheapestCollision(*std::get_if<I>(&a), *std::get_if<J>(&b));
+		}
+
+		template <size_t I, size_t J>
+		static bool testEntry(const Shape& a, const Shape& b) {
+			return detail::cheapestTest(*std::get_if<I>(&a), *std::get_if<J>(&b));
+		}
+
+		template <size_t I, size_t J>
+		static void collisionKernel(std::span<const Shape> shapes, std::span<const Pair> pairs, std::span<const Index> order, std::span<std::optional<Collision3D>> out) {
+			for (auto idx : order) {
+				const auto& [a, b] = pairs[idx];
+				out[idx] = detail::cheapestCollision(*std::get_if<I>(&shapes[a]), *std::get_if<J>(&shapes[b]));
+			}
+		}
+
+		template <size_t I, size_t J>
+		static void testKernel(std::span<const Shape> shapes, std::span<const Pair> pairs, std::span<const Index> order, std::span<uint8_t> out) {
+			for (auto idx : order) {
+				const auto& [a, b] = pairs[idx];
+				out[idx] = uint8_t(detail::cheapestTest(*std::get_if<I>(&shapes[a]), *std::get_if<J>(&shapes[b])));
+			}
+		}
+
+		using CollisionKernel = void(*)(std::span<const Shape>, std::span<const Pair>, std::span<const Index>, std::span<std::optional<Collision3D>>);
+		using TestKernel = void(*)(std::span<const Shape>, std::span<const Pair>, std::span<const Index>, std::span<uint8_t>);
+
+		template <size_t... Is>
+		static constexpr auto makeTables(std::index_sequence<Is...>) {
+			return std::tuple{
+				std::array<CollisionFn, pairTypeCount>{ &collisionEntry<Is / typeCount, Is % typeCount>... },
+				std::array<TestFn, pairTypeCount>{ &testEntry<Is / typeCount, Is % typeCount>... },
+				std::array<CollisionKernel, pairTypeCount>{ &collisionKernel<Is / typeCount, Is % typeCount>... },
+				std::array<TestKernel, pairTypeCount>{ &testKernel<Is / typeCount, Is % typeCount>... }
+			};
+		}
+
+		static constexpr auto tables = makeTables(std::make_index_sequence<pairTypeCount>{});
+		static constexpr auto& collisionTable = std::get<0>(tables);
+		static constexpr auto& testTable = std::get<1>(tables);
+		static constexpr auto& collisionKernels = std::get<2>(tables);
+		static constexpr auto& testKernels = std::get<3>(tables);
+
+		// pair indices grouped by pair type, group t is m_order[m_bucketStart[t], m_bucketStart[t + 1])
+		std::vector<Index> m_order{};
+		std::array<size_t, pairTypeCount + 1> m_bucketStart{};
+
+		void bucket(std::span<const Shape> shapes, std::span<const Pair> pairs) {
+			if (pairs.size() > size_t(std::numeric_limits<Index>::max()))
+				throw std::length_error("Too many pairs for ShapeSet");
+
+			for (const auto& [a, b] : pairs) {
+				if (a >= shapes.size() || b >= shapes.size())
+					throw std::out_of_range("ShapeSet pair refers to a missing shape");
+
+				if (shapes[a].valueless_by_exception() || shapes[b].valueless_by_exception())
+					throw std::bad_variant_access();
+			}
+
+			// counting sort keeps pairs of one type in their original order
+			m_bucketStart.fill(0);
+			for (const auto& [a, b] : pairs) {
+				++m_bucketStart[pairType(shapes[a], shapes[b]) + 1];
+			}
+
+			for (size_t t = 1; t < m_bucketStart.size(); ++t) {
+				m_bucketStart[t] += m_bucketStart[t - 1];
+			}
+
+			m_order.resize(pairs.size());
+			auto fill = m_bucketStart;
+			for (size_t i = 0; i < pairs.size(); ++i) {
+				const auto& [a, b] = pairs[i];
+				m_order[fill[pairType(shapes[a], shapes[b])]++] = Index(i);
+			}
+		}
+
+		[[nodiscard]]
+		std::span<const Index> bucketSpan(size_t type) const noexcept {
+			return std::span<const Index>{ m_order.data() + m_bucketStart[type], m_order.data() + m_bucketStart[type + 1] };
+		}
+
+	public:
+		ShapeSet() = default;
+
+		[[nodiscard]]
+		static constexpr size_t pairType(const Shape& a, const Shape& b) noexcept {
+			return a.index() * typeCount + b.index();
+		}
+
+		// throws std::bad_variant_access if either shape is valueless
+		[[nodiscard]]
+		static std::optional<Collision3D> getCollision(const Shape& a, const Shape& b) {
+			if (a.valueless_by_exception() || b.valueless_by_exception())
+				throw std::bad_variant_access();
+
+			return collisionTable[pairType(a, b)](a, b);
+		}
+
+		[[nodiscard]]
+		static bool hasCollision(const Shape& a, const Shape& b) {
+			if (a.valueless_by_exception() || b.valueless_by_exception())
+				throw std::bad_variant_access();
+
+			return testTable[pairType(a, b)](a, b);
+		}
+
+		// out[i] is the result for pairs[i]
+		void getCollisions(std::span<const Shape> shapes, std::span<const Pair> pairs, std::span<std::optional<Collision3D>> out) {
+			if (out.size() != pairs.size())
+				throw std::invalid_argument("ShapeSet output size must match the pair count");
+
+			bucket(shapes, pairs);
+			for (size_t type = 0; type < pairTypeCount; ++type) {
+				if (auto order = bucketSpan(type); !order.empty()) {
+					collisionKernels[type](shapes, pairs, order, out);
+				}
+			}
+		}
+
+		// out[i] is 1 if pairs[i] collides
+		void hasCollisions(std::span<const Shape> shapes, std::span<const Pair> pairs, std::span<uint8_t> out) {
+			if (out.size() != pairs.size())
+				throw std::invalid_argument("ShapeSet output size must match the pair count");
+
+			bucket(shapes, pairs);
+			for (size_t type = 0; type < pairTypeCount; ++type) {
+				if (auto order = bucketSpan(type); !order.empty()) {
+					testKernels[type](shapes, pairs, order, out);
+				}
+			}
+		}
+
+		/* Info Methods */
+
+		// pair indices of the last batch with pair type type, in pair order
+		[[nodiscard]]
+		std::span<const Index> getBucket(size_t type) const {
+			if (type >= pairTypeCount)
+				throw std::out_of_range("ShapeSet pair type out of range");
+
+			return bucketSpan(type);
+		}
+	};
+
+	using ShapeSet3D = ShapeSet<Shape3D>;
+}
\ No newline at end of file
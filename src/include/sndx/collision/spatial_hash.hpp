@@ -0,0 +1,356 @@
+#pragma once
+
+#include "./aabbtree.hpp"
+#include "./circle.hpp"
+#include "./collision.hpp"
+#include "./rect.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace sndx::collision {
+
+	// Uniform hashed grid for dense scenes of similarly sized Circles or Rects.
+	// rebuilt from scratch each frame, storage is reused so a warmed up grid doesn't allocate.
+	template <class ShapeT>
+	class SpatialHash {
+	public:
+		using Vec = typename ShapeT::Vec;
+		using Precision = typename Vec::value_type;
+		using Cell = glm::vec<Vec::length(), int32_t>;
+		using Index = uint32_t;
+
+		static constexpr size_t dimensionality() noexcept {
+			return Vec::length();
+		}
+
+	private:
+		struct Slot {
+			Cell cell{};
+			uint32_t stamp = 0; // slot is empty unless stamp matches the current build
+			Index start = 0;
+			Index count = 0;
+		};
+
+		struct CellRange {
+			Cell min{}, max{};
+		};
+
+		Precision m_cellSize;
+		Precision m_invCellSize;
+
+		std::vector<ShapeT> m_shapes{};
+		std::vector<CellRange> m_ranges{};
+
+		std::vector<Slot> m_slots{};
+		std::vector<uint32_t> m_occupied{};
+		uint32_t m_stamp = 0;
+
+		std::vector<std::pair<uint32_t, Index>> m_refs{};
+		std::vector<Index> m_indices{};
+
+		static constexpr uint32_t npos = std::numeric_limits<uint32_t>::max();
+
+		[[nodiscard]]
+		static Rect<Vec> boundsOf(const Circle<Vec>& circle) noexcept {
+			auto r = Vec{ circle.getRadius() };
+			return Rect<Vec>{ circle.getCenter() - r, circle.getCenter() + r };
+		}
+
+		[[nodiscard]]
+		static const Rect<Vec>& boundsOf(const Rect<Vec>& rect) noexcept {
+			return rect;
+		}
+
+		[[nodiscard]]
+		Cell toCell(const Vec& point) const noexcept {
+			Cell out{};
+			for (glm::length_t i = 0; i < glm::length_t(dimensionality()); ++i) {
+				out[i] = int32_t(std::floor(point[i] * m_invCellSize));
+			}
+			return out;
+		}
+
+		[[nodiscard]]
+		CellRange toRange(const Rect<Vec>& bounds) const noexcept {
+			return CellRange{ toCell(bounds.getP1()), toCell(bounds.getP2()) };
+		}
+
+		[[nodiscard]]
+		static size_t rangeCellCount(const CellRange& range) noexcept {
+			size_t out = 1;
+			for (glm::length_t i = 0; i < glm::length_t(dimensionality()); ++i) {
+				out *= size_t(range.max[i] - range.min[i]) + 1;
+			}
+			return out;
+		}
+
+		// calls fn(cell) for every cell in the range, fn may return false to stop
+		template <class Fn>
+		static bool forEachCell(const CellRange& range, Fn&& fn) {
+			Cell cell = range.min;
+			while (true) {
+				if (!detail::invokeContinue(fn, cell))
+					return false;
+
+				glm::length_t i = 0;
+				for (; i < glm::length_t(dimensionality()); ++i) {
+					if (cell[i] < range.max[i]) {
+						++cell[i];
+						break;
+					}
+					cell[i] = range.min[i];
+				}
+
+				if (i == glm::length_t(dimensionality()))
+					return true;
+			}
+		}
+
+		[[nodiscard]]
+		static uint64_t hashCell(const Cell& cell) noexcept {
+			constexpr uint64_t primes[] = { 73856093ull, 19349663ull, 83492791ull, 2654435761ull };
+
+			uint64_t h = 0;
+			for (glm::length_t i = 0; i < glm::length_t(dimensionality()); ++i) {
+				h ^= uint64_t(uint32_t(cell[i])) * primes[i];
+			}
+
+			h *= 0x9E3779B97F4A7C15ull;
+			return h ^ (h >> 32);
+		}
+
+		[[nodiscard]]
+		uint32_t findSlot(const Cell& cell) const noexcept {
+			if (m_slots.empty())
+				return npos;
+
+			auto mask = m_slots.size() - 1;
+			for (auto i = hashCell(cell) & mask;; i = (i + 1) & mask) {
+				const auto& slot = m_slots[i];
+				if (slot.stamp != m_stamp)
+					return npos;
+
+				if (slot.cell == cell)
+					return uint32_t(i);
+			}
+		}
+
+		[[nodiscard]]
+		uint32_t findOrInsertSlot(const Cell& cell) noexcept {
+			auto mask = m_slots.size() - 1;
+			for (auto i = hashCell(cell) & mask;; i = (i + 1) & mask) {
+				auto& slot = m_slots[i];
+				if (slot.stamp != m_stamp) {
+					slot.cell = cell;
+					slot.stamp = m_stamp;
+					slot.count = 0;
+					m_occupied.push_back(uint32_t(i));
+					return uint32_t(i);
+				}
+
+				if (slot.cell == cell)
+					return uint32_t(i);
+			}
+		}
+
+		// load factor is kept <= 0.5, only grows
+		void prepareTable(size_t maxCells) {
+			auto wanted = std::bit_ceil(std::max(size_t(16), maxCells * 2));
+
+			if (wanted > m_slots.size()) {
+				m_slots.assign(wanted, Slot{});
+				m_stamp = 0;
+			}
+
+			++m_stamp;
+			if (m_stamp == 0) [[unlikely]] {
+				// wrapped around, stale stamps could match again
+				std::fill(m_slots.begin(), m_slots.end(), Slot{});
+				m_stamp = 1;
+			}
+
+			m_occupied.clear();
+		}
+
+		// only report a pair in the first cell both ranges share
+		[[nodiscard]]
+		static bool ownsPair(const Cell& cell, const CellRange& a, const CellRange& b) noexcept {
+			return glm::max(a.min, b.min) == cell;
+		}
+
+	public:
+		explicit SpatialHash(Precision cellSize) {
+			setCellSize(cellSize);
+		}
+
+		// takes effect on the next build
+		void setCellSize(Precision cellSize) {
+			if (!(cellSize > Precision(0.0)))
+				throw std::invalid_argument("SpatialHash cell size must be > 0");
+
+			m_cellSize = cellSize;
+			m_invCellSize = Precision(1.0) / cellSize;
+		}
+
+		void build(std::span<const ShapeT> shapes) {
+			if (shapes.size() >= size_t(std::numeric_limits<Index>::max()))
+				throw std::length_error("Too many shapes for SpatialHash");
+
+			m_shapes.assign(shapes.begin(), shapes.end());
+			m_ranges.resize(shapes.size());
+
+			size_t refs = 0;
+			for (size_t i = 0; i < shapes.size(); ++i) {
+				m_ranges[i] = toRange(boundsOf(shapes[i]));
+				refs += rangeCellCount(m_ranges[i]);
+			}
+
+			prepareTable(refs);
+			m_refs.resize(refs);
+			m_indices.resize(refs);
+
+			// count references per cell
+			size_t ref = 0;
+			for (size_t i = 0; i < shapes.size(); ++i) {
+				forEachCell(m_ranges[i], [this, &ref, i](const Cell& cell) {
+					auto slot = findOrInsertSlot(cell);
+					++m_slots[slot].count;
+					m_refs[ref++] = std::pair{ slot, Index(i) };
+				});
+			}
+
+			// prefix sum into compact per cell index arrays
+			Index start = 0;
+			for (auto slotIdx : m_occupied) {
+				auto& slot = m_slots[slotIdx];
+				slot.start = start;
+				start += slot.count;
+				slot.count = 0;
+			}
+
+			for (const auto& [slotIdx, index] : m_refs) {
+				auto& slot = m_slots[slotIdx];
+				m_indices[slot.start + slot.count] = index;
+				++slot.count;
+			}
+		}
+
+		void build(const std::vector<ShapeT>& shapes) {
+			build(std::span<const ShapeT>{ shapes });
+		}
+
+		void clear() noexcept {
+			m_shapes.clear();
+			m_ranges.clear();
+			m_refs.clear();
+			m_indices.clear();
+			m_occupied.clear();
+			++m_stamp;
+		}
+
+		/* Query Methods */
+
+		// indices of the shapes that touch the cell
+		[[nodiscard]]
+		std::span<const Index> getCell(const Cell& cell) const noexcept {
+			auto slot = findSlot(cell);
+			if (slot == npos)
+				return {};
+
+			return std::span<const Index>{ m_indices.data() + m_slots[slot].start, m_slots[slot].count };
+		}
+
+		// calls fn(a, b) with a < b once for every pair of overlapping shapes
+		template <class Fn>
+		void forEachPair(Fn&& fn) const {
+			for (auto slotIdx : m_occupied) {
+				const auto& slot = m_slots[slotIdx];
+				const auto* indices = m_indices.data() + slot.start;
+
+				for (Index a = 0; a < slot.count; ++a) {
+					auto i = indices[a];
+					for (Index b = a + 1; b < slot.count; ++b) {
+						auto j = indices[b];
+
+						if (!ownsPair(slot.cell, m_ranges[i], m_ranges[j]))
+							continue;
+
+						if (hasCollision(m_shapes[i], m_shapes[j])) {
+							fn(i, j);
+						}
+					}
+				}
+			}
+		}
+
+		// out is cleared first, reuse it between frames to avoid allocating
+		void findPairs(std::vector<std::pair<Index, Index>>& out) const {
+			out.clear();
+			forEachPair([&out](Index a, Index b) {
+				out.emplace_back(a, b);
+			});
+		}
+
+		// calls fn(index) once for every shape within radius of center, fn may return false to stop
+		template <class Fn>
+		void queryRadius(const Vec& center, Precision radius, Fn&& fn) const {
+			Circle<Vec> probe{ center, radius };
+			auto range = toRange(boundsOf(probe));
+
+			forEachCell(range, [&](const Cell& cell) {
+				for (auto index : getCell(cell)) {
+					if (!ownsPair(cell, m_ranges[index], range))
+						continue;
+
+					if (hasCollision(probe, m_shapes[index])) {
+						if (!detail::invokeContinue(fn, index))
+							return false;
+					}
+				}
+				return true;
+			});
+		}
+
+		/* Info Methods */
+
+		[[nodiscard]]
+		Precision getCellSize() const noexcept {
+			return m_cellSize;
+		}
+
+		[[nodiscard]]
+		const ShapeT& getShape(Index index) const {
+			return m_shapes.at(index);
+		}
+
+		[[nodiscard]]
+		size_t size() const noexcept {
+			return m_shapes.size();
+		}
+
+		[[nodiscard]]
+		bool empty() const noexcept {
+			return m_shapes.empty();
+		}
+
+		// number of cells with at least one shape
+		[[nodiscard]]
+		size_t cellCount() const noexcept {
+			return m_occupied.size();
+		}
+	};
+
+	template <Vector VectorT = glm::vec2>
+	using CircleHash = SpatialHash<Circle<VectorT>>;
+
+	template <Vector VectorT = glm::vec2>
+	using RectHash = SpatialHash<Rect<VectorT>>;
+}
\ No newline at end of file
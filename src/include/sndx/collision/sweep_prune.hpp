@@ -0,0 +1,315 @@
+#pragma once
+
+#include "./rect.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace sndx::collision {
+
+	// Sort based broadphase that exploits frame coherence.
+	// endpoints are kept sorted on every axis with insertion sort, so mostly static
+	// worlds are close to O(n) per step. only pair changes are reported.
+	template <Vector VectorT = glm::vec3>
+	class SweepAndPrune {
+	public:
+		using Vec = VectorT;
+		using Precision = typename Vec::value_type;
+		using Bounds = Rect<Vec>;
+		using Id = uint32_t;
+		using Pair = std::pair<Id, Id>;
+
+		static constexpr size_t dimensionality() noexcept {
+			return Vec::length();
+		}
+
+	private:
+		static constexpr Id maxFlag = Id(1) << 31;
+
+		struct Endpoint {
+			Precision value;
+			Id tagged; // id with the top bit set for max endpoints
+
+			[[nodiscard]]
+			constexpr Id id() const noexcept {
+				return tagged & ~maxFlag;
+			}
+
+			[[nodiscard]]
+			constexpr bool isMax() const noexcept {
+				return (tagged & maxFlag) != 0;
+			}
+
+			// mins sort before maxes on ties, touching boxes overlap
+			[[nodiscard]]
+			constexpr bool operator<(const Endpoint& other) const noexcept {
+				return value < other.value || (value == other.value && !isMax() && other.isMax());
+			}
+		};
+
+		struct Event {
+			uint64_t key;
+			bool added;
+		};
+
+		std::array<std::vector<Endpoint>, dimensionality()> m_axes{};
+		std::vector<Bounds> m_bounds{};
+		std::vector<bool> m_alive{};
+
+		std::vector<Id> m_free{};
+		std::vector<Id> m_pendingFree{};
+
+		std::unordered_set<uint64_t> m_pairs{};
+
+		std::vector<Event> m_events{};
+		std::vector<Pair> m_added{};
+		std::vector<Pair> m_removed{};
+
+		[[nodiscard]]
+		static constexpr uint64_t pairKey(Id a, Id b) noexcept {
+			if (a > b)
+				std::swap(a, b);
+
+			return (uint64_t(a) << 32) | uint64_t(b);
+		}
+
+		[[nodiscard]]
+		static constexpr Pair fromKey(uint64_t key) noexcept {
+			return Pair{ Id(key >> 32), Id(key & 0xffffffff) };
+		}
+
+		void addPair(Id a, Id b) {
+			auto key = pairKey(a, b);
+			if (m_pairs.insert(key).second) {
+				m_events.push_back(Event{ key, true });
+			}
+		}
+
+		void removePair(Id a, Id b) {
+			auto key = pairKey(a, b);
+			if (m_pairs.erase(key) != 0) {
+				m_events.push_back(Event{ key, false });
+			}
+		}
+
+		void refreshEndpoints(std::vector<Endpoint>& axis, size_t axisIdx) noexcept {
+			for (auto& endpoint : axis) {
+				const auto& bounds = m_bounds[endpoint.id()];
+				endpoint.value = endpoint.isMax() ? bounds.getP2()[typename Vec::length_type(axisIdx)] : bounds.getP1()[typename Vec::length_type(axisIdx)];
+			}
+		}
+
+		// insertion sort, every swap of a min past a max is a potential pair change
+		void sortAxis(std::vector<Endpoint>& axis) {
+			for (size_t i = 1; i < axis.size(); ++i) {
+				auto key = axis[i];
+				size_t j = i;
+
+				while (j > 0 && key < axis[j - 1]) {
+					const auto& other = axis[j - 1];
+
+					if (key.isMax() != other.isMax()) {
+						if (key.isMax()) {
+							// our max moved before their min
+							removePair(key.id(), other.id());
+						}
+						else if (m_bounds[key.id()].overlaps(m_bounds[other.id()])) {
+							// our min moved before their max
+							addPair(key.id(), other.id());
+						}
+					}
+
+					axis[j] = other;
+					--j;
+				}
+
+				axis[j] = key;
+			}
+		}
+
+		// collapses the raw events into net changes since the last step
+		void resolveEvents() {
+			m_added.clear();
+			m_removed.clear();
+
+			std::stable_sort(m_events.begin(), m_events.end(), [](const Event& a, const Event& b) {
+				return a.key < b.key;
+			});
+
+			for (size_t i = 0; i < m_events.size();) {
+				auto key = m_events[i].key;
+
+				// events for a key alternate, so the first one tells us the old state
+				bool wasPresent = !m_events[i].added;
+				bool isPresent = m_pairs.contains(key);
+
+				if (wasPresent != isPresent) {
+					(isPresent ? m_added : m_removed).push_back(fromKey(key));
+				}
+
+				while (i < m_events.size() && m_events[i].key == key) {
+					++i;
+				}
+			}
+
+			m_events.clear();
+		}
+
+		void checkId(Id id) const {
+			if (id >= m_bounds.size() || !m_alive[id])
+				throw std::invalid_argument("Id does not refer to a live SweepAndPrune entry");
+		}
+
+	public:
+		// the new entry's pairs are reported on the next step
+		Id insert(const Bounds& bounds) {
+			Id id{};
+			if (!m_free.empty()) {
+				id = m_free.back();
+				m_free.pop_back();
+				m_bounds[id] = bounds;
+				m_alive[id] = true;
+			}
+			else {
+				if (m_bounds.size() >= size_t(maxFlag)) [[unlikely]]
+					throw std::length_error("SweepAndPrune ran out of ids");
+
+				id = Id(m_bounds.size());
+				m_bounds.push_back(bounds);
+				m_alive.push_back(true);
+			}
+
+			for (size_t axisIdx = 0; axisIdx < dimensionality(); ++axisIdx) {
+				auto i = typename Vec::length_type(axisIdx);
+				m_axes[axisIdx].push_back(Endpoint{ bounds.getP1()[i], id });
+				m_axes[axisIdx].push_back(Endpoint{ bounds.getP2()[i], id | maxFlag });
+			}
+
+			return id;
+		}
+
+		// sorting is deferred until the next step
+		void update(Id id, const Bounds& bounds) {
+			checkId(id);
+			m_bounds[id] = bounds;
+		}
+
+		// the entry's pairs are reported as removed on the next step
+		void remove(Id id) {
+			checkId(id);
+
+			for (auto& axis : m_axes) {
+				std::erase_if(axis, [id](const Endpoint& e) { return e.id() == id; });
+			}
+
+			for (auto it = m_pairs.begin(); it != m_pairs.end();) {
+				auto [a, b] = fromKey(*it);
+				if (a == id || b == id) {
+					m_events.push_back(Event{ *it, false });
+					it = m_pairs.erase(it);
+				}
+				else {
+					++it;
+				}
+			}
+
+			m_alive[id] = false;
+
+			// the id can't be reused until its removal has been reported
+			m_pendingFree.push_back(id);
+		}
+
+		// re-sorts all axes and computes the pairs added and removed since the last step
+		void step() {
+			for (size_t axisIdx = 0; axisIdx < dimensionality(); ++axisIdx) {
+				auto& axis = m_axes[axisIdx];
+				refreshEndpoints(axis, axisIdx);
+				sortAxis(axis);
+			}
+
+			resolveEvents();
+
+			m_free.insert(m_free.end(), m_pendingFree.begin(), m_pendingFree.end());
+			m_pendingFree.clear();
+		}
+
+		void reserve(size_t count) {
+			m_bounds.reserve(count);
+			m_alive.reserve(count);
+			for (auto& axis : m_axes) {
+				axis.reserve(count * 2);
+			}
+		}
+
+		void clear() noexcept {
+			for (auto& axis : m_axes) {
+				axis.clear();
+			}
+			m_bounds.clear();
+			m_alive.clear();
+			m_free.clear();
+			m_pendingFree.clear();
+			m_pairs.clear();
+			m_events.clear();
+			m_added.clear();
+			m_removed.clear();
+		}
+
+		/* Info Methods */
+
+		[[nodiscard]]
+		const Bounds& getBounds(Id id) const {
+			checkId(id);
+			return m_bounds[id];
+		}
+
+		// pairs that started overlapping during the last step
+		[[nodiscard]]
+		const std::vector<Pair>& getAddedPairs() const noexcept {
+			return m_added;
+		}
+
+		// pairs that stopped overlapping (or were removed) during the last step
+		[[nodiscard]]
+		const std::vector<Pair>& getRemovedPairs() const noexcept {
+			return m_removed;
+		}
+
+		[[nodiscard]]
+		bool hasPair(Id a, Id b) const {
+			return m_pairs.contains(pairKey(a, b));
+		}
+
+		[[nodiscard]]
+		size_t pairCount() const noexcept {
+			return m_pairs.size();
+		}
+
+		template <class Fn>
+		void forEachPair(Fn&& fn) const {
+			for (auto key : m_pairs) {
+				auto [a, b] = fromKey(key);
+				fn(a, b);
+			}
+		}
+
+		[[nodiscard]]
+		size_t size() const noexcept {
+			return m_axes[0].size() / 2;
+		}
+
+		[[nodiscard]]
+		bool empty() const noexcept {
+			return size() == 0;
+		}
+	};
+
+	using SweepAndPrune2D = SweepAndPrune<glm::vec2>;
+	using SweepAndPrune3D = SweepAndPrune<glm::vec3>;
+}
\ No newline at end of file
@@ -0,0 +1,469 @@
+#pragma once
+
+#include "./collision.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+// define SNDX_NO_SIMD to force the scalar kernels
+#ifndef SNDX_NO_SIMD
+#if defined(__AVX2__)
+#define SNDX_TRANSFORM_SIMD 2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SNDX_TRANSFORM_SIMD 1
+#include <emmintrin.h>
+#endif
+#endif
+
+#ifndef SNDX_TRANSFORM_SIMD
+#define SNDX_TRANSFORM_SIMD 0
+#endif
+
+namespace sndx::collision {
+
+	namespace detail {
+		// the handful of operations the transform kernels need, one per register width
+		template <size_t width>
+		struct LaneOps;
+
+		template <>
+		struct LaneOps<1> {
+			using V = float;
+
+			static float load(const float* p) noexcept { return *p; }
+			static void store(float* p, float v) noexcept { *p = v; }
+			static float set(float v) noexcept { return v; }
+			static float add(float a, float b) noexcept { return a + b; }
+			static float sub(float a, float b) noexcept { return a - b; }
+			static float mul(float a, float b) noexcept { return a * b; }
+			static float abs(float v) noexcept { return std::abs(v); }
+		};
+
+#if SNDX_TRANSFORM_SIMD >= 1
+		template <>
+		struct LaneOps<4> {
+			using V = __m128;
+
+			static __m128 load(const float* p) noexcept { return _mm_loadu_ps(p); }
+			static void store(float* p, __m128 v) noexcept { _mm_storeu_ps(p, v); }
+			static __m128 set(float v) noexcept { return _mm_set1_ps(v); }
+			static __m128 add(__m128 a, __m128 b) noexcept { return _mm_add_ps(a, b); }
+			static __m128 sub(__m128 a, __m128 b) noexcept { return _mm_sub_ps(a, b); }
+			static __m128 mul(__m128 a, __m128 b) noexcept { return _mm_mul_ps(a, b); }
+			static __m128 abs(__m128 v) noexcept { return _mm_andnot_ps(_mm_set1_ps(-0.0f), v); }
+		};
+#endif
+
+#if SNDX_TRANSFORM_SIMD == 2
+		template <>
+		struct LaneOps<8> {
+			using V = __m256;
+
+			static __m256 load(const float* p) noexcept { return _mm256_loadu_ps(p); }
+			static void store(float* p, __m256 v) noexcept { _mm256_storeu_ps(p, v); }
+			static __m256 set(float v) noexcept { return _mm256_set1_ps(v); }
+			static __m256 add(__m256 a, __m256 b) noexcept { return _mm256_add_ps(a, b); }
+			static __m256 sub(__m256 a, __m256 b) noexcept { return _mm256_sub_ps(a, b); }
+			static __m256 mul(__m256 a, __m256 b) noexcept { return _mm256_mul_ps(a, b); }
+			static __m256 abs(__m256 v) noexcept { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), v); }
+		};
+#endif
+
+#if SNDX_TRANSFORM_SIMD == 2
+		inline constexpr size_t wideLanes = 8;
+#elif SNDX_TRANSFORM_SIMD == 1
+		inline constexpr size_t wideLanes = 4;
+#else
+		inline constexpr size_t wideLanes = 1;
+#endif
+
+		// one lane group of points, x y z
+		struct LanePoints {
+			std::array<float, 8> x{}, y{}, z{};
+		};
+
+		// Structure of arrays storage for many Transforms, applied to many shapes at once.
+		// element i of every shape span is transformed by transform i,
+		// the world bounds come out of the same pass so a broadphase update needs no second sweep.
+		template <bool uniformScale = true>
+		class TransformBatch {
+		public:
+			using TransformT = detail::Transform<uniformScale>;
+
+			static constexpr size_t laneWidth = 8;
+
+		private:
+			// padded to a multiple of laneWidth with identity transforms
+			std::vector<float> m_px{}, m_py{}, m_pz{};
+			std::vector<float> m_qx{}, m_qy{}, m_qz{}, m_qw{};
+			std::vector<float> m_sx{}, m_sy{}, m_sz{}; // only m_sx when uniformScale
+			size_t m_size = 0;
+
+			[[nodiscard]]
+			static constexpr size_t padded(size_t count) noexcept {
+				return (count + laneWidth - 1) / laneWidth * laneWidth;
+			}
+
+			[[nodiscard]]
+			auto arrays() noexcept {
+				return std::array{ &m_px, &m_py, &m_pz, &m_qx, &m_qy, &m_qz, &m_qw, &m_sx, &m_sy, &m_sz };
+			}
+
+			void resizeStorage(size_t count) {
+				for (auto* arr : { &m_px, &m_py, &m_pz, &m_qx, &m_qy, &m_qz }) {
+					arr->resize(count, 0.0f);
+				}
+				m_qw.resize(count, 1.0f);
+				m_sx.resize(count, 1.0f);
+				if constexpr (!uniformScale) {
+					m_sy.resize(count, 1.0f);
+					m_sz.resize(count, 1.0f);
+				}
+			}
+
+			void checkSize(size_t count) const {
+				if (count != m_size)
+					throw std::invalid_argument("TransformBatch needs exactly one shape per transform");
+			}
+
+			// world = pos + rot * (local * scale) for Ops::width transforms starting at first.
+			// rotation is v + 2w(q x v) + 2q x (q x v), the same as glm's quaternion product
+			template <class Ops, class V = typename Ops::V>
+			void pointKernel(size_t first, const float* lx, const float* ly, const float* lz, float* wx, float* wy, float* wz) const noexcept {
+				auto sx = Ops::load(m_sx.data() + first);
+				V sy = sx, sz = sx;
+				if constexpr (!uniformScale) {
+					sy = Ops::load(m_sy.data() + first);
+					sz = Ops::load(m_sz.data() + first);
+				}
+
+				auto vx = Ops::mul(Ops::load(lx), sx);
+				auto vy = Ops::mul(Ops::load(ly), sy);
+				auto vz = Ops::mul(Ops::load(lz), sz);
+
+				auto qx = Ops::load(m_qx.data() + first);
+				auto qy = Ops::load(m_qy.data() + first);
+				auto qz = Ops::load(m_qz.data() + first);
+				auto qw = Ops::load(m_qw.data() + first);
+
+				auto cross = [](V ax, V ay, V az, V bx, V by, V bz, V& ox, V& oy, V& oz) {
+					ox = Ops::sub(Ops::mul(ay, bz), Ops::mul(az, by));
+					oy = Ops::sub(Ops::mul(az, bx), Ops::mul(ax, bz));
+					oz = Ops::sub(Ops::mul(ax, by), Ops::mul(ay, bx));
+				};
+
+				V ux, uy, uz, uux, uuy, uuz;
+				cross(qx, qy, qz, vx, vy, vz, ux, uy, uz);
+				cross(qx, qy, qz, ux, uy, uz, uux, uuy, uuz);
+
+				auto two = Ops::set(2.0f);
+				auto finish = [&](V v, V u, V uu, const float* p, float* out) {
+					auto r = Ops::add(v, Ops::mul(Ops::add(Ops::mul(u, qw), uu), two));
+					Ops::store(out, Ops::add(r, Ops::load(p + first)));
+				};
+
+				finish(vx, ux, uux, m_px.data(), wx);
+				finish(vy, uy, uuy, m_py.data(), wy);
+				finish(vz, uz, uuz, m_pz.data(), wz);
+			}
+
+			// the world half extents of the axis aligned bounds of a local box with half extents h.
+			// row i of the rotation matrix in absolute value, dotted with the scaled extents
+			template <class Ops, class V = typename Ops::V>
+			void extentKernel(size_t first, const float* hx, const float* hy, const float* hz, float* ex, float* ey, float* ez) const noexcept {
+				auto sx = Ops::load(m_sx.data() + first);
+				V sy = sx, sz = sx;
+				if constexpr (!uniformScale) {
+					sy = Ops::load(m_sy.data() + first);
+					sz = Ops::load(m_sz.data() + first);
+				}
+
+				auto x = Ops::abs(Ops::mul(Ops::load(hx), sx));
+				auto y = Ops::abs(Ops::mul(Ops::load(hy), sy));
+				auto z = Ops::abs(Ops::mul(Ops::load(hz), sz));
+
+				auto qx = Ops::load(m_qx.data() + first);
+				auto qy = Ops::load(m_qy.data() + first);
+				auto qz = Ops::load(m_qz.data() + first);
+				auto qw = Ops::load(m_qw.data() + first);
+
+				auto one = Ops::set(1.0f);
+				auto two = Ops::set(2.0f);
+
+				auto xx = Ops::mul(qx, qx), yy = Ops::mul(qy, qy), zz = Ops::mul(qz, qz);
+				auto xy = Ops::mul(qx, qy), xz = Ops::mul(qx, qz), yz = Ops::mul(qy, qz);
+				auto wx = Ops::mul(qw, qx), wy = Ops::mul(qw, qy), wz = Ops::mul(qw, qz);
+
+				auto diag = [&](V a, V b) { return Ops::abs(Ops::sub(one, Ops::mul(two, Ops::add(a, b)))); };
+				auto offPlus = [&](V a, V b) { return Ops::abs(Ops::mul(two, Ops::add(a, b))); };
+				auto offMinus = [&](V a, V b) { return Ops::abs(Ops::mul(two, Ops::sub(a, b))); };
+
+				auto row = [&](V r0, V r1, V r2, float* out) {
+					Ops::store(out, Ops::add(Ops::add(Ops::mul(r0, x), Ops::mul(r1, y)), Ops::mul(r2, z)));
+				};
+
+				row(diag(yy, zz), offMinus(xy, wz), offPlus(xz, wy), ex);
+				row(offPlus(xy, wz), diag(xx, zz), offMinus(yz, wx), ey);
+				row(offMinus(xz, wy), offPlus(yz, wx), diag(xx, yy), ez);
+			}
+
+			// runs kernel over the laneWidth transforms starting at first, whatever width the target has
+			template <class Fn>
+			static void forLanes(Fn&& kernel) {
+				for (size_t k = 0; k < laneWidth; k += wideLanes) {
+					kernel(LaneOps<wideLanes>{}, k);
+				}
+			}
+
+			void transformPoints(size_t first, const LanePoints& local, LanePoints& world) const noexcept {
+				forLanes([&]<class Ops>(Ops, size_t k) {
+					pointKernel<Ops>(first + k, local.x.data() + k, local.y.data() + k, local.z.data() + k,
+						world.x.data() + k, world.y.data() + k, world.z.data() + k);
+				});
+			}
+
+			void transformExtents(size_t first, const LanePoints& local, LanePoints& world) const noexcept {
+				forLanes([&]<class Ops>(Ops, size_t k) {
+					extentKernel<Ops>(first + k, local.x.data() + k, local.y.data() + k, local.z.data() + k,
+						world.x.data() + k, world.y.data() + k, world.z.data() + k);
+				});
+			}
+
+			[[nodiscard]]
+			static glm::vec3 lane(const LanePoints& points, size_t k) noexcept {
+				return glm::vec3{ points.x[k], points.y[k], points.z[k] };
+			}
+
+			static void setLane(LanePoints& points, size_t k, const glm::vec3& v) noexcept {
+				points.x[k] = v.x;
+				points.y[k] = v.y;
+				points.z[k] = v.z;
+			}
+
+			// calls fn(first, count) for every group of laneWidth shapes, count is less than laneWidth only at the end
+			template <class Fn>
+			void forGroups(Fn&& fn) const {
+				for (size_t first = 0; first < m_size; first += laneWidth) {
+					fn(first, std::min(laneWidth, m_size - first));
+				}
+			}
+
+		public:
+			TransformBatch() = default;
+
+			explicit TransformBatch(std::span<const TransformT> transforms) {
+				reserve(transforms.size());
+				for (const auto& tform : transforms) {
+					push_back(tform);
+				}
+			}
+
+			void reserve(size_t count) {
+				auto n = padded(count);
+				for (auto* arr : arrays()) {
+					arr->reserve(n);
+				}
+			}
+
+			size_t push_back(const TransformT& tform) {
+				auto idx = m_size;
+				++m_size;
+				resizeStorage(padded(m_size));
+				set(idx, tform);
+				return idx;
+			}
+
+			void set(size_t idx, const TransformT& tform) {
+				if (idx >= m_size)
+					throw std::out_of_range("TransformBatch index out of range");
+
+				m_px[idx] = tform.pos.x; m_py[idx] = tform.pos.y; m_pz[idx] = tform.pos.z;
+				m_qx[idx] = tform.rot.x; m_qy[idx] = tform.rot.y; m_qz[idx] = tform.rot.z; m_qw[idx] = tform.rot.w;
+
+				if constexpr (uniformScale) {
+					m_sx[idx] = tform.scale;
+				}
+				else {
+					m_sx[idx] = tform.scale.x; m_sy[idx] = tform.scale.y; m_sz[idx] = tform.scale.z;
+				}
+			}
+
+			[[nodiscard]]
+			TransformT get(size_t idx) const {
+				if (idx >= m_size)
+					throw std::out_of_range("TransformBatch index out of range");
+
+				glm::vec3 pos{ m_px[idx], m_py[idx], m_pz[idx] };
+				glm::quat rot{ m_qw[idx], m_qx[idx], m_qy[idx], m_qz[idx] };
+
+				if constexpr (uniformScale) {
+					return TransformT{ pos, rot, m_sx[idx] };
+				}
+				else {
+					return TransformT{ pos, rot, glm::vec3{ m_sx[idx], m_sy[idx], m_sz[idx] } };
+				}
+			}
+
+			void clear() noexcept {
+				for (auto* arr : arrays()) {
+					arr->clear();
+				}
+				m_size = 0;
+			}
+
+			/* Info Methods */
+
+			[[nodiscard]]
+			size_t size() const noexcept {
+				return m_size;
+			}
+
+			[[nodiscard]]
+			bool empty() const noexcept {
+				return m_size == 0;
+			}
+
+			/* Batch Methods */
+
+			// same results as transform(local[i], get(i)) up to rounding
+			void transform(std::span<const Circle3D> local, std::vector<Circle3D>& world, std::vector<Rect3D>& bounds) const
+				requires uniformScale {
+
+				checkSize(local.size());
+				world.assign(local.begin(), local.end());
+				bounds.clear();
+				bounds.reserve(m_size);
+
+				forGroups([&](size_t first, size_t count) {
+					LanePoints in{}, out{};
+					for (size_t k = 0; k < count; ++k) {
+						setLane(in, k, local[first + k].getCenter());
+					}
+
+					transformPoints(first, in, out);
+
+					for (size_t k = 0; k < count; ++k) {
+						auto& circle = world[first + k];
+						circle.setPosition(lane(out, k));
+						circle.setRadius(circle.getRadius() * m_sx[first + k]);
+
+						auto r = glm::vec3{ circle.getRadius() };
+						bounds.emplace_back(circle.getCenter() - r, circle.getCenter() + r);
+					}
+				});
+			}
+
+			void transform(std::span<const Capsule3D> local, std::vector<Capsule3D>& world, std::vector<Rect3D>& bounds) const
+				requires uniformScale {
+
+				checkSize(local.size());
+				world.assign(local.begin(), local.end());
+				bounds.clear();
+				bounds.reserve(m_size);
+
+				forGroups([&](size_t first, size_t count) {
+					LanePoints inA{}, inB{}, outA{}, outB{};
+					for (size_t k = 0; k < count; ++k) {
+						setLane(inA, k, local[first + k].getPointA());
+						setLane(inB, k, local[first + k].getPointB());
+					}
+
+					transformPoints(first, inA, outA);
+					transformPoints(first, inB, outB);
+
+					for (size_t k = 0; k < count; ++k) {
+						auto& capsule = world[first + k];
+						auto a = lane(outA, k);
+						auto b = lane(outB, k);
+						capsule.setPointA(a);
+						capsule.setPointB(b);
+						capsule.setRadius(capsule.getRadius() * m_sx[first + k]);
+
+						auto r = glm::vec3{ capsule.getRadius() };
+						bounds.emplace_back(glm::min(a, b) - r, glm::max(a, b) + r);
+					}
+				});
+			}
+
+			// the rotation of world[i] is the rotation of transform i
+			void transform(std::span<const Rect3D> local, std::vector<OriRect3D>& world, std::vector<Rect3D>& bounds) const {
+				checkSize(local.size());
+				world.clear();
+				world.reserve(m_size);
+				bounds.clear();
+				bounds.reserve(m_size);
+
+				forGroups([&](size_t first, size_t count) {
+					LanePoints center{}, half{}, worldCenter{}, extent{};
+					for (size_t k = 0; k < count; ++k) {
+						setLane(center, k, local[first + k].getCenter());
+						setLane(half, k, local[first + k].getSize() * 0.5f);
+					}
+
+					transformPoints(first, center, worldCenter);
+					transformExtents(first, half, extent);
+
+					for (size_t k = 0; k < count; ++k) {
+						auto i = first + k;
+						auto c = lane(worldCenter, k);
+						auto h = lane(half, k);
+
+						if constexpr (uniformScale) {
+							h *= m_sx[i];
+						}
+						else {
+							h *= glm::abs(glm::vec3{ m_sx[i], m_sy[i], m_sz[i] });
+						}
+
+						world.emplace_back(c, h, glm::quat{ m_qw[i], m_qx[i], m_qy[i], m_qz[i] });
+
+						auto e = lane(extent, k);
+						bounds.emplace_back(c - e, c + e);
+					}
+				});
+			}
+
+			void transform(std::span<const Tri3D> local, std::vector<Tri3D>& world, std::vector<Rect3D>& bounds) const {
+				checkSize(local.size());
+				world.clear();
+				world.reserve(m_size);
+				bounds.clear();
+				bounds.reserve(m_size);
+
+				forGroups([&](size_t first, size_t count) {
+					std::array<LanePoints, 3> in{}, out{};
+					for (size_t k = 0; k < count; ++k) {
+						const auto& tri = local[first + k];
+						setLane(in[0], k, tri.getP1());
+						setLane(in[1], k, tri.getP2());
+						setLane(in[2], k, tri.getP3());
+					}
+
+					for (size_t p = 0; p < 3; ++p) {
+						transformPoints(first, in[p], out[p]);
+					}
+
+					for (size_t k = 0; k < count; ++k) {
+						auto a = lane(out[0], k);
+						auto b = lane(out[1], k);
+						auto c = lane(out[2], k);
+
+						world.emplace_back(a, b, c);
+						bounds.emplace_back(glm::min(glm::min(a, b), c), glm::max(glm::max(a, b), c));
+					}
+				});
+			}
+		};
+	}
+
+	// uniform scale only, the only kind circles and capsules survive
+	using TransformIsotropicBatch = detail::TransformBatch<true>;
+
+	// non-uniform scale, boxes and triangles only
+	using TransformBatch = detail::TransformBatch<false>;
+}
\ No newline at end of file
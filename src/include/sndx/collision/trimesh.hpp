@@ -0,0 +1,485 @@
+#pragma once
+
+#include "./aabbtree.hpp"
+#include "./collision.hpp"
+#include "./triangle.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace sndx::collision {
+
+	// A static triangle soup collider for level geometry.
+	// triangles are sorted into a BVH built with the binned surface area heuristic,
+	// nodes are stored depth first in one array so the left child always follows its parent.
+	class TriangleMesh {
+	public:
+		using Vec = glm::vec3;
+		using Precision = float;
+		using TriIndex = uint32_t;
+
+		static constexpr TriIndex npos = std::numeric_limits<TriIndex>::max();
+
+		static constexpr size_t maxLeafSize = 4;
+		static constexpr size_t binCount = 16;
+
+		struct Node {
+			Vec min{};
+			uint32_t offset = 0; // first triangle for leaves, right child otherwise
+			Vec max{};
+			uint16_t count = 0; // 0 for interior nodes
+			uint16_t axis = 0;
+
+			[[nodiscard]]
+			constexpr bool isLeaf() const noexcept {
+				return count != 0;
+			}
+		};
+
+		struct RaycastResult : Tri3D::RaycastResult {
+			// index of the triangle in the vector the mesh was built from
+			TriIndex index = npos;
+		};
+		using result_type = RaycastResult;
+
+	private:
+		std::vector<Node> m_nodes{};
+
+		// stored in leaf order, m_ids maps back to the original index
+		std::vector<Tri3D> m_tris{};
+		std::vector<TriIndex> m_ids{};
+		std::vector<TriIndex> m_positions{};
+
+		struct BuildTask {
+			size_t begin, end;
+			uint32_t parent; // npos for the root and left children
+		};
+
+		[[nodiscard]]
+		static Precision halfArea(const Vec& min, const Vec& max) noexcept {
+			auto d = max - min;
+			return d.x * d.y + d.y * d.z + d.z * d.x;
+		}
+
+		[[nodiscard]]
+		static bool slab(const Node& node, const Vec& from, const Vec& inv, Precision maxDist) noexcept {
+			auto t1 = (node.min - from) * inv;
+			auto t2 = (node.max - from) * inv;
+
+			auto tmin = glm::compMax(glm::min(t1, t2));
+			auto tmax = glm::compMin(glm::max(t1, t2));
+
+			return tmax >= std::max(tmin, Precision(0.0)) && tmin <= maxDist;
+		}
+
+		[[nodiscard]]
+		static bool overlaps(const Node& node, const Vec& min, const Vec& max) noexcept {
+			return node.min.x <= max.x && node.max.x >= min.x &&
+				node.min.y <= max.y && node.max.y >= min.y &&
+				node.min.z <= max.z && node.max.z >= min.z;
+		}
+
+		void build(const std::vector<Rect3D>& bounds, const std::vector<Vec>& centers) {
+			std::vector<TriIndex> order(bounds.size());
+			for (TriIndex i = 0; i < order.size(); ++i) {
+				order[i] = i;
+			}
+
+			m_nodes.reserve(bounds.size() * 2 / maxLeafSize + 1);
+
+			std::vector<BuildTask> tasks{};
+			tasks.push_back(BuildTask{ 0, order.size(), npos });
+
+			while (!tasks.empty()) {
+				auto task = tasks.back();
+				tasks.pop_back();
+
+				auto idx = uint32_t(m_nodes.size());
+				m_nodes.emplace_back();
+				if (task.parent != npos) {
+					m_nodes[task.parent].offset = idx;
+				}
+
+				Vec min{ std::numeric_limits<Precision>::max() }, max{ std::numeric_limits<Precision>::lowest() };
+				Vec cmin = min, cmax = max;
+				for (auto i = task.begin; i < task.end; ++i) {
+					min = glm::min(min, bounds[order[i]].getP1());
+					max = glm::max(max, bounds[order[i]].getP2());
+					cmin = glm::min(cmin, centers[order[i]]);
+					cmax = glm::max(cmax, centers[order[i]]);
+				}
+
+				m_nodes[idx].min = min;
+				m_nodes[idx].max = max;
+
+				auto count = task.end - task.begin;
+				auto mid = task.begin + count / 2;
+				uint16_t axis = 0;
+
+				if (count > 1) {
+					// cost of a split relative to intersecting every triangle in this node
+					Precision bestCost = std::numeric_limits<Precision>::max();
+					size_t bestSplit = 0;
+
+					for (uint16_t a = 0; a < 3; ++a) {
+						auto extent = cmax[a] - cmin[a];
+						if (!(extent > Precision(0.0)))
+							continue;
+
+						struct Bin {
+							Vec min{ std::numeric_limits<Precision>::max() }, max{ std::numeric_limits<Precision>::lowest() };
+							size_t count = 0;
+						};
+						std::array<Bin, binCount> bins{};
+
+						auto scale = Precision(binCount) / extent;
+						for (auto i = task.begin; i < task.end; ++i) {
+							auto b = std::min(size_t((centers[order[i]][a] - cmin[a]) * scale), binCount - 1);
+							bins[b].min = glm::min(bins[b].min, bounds[order[i]].getP1());
+							bins[b].max = glm::max(bins[b].max, bounds[order[i]].getP2());
+							++bins[b].count;
+						}
+
+						std::array<Precision, binCount - 1> rightCost{};
+						Bin acc{};
+						for (size_t b = binCount - 1; b > 0; --b) {
+							acc.min = glm::min(acc.min, bins[b].min);
+							acc.max = glm::max(acc.max, bins[b].max);
+							acc.count += bins[b].count;
+							rightCost[b - 1] = acc.count == 0 ? Precision(0.0) : halfArea(acc.min, acc.max) * Precision(acc.count);
+						}
+
+						acc = Bin{};
+						for (size_t b = 0; b < binCount - 1; ++b) {
+							acc.min = glm::min(acc.min, bins[b].min);
+							acc.max = glm::max(acc.max, bins[b].max);
+							acc.count += bins[b].count;
+
+							if (acc.count == 0 || acc.count == count)
+								continue;
+
+							auto cost = halfArea(acc.min, acc.max) * Precision(acc.count) + rightCost[b];
+							if (cost < bestCost) {
+								bestCost = cost;
+								bestSplit = b;
+								axis = a;
+							}
+						}
+					}
+
+					auto leafCost = halfArea(min, max) * Precision(count);
+					bool split = count > maxLeafSize || bestCost < leafCost;
+
+					if (split) {
+						if (bestCost < std::numeric_limits<Precision>::max()) {
+							auto scale = Precision(binCount) / (cmax[axis] - cmin[axis]);
+							auto it = std::partition(order.begin() + task.begin, order.begin() + task.end, [&](TriIndex i) {
+								return std::min(size_t((centers[i][axis] - cmin[axis]) * scale), binCount - 1) <= bestSplit;
+							});
+							mid = size_t(it - order.begin());
+						}
+						// otherwise every centroid is the same, split down the middle
+
+						m_nodes[idx].axis = axis;
+
+						// the left child is built next so it lands right after its parent
+						tasks.push_back(BuildTask{ mid, task.end, idx });
+						tasks.push_back(BuildTask{ task.begin, mid, npos });
+						continue;
+					}
+				}
+
+				m_nodes[idx].offset = uint32_t(task.begin);
+				m_nodes[idx].count = uint16_t(count);
+			}
+
+			m_ids = std::move(order);
+		}
+
+		// fills out and returns true if any triangle in the leaf is closer than out.dist
+		bool intersectLeaf(const Node& node, const Vec& from, const Vec& dir, bool cull, RaycastResult& out) const noexcept {
+			bool found = false;
+			for (auto i = node.offset; i < node.offset + node.count; ++i) {
+				auto res = m_tris[i].raycast(from, dir, cull);
+				if (res.hit() && res.dist < out.dist) {
+					static_cast<Tri3D::RaycastResult&>(out) = res;
+					out.index = m_ids[i];
+					found = true;
+				}
+			}
+			return found;
+		}
+
+		[[nodiscard]]
+		std::pair<uint32_t, uint32_t> orderedChildren(uint32_t idx, bool negative) const noexcept {
+			auto left = idx + 1;
+			auto right = m_nodes[idx].offset;
+			return negative ? std::pair{ right, left } : std::pair{ left, right };
+		}
+
+	public:
+		TriangleMesh() = default;
+
+		explicit TriangleMesh(std::span<const Tri3D> tris) {
+			if (tris.size() >= size_t(npos))
+				throw std::length_error("Too many triangles for TriangleMesh");
+
+			if (tris.empty())
+				return;
+
+			std::vector<Rect3D> bounds{};
+			std::vector<Vec> centers{};
+			bounds.reserve(tris.size());
+			centers.reserve(tris.size());
+
+			for (const auto& tri : tris) {
+				bounds.push_back(tri.getBounds());
+				centers.push_back(bounds.back().getCenter());
+			}
+
+			build(bounds, centers);
+
+			m_tris.reserve(tris.size());
+			m_positions.resize(tris.size());
+			for (TriIndex i = 0; i < m_ids.size(); ++i) {
+				m_tris.push_back(tris[m_ids[i]]);
+				m_positions[m_ids[i]] = i;
+			}
+		}
+
+		explicit TriangleMesh(const std::vector<Tri3D>& tris) :
+			TriangleMesh(std::span<const Tri3D>{ tris }) {}
+
+		/* Raycasting */
+
+		// closest hit no further than maxDist
+		[[nodiscard]]
+		RaycastResult raycast(const Vec& from, const Vec& dir, bool cull = false, Precision maxDist = std::numeric_limits<Precision>::max()) const {
+			RaycastResult out{};
+			out.dist = maxDist;
+
+			if (m_nodes.empty())
+				return out;
+
+			auto inv = Precision(1.0) / dir;
+
+			detail::TraversalStack<uint32_t> stack{};
+			stack.push(0);
+
+			while (!stack.empty()) {
+				auto idx = stack.pop();
+				const auto& node = m_nodes[idx];
+
+				if (!slab(node, from, inv, out.dist))
+					continue;
+
+				if (node.isLeaf()) {
+					intersectLeaf(node, from, dir, cull, out);
+				}
+				else {
+					// push the far child first so the near one is visited first
+					auto [nearChild, farChild] = orderedChildren(idx, dir[node.axis] < Precision(0.0));
+					stack.push(farChild);
+					stack.push(nearChild);
+				}
+			}
+
+			if (!out.hit())
+				out.dist = std::numeric_limits<float>::max();
+
+			return out;
+		}
+
+		// true if anything is hit closer than maxDist, stops at the first hit
+		[[nodiscard]]
+		bool raycastAny(const Vec& from, const Vec& dir, bool cull = false, Precision maxDist = std::numeric_limits<Precision>::max()) const {
+			if (m_nodes.empty())
+				return false;
+
+			auto inv = Precision(1.0) / dir;
+
+			detail::TraversalStack<uint32_t> stack{};
+			stack.push(0);
+
+			while (!stack.empty()) {
+				auto idx = stack.pop();
+				const auto& node = m_nodes[idx];
+
+				if (!slab(node, from, inv, maxDist))
+					continue;
+
+				if (node.isLeaf()) {
+					for (auto i = node.offset; i < node.offset + node.count; ++i) {
+						auto res = m_tris[i].raycast(from, dir, cull);
+						if (res.hit() && res.dist < maxDist)
+							return true;
+					}
+				}
+				else {
+					stack.push(m_nodes[idx].offset);
+					stack.push(idx + 1);
+				}
+			}
+
+			return false;
+		}
+
+		// closest hits for a packet of rays that traverse the tree together.
+		// works best when the rays are coherent, eg. 4 or 8 neighboring pixels
+		template <size_t n> requires (n > 0 && n <= 32) [[nodiscard]]
+		std::array<RaycastResult, n> raycastPacket(const std::array<Vec, n>& from, const std::array<Vec, n>& dir, bool cull = false) const {
+			std::array<RaycastResult, n> out{};
+			if (m_nodes.empty())
+				return out;
+
+			// structure of arrays so the per node slab test vectorizes
+			std::array<Precision, n> ox, oy, oz, ix, iy, iz, best;
+			for (size_t r = 0; r < n; ++r) {
+				ox[r] = from[r].x; oy[r] = from[r].y; oz[r] = from[r].z;
+				ix[r] = Precision(1.0) / dir[r].x; iy[r] = Precision(1.0) / dir[r].y; iz[r] = Precision(1.0) / dir[r].z;
+				best[r] = std::numeric_limits<Precision>::max();
+			}
+
+			// the traversal order follows the first ray
+			const auto& leadDir = dir[0];
+
+			detail::TraversalStack<uint32_t> stack{};
+			stack.push(0);
+
+			while (!stack.empty()) {
+				auto idx = stack.pop();
+				const auto& node = m_nodes[idx];
+
+				uint32_t active = 0;
+				for (size_t r = 0; r < n; ++r) {
+					auto x1 = (node.min.x - ox[r]) * ix[r], x2 = (node.max.x - ox[r]) * ix[r];
+					auto y1 = (node.min.y - oy[r]) * iy[r], y2 = (node.max.y - oy[r]) * iy[r];
+					auto z1 = (node.min.z - oz[r]) * iz[r], z2 = (node.max.z - oz[r]) * iz[r];
+
+					auto tmin = std::max(std::max(std::min(x1, x2), std::min(y1, y2)), std::min(z1, z2));
+					auto tmax = std::min(std::min(std::max(x1, x2), std::max(y1, y2)), std::max(z1, z2));
+
+					active |= uint32_t(tmax >= std::max(tmin, Precision(0.0)) && tmin <= best[r]) << r;
+				}
+
+				if (active == 0)
+					continue;
+
+				if (node.isLeaf()) {
+					for (auto bits = active; bits != 0; bits &= bits - 1) {
+						auto r = size_t(std::countr_zero(bits));
+						if (intersectLeaf(node, from[r], dir[r], cull, out[r])) {
+							best[r] = out[r].dist;
+						}
+					}
+				}
+				else {
+					auto [nearChild, farChild] = orderedChildren(idx, leadDir[node.axis] < Precision(0.0));
+					stack.push(farChild);
+					stack.push(nearChild);
+				}
+			}
+
+			return out;
+		}
+
+		/* Mid Phase */
+
+		// calls fn(TriIndex, const Tri3D&) for every triangle whose bounds overlap, fn may return false to stop
+		template <class Fn>
+		void query(const Rect3D& bounds, Fn&& fn) const {
+			if (m_nodes.empty())
+				return;
+
+			const auto& min = bounds.getP1();
+			const auto& max = bounds.getP2();
+
+			detail::TraversalStack<uint32_t> stack{};
+			stack.push(0);
+
+			while (!stack.empty()) {
+				auto idx = stack.pop();
+				const auto& node = m_nodes[idx];
+
+				if (!overlaps(node, min, max))
+					continue;
+
+				if (node.isLeaf()) {
+					for (auto i = node.offset; i < node.offset + node.count; ++i) {
+						if (!m_tris[i].getBounds().overlaps(bounds))
+							continue;
+
+						if (!detail::invokeContinue(fn, m_ids[i], m_tris[i]))
+							return;
+					}
+				}
+				else {
+					stack.push(node.offset);
+					stack.push(idx + 1);
+				}
+			}
+		}
+
+		// narrowphase only runs on triangles whose bounds overlap the shape's.
+		// calls fn(TriIndex, const Collision3D&) for every colliding triangle, fn may return false to stop
+		template <class ShapeT, class Fn>
+			requires requires (const ShapeT& s, const Tri3D& t) { sndx::collision::getBounds(s); getCollision(s, t); }
+		void collide(const ShapeT& shape, Fn&& fn) const {
+			query(sndx::collision::getBounds(shape), [&](TriIndex index, const Tri3D& tri) {
+				if (auto res = getCollision(shape, tri)) {
+					return detail::invokeContinue(fn, index, *res);
+				}
+				return true;
+			});
+		}
+
+		template <class ShapeT>
+			requires requires (const ShapeT& s, const Tri3D& t) { sndx::collision::getBounds(s); getCollision(s, t); }
+		[[nodiscard]]
+		std::vector<std::pair<TriIndex, Collision3D>> getCollisions(const ShapeT& shape) const {
+			std::vector<std::pair<TriIndex, Collision3D>> out{};
+			collide(shape, [&out](TriIndex index, const Collision3D& res) {
+				out.emplace_back(index, res);
+			});
+			return out;
+		}
+
+		/* Info Methods */
+
+		// by the index in the original vector
+		[[nodiscard]]
+		const Tri3D& getTri(TriIndex index) const {
+			return m_tris[m_positions.at(index)];
+		}
+
+		[[nodiscard]]
+		Rect3D getBounds() const {
+			if (m_nodes.empty())
+				return Rect3D{ Vec{ 0.0f }, Vec{ 0.0f } };
+
+			return Rect3D{ m_nodes[0].min, m_nodes[0].max };
+		}
+
+		[[nodiscard]]
+		const std::vector<Node>& getNodes() const noexcept {
+			return m_nodes;
+		}
+
+		[[nodiscard]]
+		size_t size() const noexcept {
+			return m_tris.size();
+		}
+
+		[[nodiscard]]
+		bool empty() const noexcept {
+			return m_tris.empty();
+		}
+	};
+}
\ No newline at end of file
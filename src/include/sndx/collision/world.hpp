@@ -0,0 +1,821 @@
+#pragma once
+
+#include "./aabbtree.hpp"
+#include "./collision.hpp"
+#include "./manifold.hpp"
+#include "./narrowphase.hpp"
+
+#include "../math/integration.hpp"
+#include "../math/physics.hpp"
+
+#include <glm/gtc/quaternion.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <execution>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace sndx::collision {
+
+	// Rigid bodies stored as parallel arrays, each step runs
+	// integrate forces -> broadphase -> narrowphase -> islands -> sequential impulses -> integrate velocities.
+	// bodies connected through contacts form an island, islands are solved independently in parallel
+	// and fall asleep together once every body in them has been resting for settings.sleepTime.
+	class RigidWorld {
+	public:
+		using BodyId = uint32_t;
+
+		// shapes are in body space, the body origin is its center of mass
+		using BodyShape = std::variant<Circle3D, Capsule3D, OriRect3D>;
+
+		static constexpr BodyId null = std::numeric_limits<BodyId>::max();
+
+		struct BodyDesc {
+			BodyShape shape = Circle3D{ glm::vec3{ 0.0f }, 0.5f };
+			glm::vec3 position{ 0.0f };
+			glm::quat rotation{ 1.0f, 0.0f, 0.0f, 0.0f };
+			glm::vec3 linearVelocity{ 0.0f };
+			glm::vec3 angularVelocity{ 0.0f };
+
+			// 0 makes the body static
+			float mass = 1.0f;
+			float friction = 0.5f;
+			float restitution = 0.0f;
+		};
+
+		struct Settings {
+			glm::vec3 gravity{ 0.0f, -9.81f, 0.0f };
+			uint32_t velocityIterations = 10;
+
+			// fraction of the penetration past slop removed per step
+			float baumgarte = 0.2f;
+			float slop = 0.005f;
+
+			// closing speeds below this don't bounce
+			float restitutionThreshold = 1.0f;
+
+			bool allowSleep = true;
+			float sleepLinear = 0.05f;
+			float sleepAngular = 0.05f;
+			float sleepTime = 0.5f;
+		};
+
+		struct Contact {
+			BodyId a = null, b = null;
+
+			// from a towards b
+			glm::vec3 normal{};
+			glm::vec3 point{};
+			float depth = 0.0f;
+
+			// from the pair's Manifold, 0 if unknown
+			uint32_t feature = 0;
+
+			// accumulated impulses, carried over to the next step for warm starting
+			float normalImpulse = 0.0f;
+			glm::vec2 tangentImpulse{ 0.0f };
+		};
+
+	private:
+		using Tree = AABBTree<BodyId>;
+		using Pair = Narrowphase<Shape3D, Manifold3D>::Pair;
+
+		enum Flags : uint8_t {
+			alive = 1,
+			awake = 2
+		};
+
+		// per contact solver state, rebuilt every step
+		struct Constraint {
+			glm::vec3 rA{}, rB{};
+			glm::vec3 tangents[2]{};
+			float normalMass = 0.0f;
+			glm::vec2 tangentMass{ 0.0f };
+			float bias = 0.0f;
+			float friction = 0.0f;
+		};
+
+		Settings m_settings;
+
+		// body storage
+		std::vector<glm::vec3> m_position{};
+		std::vector<glm::quat> m_rotation{};
+		std::vector<glm::vec3> m_linearVelocity{};
+		std::vector<glm::vec3> m_angularVelocity{};
+		std::vector<glm::vec3> m_force{};
+		std::vector<glm::vec3> m_torque{};
+		std::vector<float> m_invMass{};
+		std::vector<glm::mat3> m_invInertiaLocal{};
+		std::vector<glm::mat3> m_invInertia{};
+		std::vector<float> m_friction{};
+		std::vector<float> m_restitution{};
+		std::vector<float> m_sleepTimer{};
+		std::vector<uint8_t> m_flags{};
+		std::vector<BodyShape> m_shape{};
+		std::vector<Shape3D> m_worldShape{};
+		std::vector<Tree::NodeId> m_proxy{};
+		std::vector<BodyId> m_free{};
+		size_t m_alive = 0;
+
+		Tree m_tree{ 0.1f };
+		Narrowphase<Shape3D, Manifold3D> m_narrowphase{};
+		std::vector<Pair> m_pairs{};
+
+		std::vector<Contact> m_contacts{};
+		std::vector<Constraint> m_constraints{};
+		// manifolds of the pairs touching in the last step, they hold the warm starting impulses
+		struct CachedManifold {
+			PersistentManifold manifold{};
+			uint64_t step = 0;
+		};
+
+		std::unordered_map<uint64_t, CachedManifold> m_manifolds{};
+		std::vector<PersistentManifold::Point*> m_contactPoints{};
+		uint64_t m_step = 0;
+
+		// islands as compact ranges into the sorted body and contact lists
+		std::vector<BodyId> m_parent{};
+		std::vector<uint32_t> m_island{};
+		std::vector<uint32_t> m_islandBodyStart{};
+		std::vector<uint32_t> m_islandContactStart{};
+		std::vector<BodyId> m_islandBodies{};
+		std::vector<uint32_t> m_islandContacts{};
+		std::vector<uint32_t> m_islandIds{};
+		std::vector<uint32_t> m_fill{};
+
+		[[nodiscard]]
+		static constexpr uint64_t pairKey(BodyId a, BodyId b) noexcept {
+			return (uint64_t(a) << 32) | uint64_t(b);
+		}
+
+		void checkBody(BodyId id) const {
+			if (id >= m_flags.size() || !(m_flags[id] & alive))
+				throw std::invalid_argument("BodyId does not refer to a body of this RigidWorld");
+		}
+
+		[[nodiscard]]
+		bool isDynamic(BodyId id) const noexcept {
+			return m_invMass[id] > 0.0f;
+		}
+
+		[[nodiscard]]
+		static bool isFinite(const glm::vec3& v) noexcept {
+			return std::isfinite(v.x) && std::isfinite(v.y) && std::isfinite(v.z);
+		}
+
+		[[nodiscard]]
+		static Shape3D toWorld(const BodyShape& shape, const glm::vec3& pos, const glm::quat& rot) {
+			return std::visit([&](const auto& s) -> Shape3D {
+				using T = std::decay_t<decltype(s)>;
+
+				if constexpr (std::is_same_v<T, Circle3D>) {
+					return Circle3D{ pos + rot * s.getCenter(), s.getRadius() };
+				}
+				else if constexpr (std::is_same_v<T, Capsule3D>) {
+					return Capsule3D{ pos + rot * s.getPointA(), pos + rot * s.getPointB(), s.getRadius() };
+				}
+				else {
+					return OriRect3D{ pos + rot * s.getCenter(), s.getHalfExtents(), rot * s.getRotation() };
+				}
+			}, shape);
+		}
+
+		[[nodiscard]]
+		static glm::mat3 inertiaOf(const BodyShape& shape, float mass) {
+			return std::visit([mass](const auto& s) {
+				return parallelAxisTheorem(glm::mat3(s.getInertia(mass)), mass, s.getCenter());
+			}, shape);
+		}
+
+		void refreshBody(BodyId id) {
+			auto rot = glm::mat3_cast(m_rotation[id]);
+			m_invInertia[id] = rot * m_invInertiaLocal[id] * glm::transpose(rot);
+			m_worldShape[id] = toWorld(m_shape[id], m_position[id], m_rotation[id]);
+		}
+
+		void wakeBody(BodyId id) noexcept {
+			if (isDynamic(id)) {
+				m_flags[id] |= awake;
+				m_sleepTimer[id] = 0.0f;
+			}
+		}
+
+		// static bodies are shared between islands, so they must never be written to
+		void applyImpulseAt(BodyId id, const glm::vec3& impulse, const glm::vec3& rel) noexcept {
+			if (!isDynamic(id))
+				return;
+
+			m_linearVelocity[id] += impulse * m_invMass[id];
+			m_angularVelocity[id] += m_invInertia[id] * math::torque(impulse, rel);
+		}
+
+		[[nodiscard]]
+		float effectiveMass(BodyId a, BodyId b, const glm::vec3& rA, const glm::vec3& rB, const glm::vec3& dir) const noexcept {
+			auto angA = glm::cross(m_invInertia[a] * glm::cross(rA, dir), rA);
+			auto angB = glm::cross(m_invInertia[b] * glm::cross(rB, dir), rB);
+
+			auto k = m_invMass[a] + m_invMass[b] + glm::dot(angA + angB, dir);
+			return k > 0.0f ? 1.0f / k : 0.0f;
+		}
+
+		[[nodiscard]]
+		glm::vec3 relativeVelocity(BodyId a, BodyId b, const glm::vec3& rA, const glm::vec3& rB) const noexcept {
+			return math::contactVelocity(m_linearVelocity[b], m_angularVelocity[b], rB) -
+				math::contactVelocity(m_linearVelocity[a], m_angularVelocity[a], rA);
+		}
+
+		void integrateForces(float dt) {
+			for (BodyId id = 0; id < m_flags.size(); ++id) {
+				if (!(m_flags[id] & awake))
+					continue;
+
+				auto accel = m_settings.gravity + m_force[id] * m_invMass[id];
+				m_linearVelocity[id] = math::forwardEuler(m_linearVelocity[id], dt, accel);
+				m_angularVelocity[id] = math::forwardEuler(m_angularVelocity[id], dt, m_invInertia[id] * m_torque[id]);
+			}
+		}
+
+		void updateBroadphase(float dt) {
+			for (BodyId id = 0; id < m_flags.size(); ++id) {
+				if (!(m_flags[id] & awake))
+					continue;
+
+				refreshBody(id);
+				auto bounds = std::visit([](const auto& s) { return sndx::collision::getBounds(s); }, m_worldShape[id]);
+				m_tree.move(m_proxy[id], bounds, m_linearVelocity[id] * dt);
+			}
+
+			m_pairs.clear();
+			m_tree.queryPairs([this](Tree::NodeId nodeA, Tree::NodeId nodeB) {
+				auto a = m_tree.getData(nodeA);
+				auto b = m_tree.getData(nodeB);
+
+				// resting and static bodies don't need contacts among themselves
+				if (!((m_flags[a] | m_flags[b]) & awake))
+					return;
+
+				m_pairs.emplace_back(std::min(a, b), std::max(a, b));
+			});
+
+			// the order the tree reports pairs in depends on its shape, the solver shouldn't
+			std::sort(m_pairs.begin(), m_pairs.end());
+		}
+
+		void findContacts(auto&& policy) {
+#ifndef __APPLE__
+			m_narrowphase.run(std::forward<decltype(policy)>(policy), std::span<const Shape3D>{ m_worldShape }, std::span<const Pair>{ m_pairs });
+#else
+			m_narrowphase.run(std::span<const Shape3D>{ m_worldShape }, std::span<const Pair>{ m_pairs });
+#endif
+
+			++m_step;
+			m_contacts.clear();
+			m_contactPoints.clear();
+
+			for (auto hit : m_narrowphase.getHits()) {
+				auto fresh = m_narrowphase.getResult(hit);
+				auto [a, b] = m_pairs[hit];
+
+				if (!isFinite(fresh.normal) || glm::length2(fresh.normal) == 0.0f)
+					continue;
+
+				fresh.normal = glm::normalize(fresh.normal);
+
+				auto& cached = m_manifolds[pairKey(a, b)];
+				cached.step = m_step;
+				cached.manifold.update(fresh);
+
+				for (auto& point : cached.manifold.getPoints()) {
+					auto mid = (point.a + point.b) * 0.5f;
+					if (!std::isfinite(point.depth) || !isFinite(mid))
+						continue;
+
+					auto& contact = m_contacts.emplace_back();
+					contact.a = a;
+					contact.b = b;
+					contact.normal = fresh.normal;
+					contact.point = mid;
+					contact.depth = point.depth;
+					contact.feature = point.feature;
+					contact.normalImpulse = point.normalImpulse;
+					contact.tangentImpulse = point.tangentImpulse;
+
+					m_contactPoints.push_back(&point);
+				}
+			}
+
+			// node based, so erasing doesn't move the manifolds m_contactPoints refers to
+			std::erase_if(m_manifolds, [this](const auto& kv) {
+				return kv.second.step != m_step;
+			});
+		}
+
+		[[nodiscard]]
+		BodyId findRoot(BodyId id) noexcept {
+			while (m_parent[id] != id) {
+				m_parent[id] = m_parent[m_parent[id]];
+				id = m_parent[id];
+			}
+			return id;
+		}
+
+		void buildIslands() {
+			auto count = BodyId(m_flags.size());
+
+			m_parent.resize(count);
+			std::iota(m_parent.begin(), m_parent.end(), BodyId(0));
+
+			// static bodies don't join islands, otherwise the ground would merge everything
+			for (const auto& contact : m_contacts) {
+				if (isDynamic(contact.a) && isDynamic(contact.b)) {
+					auto ra = findRoot(contact.a);
+					auto rb = findRoot(contact.b);
+					if (ra != rb) {
+						m_parent[std::max(ra, rb)] = std::min(ra, rb);
+					}
+				}
+			}
+
+			// an awake body wakes its whole island
+			m_island.assign(count, null);
+			for (BodyId id = 0; id < count; ++id) {
+				if (m_flags[id] & awake) {
+					m_island[findRoot(id)] = 0;
+				}
+			}
+
+			// number islands by their lowest body
+			uint32_t islands = 0;
+			for (BodyId id = 0; id < count; ++id) {
+				if (!(m_flags[id] & alive) || !isDynamic(id))
+					continue;
+
+				auto root = findRoot(id);
+				if (m_island[root] == null)
+					continue;
+
+				if (root == id) {
+					m_island[root] = islands++;
+				}
+
+				if (!(m_flags[id] & awake)) {
+					wakeBody(id);
+					refreshBody(id);
+				}
+			}
+
+			m_islandBodyStart.assign(islands + 1, 0);
+			m_islandContactStart.assign(islands + 1, 0);
+
+			for (BodyId id = 0; id < count; ++id) {
+				if (m_flags[id] & awake) {
+					++m_islandBodyStart[m_island[findRoot(id)] + 1];
+				}
+			}
+
+			for (auto& contact : m_contacts) {
+				auto owner = isDynamic(contact.a) ? contact.a : contact.b;
+				++m_islandContactStart[m_island[findRoot(owner)] + 1];
+			}
+
+			std::partial_sum(m_islandBodyStart.begin(), m_islandBodyStart.end(), m_islandBodyStart.begin());
+			std::partial_sum(m_islandContactStart.begin(), m_islandContactStart.end(), m_islandContactStart.begin());
+
+			// counting sort keeps bodies and contacts in their original order within an island
+			m_islandBodies.resize(m_islandBodyStart.back());
+			m_islandContacts.resize(m_islandContactStart.back());
+
+			m_fill.assign(m_islandBodyStart.begin(), m_islandBodyStart.end() - 1);
+			for (BodyId id = 0; id < count; ++id) {
+				if (m_flags[id] & awake) {
+					m_islandBodies[m_fill[m_island[findRoot(id)]]++] = id;
+				}
+			}
+
+			m_fill.assign(m_islandContactStart.begin(), m_islandContactStart.end() - 1);
+			for (uint32_t i = 0; i < m_contacts.size(); ++i) {
+				const auto& contact = m_contacts[i];
+				auto owner = isDynamic(contact.a) ? contact.a : contact.b;
+				m_islandContacts[m_fill[m_island[findRoot(owner)]]++] = i;
+			}
+
+			m_islandIds.resize(islands);
+			std::iota(m_islandIds.begin(), m_islandIds.end(), uint32_t(0));
+
+			m_constraints.resize(m_contacts.size());
+		}
+
+		void prepareContact(uint32_t i, float dt) {
+			auto& contact = m_contacts[i];
+			auto& c = m_constraints[i];
+			auto a = contact.a;
+			auto b = contact.b;
+			const auto& n = contact.normal;
+
+			c.rA = contact.point - m_position[a];
+			c.rB = contact.point - m_position[b];
+
+			// any orthonormal basis works, friction is isotropic
+			auto t = std::abs(n.x) > 0.57735f ? glm::vec3{ n.y, -n.x, 0.0f } : glm::vec3{ 0.0f, n.z, -n.y };
+			c.tangents[0] = glm::normalize(t);
+			c.tangents[1] = glm::cross(n, c.tangents[0]);
+
+			c.normalMass = effectiveMass(a, b, c.rA, c.rB, n);
+			c.tangentMass[0] = effectiveMass(a, b, c.rA, c.rB, c.tangents[0]);
+			c.tangentMass[1] = effectiveMass(a, b, c.rA, c.rB, c.tangents[1]);
+			c.friction = std::sqrt(m_friction[a] * m_friction[b]);
+
+			c.bias = m_settings.baumgarte / dt * std::max(contact.depth - m_settings.slop, 0.0f);
+
+			auto vn = glm::dot(relativeVelocity(a, b, c.rA, c.rB), n);
+			if (vn < -m_settings.restitutionThreshold) {
+				c.bias = std::max(c.bias, -std::max(m_restitution[a], m_restitution[b]) * vn);
+			}
+
+			auto impulse = n * contact.normalImpulse +
+				c.tangents[0] * contact.tangentImpulse[0] +
+				c.tangents[1] * contact.tangentImpulse[1];
+
+			applyImpulseAt(a, -impulse, c.rA);
+			applyImpulseAt(b, impulse, c.rB);
+		}
+
+		void solveContact(uint32_t i) {
+			auto& contact = m_contacts[i];
+			const auto& c = m_constraints[i];
+			auto a = contact.a;
+			auto b = contact.b;
+
+			// friction first, normal impulses are more important so they get the last word
+			auto maxFriction = c.friction * contact.normalImpulse;
+			for (glm::length_t axis = 0; axis < 2; ++axis) {
+				auto vt = glm::dot(relativeVelocity(a, b, c.rA, c.rB), c.tangents[axis]);
+				auto lambda = -vt * c.tangentMass[axis];
+
+				auto old = contact.tangentImpulse[axis];
+				contact.tangentImpulse[axis] = std::clamp(old + lambda, -maxFriction, maxFriction);
+				auto impulse = c.tangents[axis] * (contact.tangentImpulse[axis] - old);
+
+				applyImpulseAt(a, -impulse, c.rA);
+				applyImpulseAt(b, impulse, c.rB);
+			}
+
+			auto vn = glm::dot(relativeVelocity(a, b, c.rA, c.rB), contact.normal);
+			auto lambda = (c.bias - vn) * c.normalMass;
+
+			auto old = contact.normalImpulse;
+			contact.normalImpulse = std::max(old + lambda, 0.0f);
+			auto impulse = contact.normal * (contact.normalImpulse - old);
+
+			applyImpulseAt(a, -impulse, c.rA);
+			applyImpulseAt(b, impulse, c.rB);
+		}
+
+		// touches only the island's own bodies and contacts, static bodies are read only
+		void solveIsland(uint32_t island, float dt) {
+			std::span<const uint32_t> contacts{
+				m_islandContacts.data() + m_islandContactStart[island],
+				m_islandContacts.data() + m_islandContactStart[island + 1]
+			};
+			std::span<const BodyId> bodies{
+				m_islandBodies.data() + m_islandBodyStart[island],
+				m_islandBodies.data() + m_islandBodyStart[island + 1]
+			};
+
+			for (auto i : contacts) {
+				prepareContact(i, dt);
+			}
+
+			for (uint32_t it = 0; it < m_settings.velocityIterations; ++it) {
+				for (auto i : contacts) {
+					solveContact(i);
+				}
+			}
+
+			float minTimer = std::numeric_limits<float>::max();
+			auto linTol = m_settings.sleepLinear * m_settings.sleepLinear;
+			auto angTol = m_settings.sleepAngular * m_settings.sleepAngular;
+
+			for (auto id : bodies) {
+				m_position[id] = math::forwardEuler(m_position[id], dt, m_linearVelocity[id]);
+
+				const auto& w = m_angularVelocity[id];
+				auto spin = glm::quat{ 0.0f, w.x, w.y, w.z } * m_rotation[id];
+				m_rotation[id] = glm::normalize(m_rotation[id] + spin * (0.5f * dt));
+
+				if (glm::length2(m_linearVelocity[id]) > linTol || glm::length2(m_angularVelocity[id]) > angTol) {
+					m_sleepTimer[id] = 0.0f;
+				}
+				else {
+					m_sleepTimer[id] += dt;
+				}
+				minTimer = std::min(minTimer, m_sleepTimer[id]);
+			}
+
+			if (m_settings.allowSleep && minTimer >= m_settings.sleepTime) {
+				for (auto id : bodies) {
+					m_linearVelocity[id] = glm::vec3{ 0.0f };
+					m_angularVelocity[id] = glm::vec3{ 0.0f };
+					m_flags[id] &= uint8_t(~awake);
+				}
+			}
+		}
+
+		void storeImpulses() {
+			for (size_t i = 0; i < m_contacts.size(); ++i) {
+				m_contactPoints[i]->normalImpulse = m_contacts[i].normalImpulse;
+				m_contactPoints[i]->tangentImpulse = m_contacts[i].tangentImpulse;
+			}
+			m_contactPoints.clear();
+
+			for (BodyId id = 0; id < m_flags.size(); ++id) {
+				m_force[id] = glm::vec3{ 0.0f };
+				m_torque[id] = glm::vec3{ 0.0f };
+
+				// sleeping bodies keep the shape they fell asleep with
+				if (m_flags[id] & awake) {
+					refreshBody(id);
+				}
+			}
+		}
+
+	public:
+		RigidWorld() :
+			RigidWorld(Settings{}) {}
+
+		explicit RigidWorld(const Settings& settings) :
+			m_settings(settings) {}
+
+		[[nodiscard]]
+		const Settings& getSettings() const noexcept {
+			return m_settings;
+		}
+
+		void setSettings(const Settings& settings) noexcept {
+			m_settings = settings;
+		}
+
+		BodyId addBody(const BodyDesc& desc) {
+			if (!(desc.mass >= 0.0f) || !std::isfinite(desc.mass))
+				throw std::invalid_argument("RigidWorld body mass must be finite and >= 0");
+
+			BodyId id;
+			if (m_free.empty()) {
+				if (m_flags.size() >= size_t(null))
+					throw std::length_error("Too many bodies for RigidWorld");
+
+				id = BodyId(m_flags.size());
+				m_position.emplace_back();
+				m_rotation.emplace_back();
+				m_linearVelocity.emplace_back();
+				m_angularVelocity.emplace_back();
+				m_force.emplace_back();
+				m_torque.emplace_back();
+				m_invMass.emplace_back();
+				m_invInertiaLocal.emplace_back();
+				m_invInertia.emplace_back();
+				m_friction.emplace_back();
+				m_restitution.emplace_back();
+				m_sleepTimer.emplace_back();
+				m_flags.emplace_back();
+				m_shape.emplace_back(desc.shape);
+				m_worldShape.emplace_back(toWorld(desc.shape, desc.position, desc.rotation));
+				m_proxy.emplace_back(Tree::null);
+			}
+			else {
+				id = m_free.back();
+				m_free.pop_back();
+			}
+
+			bool dynamic = desc.mass > 0.0f;
+
+			m_position[id] = desc.position;
+			m_rotation[id] = glm::normalize(desc.rotation);
+			m_linearVelocity[id] = dynamic ? desc.linearVelocity : glm::vec3{ 0.0f };
+			m_angularVelocity[id] = dynamic ? desc.angularVelocity : glm::vec3{ 0.0f };
+			m_force[id] = glm::vec3{ 0.0f };
+			m_torque[id] = glm::vec3{ 0.0f };
+			m_invMass[id] = dynamic ? 1.0f / desc.mass : 0.0f;
+			m_invInertiaLocal[id] = dynamic ? glm::inverse(inertiaOf(desc.shape, desc.mass)) : glm::mat3{ 0.0f };
+			m_friction[id] = desc.friction;
+			m_restitution[id] = desc.restitution;
+			m_sleepTimer[id] = 0.0f;
+			m_flags[id] = dynamic ? uint8_t(alive | awake) : uint8_t(alive);
+			m_shape[id] = desc.shape;
+
+			refreshBody(id);
+			m_proxy[id] = m_tree.insert(std::visit([](const auto& s) { return sndx::collision::getBounds(s); }, m_worldShape[id]), id);
+
+			++m_alive;
+			return id;
+		}
+
+		void removeBody(BodyId id) {
+			checkBody(id);
+
+			// neighbours resting on the body need to notice it's gone
+			m_tree.query(m_tree.getFatBounds(m_proxy[id]), [this](Tree::NodeId node) {
+				wakeBody(m_tree.getData(node));
+			});
+
+			std::erase_if(m_contacts, [id](const Contact& contact) {
+				return contact.a == id || contact.b == id;
+			});
+			std::erase_if(m_manifolds, [id](const auto& kv) {
+				return BodyId(kv.first >> 32) == id || BodyId(kv.first & 0xffffffff) == id;
+			});
+
+			m_tree.remove(m_proxy[id]);
+			m_proxy[id] = Tree::null;
+			m_flags[id] = 0;
+			m_free.push_back(id);
+			--m_alive;
+		}
+
+		void setTransform(BodyId id, const glm::vec3& position, const glm::quat& rotation) {
+			checkBody(id);
+			m_position[id] = position;
+			m_rotation[id] = glm::normalize(rotation);
+			refreshBody(id);
+
+			auto bounds = std::visit([](const auto& s) { return sndx::collision::getBounds(s); }, m_worldShape[id]);
+			m_tree.move(m_proxy[id], bounds);
+			wakeBody(id);
+		}
+
+		void setLinearVelocity(BodyId id, const glm::vec3& velocity) {
+			checkBody(id);
+			if (isDynamic(id)) {
+				m_linearVelocity[id] = velocity;
+				wakeBody(id);
+			}
+		}
+
+		void setAngularVelocity(BodyId id, const glm::vec3& velocity) {
+			checkBody(id);
+			if (isDynamic(id)) {
+				m_angularVelocity[id] = velocity;
+				wakeBody(id);
+			}
+		}
+
+		// applied at the center of mass during the next step
+		void applyForce(BodyId id, const glm::vec3& force) {
+			checkBody(id);
+			m_force[id] += force;
+			wakeBody(id);
+		}
+
+		// point is in world space
+		void applyForce(BodyId id, const glm::vec3& force, const glm::vec3& point) {
+			checkBody(id);
+			m_force[id] += force;
+			m_torque[id] += math::torque(force, point - m_position[id]);
+			wakeBody(id);
+		}
+
+		// point is in world space, takes effect immediately
+		void applyImpulse(BodyId id, const glm::vec3& impulse, const glm::vec3& point) {
+			checkBody(id);
+			wakeBody(id);
+			applyImpulseAt(id, impulse, point - m_position[id]);
+		}
+
+		void wake(BodyId id) {
+			checkBody(id);
+			wakeBody(id);
+		}
+
+#ifndef __APPLE__
+		void step(auto&& policy, float dt) {
+			if (!(dt > 0.0f))
+				throw std::invalid_argument("RigidWorld step must be > 0");
+
+			integrateForces(dt);
+			updateBroadphase(dt);
+			findContacts(policy);
+			buildIslands();
+
+			std::for_each(std::forward<decltype(policy)>(policy), m_islandIds.begin(), m_islandIds.end(), [this, dt](uint32_t island) {
+				solveIsland(island, dt);
+			});
+
+			storeImpulses();
+		}
+#endif
+
+		// epa allocates, so this defaults to par rather than par_unseq
+		void step(float dt) {
+#ifndef __APPLE__
+			step(std::execution::par, dt);
+#else
+			if (!(dt > 0.0f))
+				throw std::invalid_argument("RigidWorld step must be > 0");
+
+			integrateForces(dt);
+			updateBroadphase(dt);
+			findContacts(nullptr);
+			buildIslands();
+
+			for (auto island : m_islandIds) {
+				solveIsland(island, dt);
+			}
+
+			storeImpulses();
+#endif
+		}
+
+		/* Info Methods */
+
+		[[nodiscard]]
+		bool contains(BodyId id) const noexcept {
+			return id < m_flags.size() && (m_flags[id] & alive);
+		}
+
+		[[nodiscard]]
+		const glm::vec3& getPosition(BodyId id) const {
+			checkBody(id);
+			return m_position[id];
+		}
+
+		[[nodiscard]]
+		const glm::quat& getRotation(BodyId id) const {
+			checkBody(id);
+			return m_rotation[id];
+		}
+
+		[[nodiscard]]
+		const glm::vec3& getLinearVelocity(BodyId id) const {
+			checkBody(id);
+			return m_linearVelocity[id];
+		}
+
+		[[nodiscard]]
+		const glm::vec3& getAngularVelocity(BodyId id) const {
+			checkBody(id);
+			return m_angularVelocity[id];
+		}
+
+		[[nodiscard]]
+		float getInverseMass(BodyId id) const {
+			checkBody(id);
+			return m_invMass[id];
+		}
+
+		// the body's shape in world space as of the last step
+		[[nodiscard]]
+		const Shape3D& getShape(BodyId id) const {
+			checkBody(id);
+			return m_worldShape[id];
+		}
+
+		[[nodiscard]]
+		bool isStatic(BodyId id) const {
+			checkBody(id);
+			return !isDynamic(id);
+		}
+
+		[[nodiscard]]
+		bool isAwake(BodyId id) const {
+			checkBody(id);
+			return (m_flags[id] & awake) != 0;
+		}
+
+		// contacts from the last step, with the impulses that resolved them
+		[[nodiscard]]
+		std::span<const Contact> getContacts() const noexcept {
+			return m_contacts;
+		}
+
+		// islands solved in the last step
+		[[nodiscard]]
+		size_t islandCount() const noexcept {
+			return m_islandIds.size();
+		}
+
+		[[nodiscard]]
+		size_t awakeCount() const noexcept {
+			return size_t(std::count_if(m_flags.begin(), m_flags.end(), [](uint8_t flags) {
+				return (flags & awake) != 0;
+			}));
+		}
+
+		[[nodiscard]]
+		size_t size() const noexcept {
+			return m_alive;
+		}
+
+		[[nodiscard]]
+		bool empty() const noexcept {
+			return m_alive == 0;
+		}
+	};
+}
\ No newline at end of file
@@ -2,10 +2,15 @@
 
 #include <array>
 #include <string>
+#include <string_view>
 #include <set>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 #include <algorithm>
+#include <limits>
+#include <numeric>
+#include <optional>
 #include <stdexcept>
 
 #include <glm/glm.hpp>
@@ -18,6 +23,16 @@ namespace sndx::math {
 		size_t neededWidth{};
 		size_t neededHeight{};
 
+		// ids placed a quarter turn around, they take up height x width
+		std::unordered_set<IdT> rotated{};
+
+		// area of every entry without padding
+		size_t usedArea{};
+
+		// only filled by multi page packers, every page is neededWidth x neededHeight
+		std::unordered_map<IdT, size_t> entryPages{};
+		size_t neededPages{};
+
 		[[nodiscard]]
 		auto empty() const noexcept {
 			return positions.empty();
@@ -52,6 +67,29 @@ namespace sndx::math {
 		auto height() const noexcept {
 			return neededHeight;
 		}
+
+		[[nodiscard]]
+		bool isRotated(const IdT& id) const noexcept {
+			return rotated.contains(id);
+		}
+
+		[[nodiscard]]
+		size_t pages() const noexcept {
+			return empty() ? 0 : std::max(neededPages, size_t(1));
+		}
+
+		[[nodiscard]]
+		size_t page(const IdT& id) const {
+			auto it = entryPages.find(id);
+			return it == entryPages.end() ? 0 : it->second;
+		}
+
+		// fraction of width() * height() on every page covered by entries, 1 is perfect
+		[[nodiscard]]
+		double efficiency() const noexcept {
+			auto area = neededWidth * neededHeight * pages();
+			return area == 0 ? 0.0 : double(usedArea) / double(area);
+		}
 	};
 
 	template <bool horizontal>
@@ -127,6 +165,9 @@ namespace sndx::math {
 		std::multiset<LabeledEntry, std::greater<LabeledEntry>> m_entries{};
 
 	public:
+		// names the algorithm and its settings, the same on every compiler for keying baked atlases
+		static constexpr std::string_view cacheTag = horizontal ? "shelves horizontal" : "shelves vertical";
+
 		void add(const IdT& id, size_t width, size_t height) {
 			m_entries.emplace(id, width, height);
 		}
@@ -147,6 +188,8 @@ namespace sndx::math {
 				if (entry.getSecondaryDim() > dimConstraint)
 					throw std::invalid_argument("Cannot pack box that exceeds size constraint itself.");
 
+				out.usedArea += entry.dims[0] * entry.dims[1];
+
 				bool added = false;
 				for (auto& prevShelf : shelves) {
 					added = prevShelf.tryAddEntry(entry, padding);
@@ -198,4 +241,479 @@ namespace sndx::math {
 			return out;
 		}
 	};
+
+	namespace detail {
+		template <class IdT>
+		struct PackRect {
+			IdT id;
+			size_t width, height;
+		};
+
+		// order the skyline and maxrects packers place entries in, tallest first or longest side first.
+		// ties keep the order entries were added in so packings are reproducible
+		template <bool tallestFirst, class IdT> [[nodiscard]]
+		std::vector<size_t> packingOrder(const std::vector<PackRect<IdT>>& entries) {
+			std::vector<size_t> order(entries.size());
+			std::iota(order.begin(), order.end(), size_t(0));
+
+			auto key = [](const PackRect<IdT>& entry) {
+				if constexpr (tallestFirst) {
+					return std::pair{ entry.height, entry.width };
+				}
+				else {
+					return std::pair{ std::max(entry.width, entry.height), std::min(entry.width, entry.height) };
+				}
+			};
+
+			std::stable_sort(order.begin(), order.end(), [&entries, &key](size_t a, size_t b) {
+				return key(entries[a]) > key(entries[b]);
+			});
+
+			return order;
+		}
+
+		template <class IdT>
+		void placeRect(Packing<IdT>& out, const PackRect<IdT>& entry, size_t x, size_t y, bool rotated) {
+			auto width = rotated ? entry.height : entry.width;
+			auto height = rotated ? entry.width : entry.height;
+
+			out.positions.emplace(entry.id, glm::vec<2, size_t>{ x, y });
+			if (rotated) {
+				out.rotated.emplace(entry.id);
+			}
+
+			out.usedArea += width * height;
+			out.neededWidth = std::max(out.neededWidth, x + width);
+			out.neededHeight = std::max(out.neededHeight, y + height);
+		}
+
+		template <bool allowRotation, class IdT>
+		void checkFits(const PackRect<IdT>& entry, size_t maxWidth, size_t maxHeight = std::numeric_limits<size_t>::max()) {
+			auto fits = entry.width <= maxWidth && entry.height <= maxHeight;
+			if constexpr (allowRotation) {
+				fits = fits || (entry.height <= maxWidth && entry.width <= maxHeight);
+			}
+
+			if (!fits)
+				throw std::invalid_argument("Cannot pack box that exceeds size constraint itself.");
+		}
+
+		// free space for MaxRects style packing, the list holds maximal rectangles that may overlap each other
+		struct FreeRect {
+			size_t x, y, width, height;
+
+			[[nodiscard]]
+			bool contains(const FreeRect& other) const noexcept {
+				return other.x >= x && other.y >= y &&
+					other.x + other.width <= x + width &&
+					other.y + other.height <= y + height;
+			}
+
+			[[nodiscard]]
+			bool overlaps(const FreeRect& other) const noexcept {
+				return other.x < x + width && x < other.x + other.width &&
+					other.y < y + height && y < other.y + other.height;
+			}
+		};
+
+		// adds created to free, dropping anything another rectangle covers.
+		// only new rectangles can be redundant or make others redundant
+		inline void addFreeRects(std::vector<FreeRect>& free, std::vector<FreeRect>& created) {
+			for (size_t i = 0; i < created.size();) {
+				bool redundant = false;
+				for (size_t j = 0; j < created.size() && !redundant; ++j) {
+					redundant = j != i && created[j].contains(created[i]) && (!created[i].contains(created[j]) || j < i);
+				}
+				for (size_t j = 0; j < free.size() && !redundant; ++j) {
+					redundant = free[j].contains(created[i]);
+				}
+
+				if (redundant) {
+					created[i] = created.back();
+					created.pop_back();
+				}
+				else {
+					++i;
+				}
+			}
+
+			std::erase_if(free, [&created](const FreeRect& f) {
+				return std::any_of(created.begin(), created.end(), [&f](const FreeRect& rect) {
+					return rect.contains(f);
+				});
+			});
+
+			free.insert(free.end(), created.begin(), created.end());
+		}
+
+		// splits every free rectangle overlapping used into the parts outside of it
+		inline void splitFreeRects(std::vector<FreeRect>& free, const FreeRect& used) {
+			std::vector<FreeRect> created{};
+
+			for (size_t i = 0; i < free.size();) {
+				auto f = free[i];
+				if (!f.overlaps(used)) {
+					++i;
+					continue;
+				}
+
+				if (used.x > f.x)
+					created.push_back(FreeRect{ f.x, f.y, used.x - f.x, f.height });
+
+				if (used.x + used.width < f.x + f.width)
+					created.push_back(FreeRect{ used.x + used.width, f.y, f.x + f.width - used.x - used.width, f.height });
+
+				if (used.y > f.y)
+					created.push_back(FreeRect{ f.x, f.y, f.width, used.y - f.y });
+
+				if (used.y + used.height < f.y + f.height)
+					created.push_back(FreeRect{ f.x, used.y + used.height, f.width, f.y + f.height - used.y - used.height });
+
+				free[i] = free.back();
+				free.pop_back();
+			}
+
+			addFreeRects(free, created);
+		}
+
+		// gives used space back to the free list.
+		// it is merged with free rectangles it lines up with and stretched into neighbours that span it,
+		// that recovers most but not always all of the maximal rectangles
+		inline void releaseFreeRect(std::vector<FreeRect>& free, FreeRect rect) {
+			for (bool merged = true; merged;) {
+				merged = false;
+
+				for (size_t i = 0; i < free.size(); ++i) {
+					const auto& f = free[i];
+					bool column = f.x == rect.x && f.width == rect.width && f.y <= rect.y + rect.height && rect.y <= f.y + f.height;
+					bool row = f.y == rect.y && f.height == rect.height && f.x <= rect.x + rect.width && rect.x <= f.x + f.width;
+
+					if (column || row) {
+						auto x = std::min(f.x, rect.x);
+						auto y = std::min(f.y, rect.y);
+						rect = FreeRect{ x, y,
+							std::max(f.x + f.width, rect.x + rect.width) - x,
+							std::max(f.y + f.height, rect.y + rect.height) - y };
+
+						free[i] = free.back();
+						free.pop_back();
+						merged = true;
+						break;
+					}
+				}
+			}
+
+			std::vector<FreeRect> created{ rect };
+			for (const auto& f : free) {
+				bool touchesX = f.x <= rect.x + rect.width && rect.x <= f.x + f.width;
+				bool touchesY = f.y <= rect.y + rect.height && rect.y <= f.y + f.height;
+
+				if (touchesX && f.y <= rect.y && f.y + f.height >= rect.y + rect.height) {
+					auto x = std::min(f.x, rect.x);
+					created.push_back(FreeRect{ x, rect.y, std::max(f.x + f.width, rect.x + rect.width) - x, rect.height });
+				}
+
+				if (touchesY && f.x <= rect.x && f.x + f.width >= rect.x + rect.width) {
+					auto y = std::min(f.y, rect.y);
+					created.push_back(FreeRect{ rect.x, y, rect.width, std::max(f.y + f.height, rect.y + rect.height) - y });
+				}
+			}
+
+			addFreeRects(free, created);
+		}
+	}
+
+	// Skyline bottom-left packing, packs width up to dimConstraint and grows downwards like BinPacker<true>.
+	// the skyline is the top edge of everything placed so far, each entry goes where its top edge ends up highest.
+	// much tighter than shelves and still cheap, O(entries * skyline segments)
+	template <class IdT = std::string, bool allowRotation = false>
+	class SkylinePacker {
+	private:
+		struct Segment {
+			size_t x, y, width;
+		};
+
+		std::vector<detail::PackRect<IdT>> m_entries{};
+
+		// the lowest y a footprint of width starting at segment i can rest at and the area it buries under itself.
+		// nothing if it runs off the edge
+		[[nodiscard]]
+		static std::optional<std::pair<size_t, size_t>> restingHeight(const std::vector<Segment>& skyline, size_t i, size_t width, size_t binWidth) noexcept {
+			auto end = skyline[i].x + width;
+			if (end > binWidth)
+				return std::nullopt;
+
+			// the skyline spans the whole bin so these can't run off the end
+			size_t y = 0;
+			auto last = i;
+			for (; last < skyline.size() && skyline[last].x < end; ++last) {
+				y = std::max(y, skyline[last].y);
+			}
+
+			size_t waste = 0;
+			for (; i < last; ++i) {
+				auto covered = std::min(end, skyline[i].x + skyline[i].width) - skyline[i].x;
+				waste += (y - skyline[i].y) * covered;
+			}
+
+			return std::pair{ y, waste };
+		}
+
+		static void addToSkyline(std::vector<Segment>& skyline, size_t i, size_t width, size_t top) {
+			auto x = skyline[i].x;
+			skyline.insert(skyline.begin() + std::ptrdiff_t(i), Segment{ x, top, width });
+
+			// trim everything the new segment covers
+			auto end = x + width;
+			auto j = i + 1;
+			while (j < skyline.size() && skyline[j].x < end) {
+				auto segEnd = skyline[j].x + skyline[j].width;
+				if (segEnd <= end) {
+					skyline.erase(skyline.begin() + std::ptrdiff_t(j));
+				}
+				else {
+					skyline[j].width = segEnd - end;
+					skyline[j].x = end;
+					break;
+				}
+			}
+
+			// merge neighbours at the same height
+			for (size_t k = (i > 0 ? i - 1 : 0); k + 1 < skyline.size() && k <= i + 1;) {
+				if (skyline[k].y == skyline[k + 1].y) {
+					skyline[k].width += skyline[k + 1].width;
+					skyline.erase(skyline.begin() + std::ptrdiff_t(k + 1));
+				}
+				else {
+					++k;
+				}
+			}
+		}
+
+	public:
+		static constexpr std::string_view cacheTag = allowRotation ? "skyline rotating" : "skyline";
+
+		void add(const IdT& id, size_t width, size_t height) {
+			m_entries.push_back(detail::PackRect<IdT>{ id, width, height });
+		}
+
+		[[nodiscard]]
+		Packing<IdT> pack(size_t dimConstraint, size_t padding = 0) const {
+			Packing<IdT> out{};
+
+			if (m_entries.empty()) [[unlikely]]
+				return out;
+
+			out.positions.reserve(m_entries.size());
+
+			// every footprint carries its padding on the right and bottom, the last column's is free
+			auto binWidth = dimConstraint + padding;
+			std::vector<Segment> skyline{ Segment{ 0, 0, binWidth } };
+
+			for (auto idx : detail::packingOrder<true>(m_entries)) {
+				const auto& entry = m_entries[idx];
+				detail::checkFits<allowRotation>(entry, dimConstraint);
+
+				// top edge, buried area, x
+				std::array<size_t, 3> bestScore{};
+				bestScore.fill(std::numeric_limits<size_t>::max());
+				size_t bestSegment = 0;
+				bool bestRotated = false;
+
+				auto tryFit = [&](size_t width, size_t height, bool rotated) {
+					for (size_t i = 0; i < skyline.size(); ++i) {
+						auto rest = restingHeight(skyline, i, width, binWidth);
+						if (!rest)
+							continue;
+
+						std::array<size_t, 3> score{ rest->first + height, rest->second, skyline[i].x };
+						if (score < bestScore) {
+							bestScore = score;
+							bestSegment = i;
+							bestRotated = rotated;
+						}
+					}
+				};
+
+				tryFit(entry.width + padding, entry.height + padding, false);
+				if constexpr (allowRotation) {
+					if (entry.width != entry.height) {
+						tryFit(entry.height + padding, entry.width + padding, true);
+					}
+				}
+
+				auto width = (bestRotated ? entry.height : entry.width) + padding;
+				auto height = (bestRotated ? entry.width : entry.height) + padding;
+				auto x = skyline[bestSegment].x;
+
+				detail::placeRect(out, entry, x, bestScore[0] - height, bestRotated);
+				addToSkyline(skyline, bestSegment, width, bestScore[0]);
+			}
+
+			return out;
+		}
+	};
+
+	// MaxRects packing, keeps every maximal free rectangle so entries can fill holes skylines can't reach.
+	// packs width up to dimConstraint and grows downwards like BinPacker<true>.
+	// entries go where they grow the packing the least, then where they fit the snuggest (best short side fit).
+	// slower than SkylinePacker but gives the smallest packings
+	template <class IdT = std::string, bool allowRotation = false>
+	class MaxRectsPacker {
+	private:
+		std::vector<detail::PackRect<IdT>> m_entries{};
+
+	public:
+		static constexpr std::string_view cacheTag = allowRotation ? "maxrects rotating" : "maxrects";
+
+		void add(const IdT& id, size_t width, size_t height) {
+			m_entries.push_back(detail::PackRect<IdT>{ id, width, height });
+		}
+
+		[[nodiscard]]
+		Packing<IdT> pack(size_t dimConstraint, size_t padding = 0) const {
+			Packing<IdT> out{};
+
+			if (m_entries.empty()) [[unlikely]]
+				return out;
+
+			out.positions.reserve(m_entries.size());
+
+			// every footprint carries its padding on the right and bottom, the last column's is free.
+			// stacking everything in one column always fits, so that height is as good as unbounded
+			auto binWidth = dimConstraint + padding;
+			size_t binHeight = 0;
+			for (const auto& entry : m_entries) {
+				detail::checkFits<allowRotation>(entry, dimConstraint);
+				binHeight += std::max(entry.width, entry.height) + padding;
+			}
+
+			std::vector<detail::FreeRect> free{ detail::FreeRect{ 0, 0, binWidth, binHeight } };
+			size_t height = 0;
+
+			for (auto idx : detail::packingOrder<false>(m_entries)) {
+				const auto& entry = m_entries[idx];
+
+				// growth, short side leftover, y, x
+				std::array<size_t, 4> bestScore{};
+				bestScore.fill(std::numeric_limits<size_t>::max());
+				detail::FreeRect best{};
+				bool bestRotated = false;
+
+				auto tryFit = [&](size_t w, size_t h, bool rotated) {
+					for (const auto& f : free) {
+						if (w > f.width || h > f.height)
+							continue;
+
+						std::array<size_t, 4> score{
+							std::max(height, f.y + h) - height,
+							std::min(f.width - w, f.height - h),
+							f.y, f.x
+						};
+
+						if (score < bestScore) {
+							bestScore = score;
+							best = detail::FreeRect{ f.x, f.y, w, h };
+							bestRotated = rotated;
+						}
+					}
+				};
+
+				tryFit(entry.width + padding, entry.height + padding, false);
+				if constexpr (allowRotation) {
+					if (entry.width != entry.height) {
+						tryFit(entry.height + padding, entry.width + padding, true);
+					}
+				}
+
+				detail::placeRect(out, entry, best.x, best.y, bestRotated);
+				height = std::max(height, best.y + best.height);
+				detail::splitFreeRects(free, best);
+			}
+
+			return out;
+		}
+	};
+
+	// Packs into pages of at most maxWidth x maxHeight, opening a new page when nothing fits.
+	// every page shares the same size so they upload as layers of one texture array.
+	// entries are placed on the first page with room using best short side fit, keeping early pages dense
+	template <class IdT = std::string, bool allowRotation = false>
+	class PagePacker {
+	private:
+		std::vector<detail::PackRect<IdT>> m_entries{};
+
+	public:
+		static constexpr std::string_view cacheTag = allowRotation ? "pages rotating" : "pages";
+
+		void add(const IdT& id, size_t width, size_t height) {
+			m_entries.push_back(detail::PackRect<IdT>{ id, width, height });
+		}
+
+		[[nodiscard]]
+		Packing<IdT> pack(size_t maxWidth, size_t maxHeight, size_t padding = 0) const {
+			Packing<IdT> out{};
+
+			if (m_entries.empty()) [[unlikely]]
+				return out;
+
+			out.positions.reserve(m_entries.size());
+			out.entryPages.reserve(m_entries.size());
+
+			for (const auto& entry : m_entries) {
+				detail::checkFits<allowRotation>(entry, maxWidth, maxHeight);
+			}
+
+			// the padding past the last row and column of a page is free
+			const detail::FreeRect blank{ 0, 0, maxWidth + padding, maxHeight + padding };
+			std::vector<std::vector<detail::FreeRect>> pages{};
+
+			for (auto idx : detail::packingOrder<false>(m_entries)) {
+				const auto& entry = m_entries[idx];
+
+				std::optional<detail::FreeRect> best{};
+				bool bestRotated = false;
+				size_t page = 0;
+
+				for (; page <= pages.size() && !best; ++page) {
+					if (page == pages.size()) {
+						pages.emplace_back(1, blank);
+					}
+
+					// short side leftover, y, x
+					std::array<size_t, 3> bestScore{};
+					bestScore.fill(std::numeric_limits<size_t>::max());
+
+					auto tryFit = [&](size_t w, size_t h, bool rotated) {
+						for (const auto& f : pages[page]) {
+							if (w > f.width || h > f.height)
+								continue;
+
+							std::array<size_t, 3> score{ std::min(f.width - w, f.height - h), f.y, f.x };
+							if (score < bestScore) {
+								bestScore = score;
+								best = detail::FreeRect{ f.x, f.y, w, h };
+								bestRotated = rotated;
+							}
+						}
+					};
+
+					tryFit(entry.width + padding, entry.height + padding, false);
+					if constexpr (allowRotation) {
+						if (entry.width != entry.height) {
+							tryFit(entry.height + padding, entry.width + padding, true);
+						}
+					}
+				}
+				--page;
+
+				detail::placeRect(out, entry, best->x, best->y, bestRotated);
+				out.entryPages.emplace(entry.id, page);
+				detail::splitFreeRects(pages[page], *best);
+			}
+
+			out.neededPages = pages.size();
+			return out;
+		}
+	};
 }
\ No newline at end of file
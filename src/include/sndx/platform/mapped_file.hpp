@@ -0,0 +1,150 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+#include <utility>
+
+#include "./windows.h"
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace sndx::platform {
+	// Read only memory map of a whole file, check valid() after opening.
+	// the view stays usable until the MappedFile is closed or destroyed
+	class MappedFile {
+	private:
+	#ifdef _WIN32
+		HANDLE m_file = INVALID_HANDLE_VALUE;
+		HANDLE m_mapping = nullptr;
+	#endif
+		const std::byte* m_data = nullptr;
+		size_t m_size = 0;
+		bool m_valid = false;
+
+	public:
+		MappedFile() noexcept = default;
+
+		explicit MappedFile(const std::filesystem::path& path) noexcept {
+		#ifdef _WIN32
+			m_file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+			if (m_file == INVALID_HANDLE_VALUE)
+				return;
+
+			LARGE_INTEGER size{};
+			if (!GetFileSizeEx(m_file, &size)) {
+				close();
+				return;
+			}
+
+			m_size = size_t(size.QuadPart);
+			m_valid = true;
+
+			// empty files can't be mapped
+			if (m_size == 0)
+				return;
+
+			m_mapping = CreateFileMappingW(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			if (m_mapping == nullptr) {
+				close();
+				return;
+			}
+
+			m_data = static_cast<const std::byte*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+			if (m_data == nullptr) {
+				close();
+			}
+		#else
+			int fd = ::open(path.c_str(), O_RDONLY);
+			if (fd < 0)
+				return;
+
+			struct stat info{};
+			if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)) {
+				::close(fd);
+				return;
+			}
+
+			m_size = size_t(info.st_size);
+			m_valid = true;
+
+			// the mapping holds its own reference to the file
+			if (m_size != 0) {
+				void* data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+				if (data == MAP_FAILED) {
+					close();
+				}
+				else {
+					m_data = static_cast<const std::byte*>(data);
+				}
+			}
+
+			::close(fd);
+		#endif
+		}
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile(MappedFile&& other) noexcept :
+		#ifdef _WIN32
+			m_file(std::exchange(other.m_file, INVALID_HANDLE_VALUE)), m_mapping(std::exchange(other.m_mapping, nullptr)),
+		#endif
+			m_data(std::exchange(other.m_data, nullptr)), m_size(std::exchange(other.m_size, 0)), m_valid(std::exchange(other.m_valid, false)) {}
+
+		MappedFile& operator=(const MappedFile&) = delete;
+		MappedFile& operator=(MappedFile&& other) noexcept {
+		#ifdef _WIN32
+			std::swap(m_file, other.m_file);
+			std::swap(m_mapping, other.m_mapping);
+		#endif
+			std::swap(m_data, other.m_data);
+			std::swap(m_size, other.m_size);
+			std::swap(m_valid, other.m_valid);
+			return *this;
+		}
+
+		~MappedFile() noexcept {
+			close();
+		}
+
+		void close() noexcept {
+		#ifdef _WIN32
+			if (m_data)
+				UnmapViewOfFile(m_data);
+
+			if (m_mapping)
+				CloseHandle(m_mapping);
+
+			if (m_file != INVALID_HANDLE_VALUE)
+				CloseHandle(m_file);
+
+			m_mapping = nullptr;
+			m_file = INVALID_HANDLE_VALUE;
+		#else
+			if (m_data)
+				munmap(const_cast<std::byte*>(m_data), m_size);
+		#endif
+			m_data = nullptr;
+			m_size = 0;
+			m_valid = false;
+		}
+
+		[[nodiscard]]
+		bool valid() const noexcept {
+			return m_valid;
+		}
+
+		[[nodiscard]]
+		std::span<const std::byte> data() const noexcept {
+			return std::span{ m_data, m_size };
+		}
+
+		[[nodiscard]]
+		size_t size() const noexcept {
+			return m_size;
+		}
+	};
+}
\ No newline at end of file
@@ -4,8 +4,11 @@
 #include "./render/image/stbimage.hpp"
 
 #include "./render/atlas.hpp"
+#include "./render/atlas_cache.hpp"
+#include "./render/dynamic_atlas.hpp"
 #include "./render/camera.hpp"
 #include "./render/font.hpp"
+#include "./render/frustum.hpp"
 #include "./render/viewport.hpp"
 
 #ifndef SNDX_NO_GL
@@ -3,12 +3,18 @@
 #include "../math/binpack.hpp"
 
 #include "./image/imagedata.hpp"
+#include "./image/blit.hpp"
+
+#include "../utility/hash.hpp"
 
 #include <unordered_map>
 #include <string>
+#include <string_view>
 #include <functional>
 #include <algorithm>
 #include <execution>
+#include <concepts>
+#include <stdexcept>
 
 namespace sndx::render {
 	
@@ -16,16 +22,35 @@ namespace sndx::render {
 	struct ImageAtlas {
 		struct Entry {
 			glm::vec<2, size_t> pos, dims;
+
+			// stored transposed, image x runs down the atlas and dims is the atlas footprint
+			bool rotated = false;
+
+			// pos is relative to the page
+			size_t page = 0;
 		};
 
 		std::unordered_map<IdT, Entry> m_entries{};
+
+		// pages are stacked top to bottom, the layout a texture array upload expects
 		ImageData m_image;
+		size_t m_pages = 1;
 
 		template <class>
 		friend class AtlasBuilder;
 
-		ImageAtlas(decltype(m_entries)&& entries, ImageData&& image) :
-			m_entries(std::move(entries)), m_image(std::move(image)) {}
+		ImageAtlas(decltype(m_entries)&& entries, ImageData&& image, size_t pages = 1) :
+			m_entries(std::move(entries)), m_image(std::move(image)), m_pages(pages) {}
+
+		[[nodiscard]]
+		auto pages() const noexcept {
+			return m_pages;
+		}
+
+		[[nodiscard]]
+		auto pageHeight() const noexcept {
+			return m_image.height() / m_pages;
+		}
 	};
 
 	template <class IdT> [[nodiscard]]
@@ -46,24 +71,45 @@ namespace sndx::render {
 	private:
 		struct Entry {
 			glm::vec2 pos, dims;
+			bool rotated = false;
+			size_t page = 0;
 		};
 
 		std::unordered_map<IdT, Entry> m_entries;
 		TextureT m_texture;
+		size_t m_pages = 1;
 
 		TextureAtlas(decltype(m_entries)&& entries, TextureT&& texture) :
 			m_entries(std::move(entries)), m_texture(std::move(texture)) {}
+
+		// array textures take (image, layers, mipmaps, compress) and get a layer per page
+		static constexpr bool layered = std::constructible_from<TextureT, const ImageData&, size_t, int, bool>;
+
+		[[nodiscard]]
+		static TextureT makeTexture(const ImageAtlas<IdT>& atlas, bool compress) {
+			if constexpr (layered) {
+				return TextureT{ atlas.m_image, atlas.pages(), 0, compress };
+			}
+			else {
+				// stacking the pages in one texture would bring back the size limit they were split for
+				if (atlas.pages() > 1)
+					throw std::invalid_argument("Multi page atlases need an array texture");
+
+				return TextureT{ atlas.m_image, 0, compress };
+			}
+		}
 	public:
 
+		// multi page atlases are normalized per page, sample layer page of the texture
 		TextureAtlas(const ImageAtlas<IdT>& atlas, bool compress = false):
-			m_entries{}, m_texture{atlas.m_image, 0, compress } {
+			m_entries{}, m_texture{ makeTexture(atlas, compress) }, m_pages(atlas.pages()) {
 			m_entries.reserve(atlas.m_entries.size());
 			const auto& image = atlas.m_image;
 
-			glm::vec2 scaling = 1.0f / glm::vec2{ image.width(), image.height()};
+			glm::vec2 scaling = 1.0f / glm::vec2{ image.width(), atlas.pageHeight() };
 
 			for (const auto& [id, entry] : atlas.m_entries) {
-				Entry e{ glm::vec2{entry.pos} *scaling, glm::vec2{entry.dims} *scaling };
+				Entry e{ glm::vec2{entry.pos} *scaling, glm::vec2{entry.dims} *scaling, entry.rotated, entry.page };
 				m_entries.emplace(id, std::move(e));
 			}
 		}
@@ -88,6 +134,11 @@ namespace sndx::render {
 			return m_entries.size();
 		}
 
+		[[nodiscard]]
+		auto pages() const noexcept {
+			return m_pages;
+		}
+
 		[[nodiscard]]
 		auto begin() const {
 			return m_entries.begin();
@@ -113,70 +164,43 @@ namespace sndx::render {
 		std::vector<Entry> m_entries{};
 		bool m_compress = false;
 
-	public:
-		using DefaultPacker = sndx::math::BinPacker<true, size_t>;
-
-		void add(const IdT& id, const ImageData& img) {
-			m_entries.emplace_back(id, img);
-		}
-
-		void reserve(size_t size) noexcept {
-			m_entries.reserve(size);
-		}
-
+		// copies every image to its spot, pages are width x height and stacked top to bottom
 #ifndef __APPLE__
-		template <class Packer = DefaultPacker> [[nodiscard]]
-		ImageAtlas<IdT> build(auto&& policy, size_t dimConstraint, size_t padding) const {
+		template <class PackingT> [[nodiscard]]
+		ImageAtlas<IdT> assemble(auto&& policy, const PackingT& packing, size_t width, size_t height) const {
 #else
-		template <class Packer = DefaultPacker> [[nodiscard]]
-		ImageAtlas<IdT> build(size_t dimConstraint, size_t padding) const {
+		template <class PackingT> [[nodiscard]]
+		ImageAtlas<IdT> assemble(const PackingT& packing, size_t width, size_t height) const {
 #endif
-			Packer packer{};
+			if (packing.empty() || packing.width() == 0 || packing.height() == 0) [[unlikely]] {
+				throw std::logic_error("Cannot create an empty atlas");
+			}
 
 			size_t maxChannels = 0;
-			for (size_t i = 0; i < m_entries.size(); ++i) {
-				const auto& img = m_entries[i].data.get();
-
-				maxChannels = std::max(maxChannels, size_t(img.channels()));
-				packer.add(i, img.width(), img.height());
+			for (const auto& entry : m_entries) {
+				maxChannels = std::max(maxChannels, size_t(entry.data.get().channels()));
 			}
 
-			auto packing = packer.pack(dimConstraint, padding);
-			if (packing.empty() || packing.width() == 0 || packing.height() == 0) [[unlikely]] {
-				throw std::logic_error("Cannot create an empty atlas");
-			}
-			
-			std::vector<std::byte> data{};
+			auto pages = packing.pages();
+			size_t stride = maxChannels * width;
 
-			data.resize(maxChannels * (packing.width() + padding) * (packing.height() + padding), std::byte(0x0));
+			std::vector<std::byte> data{};
+			data.resize(stride * height * pages, std::byte(0x0));
 
 #ifndef __APPLE__
 			std::for_each_n(std::forward<decltype(policy)>(policy), packing.begin(), m_entries.size(), 
 #else
 			std::for_each_n(packing.begin(), m_entries.size(),
 #endif
-				[this, &data, &maxChannels, &packing, &padding](const auto& entry) {
+				[this, &data, &maxChannels, &packing, &stride, &height](const auto& entry) {
 				
 				const auto& [imgIdx, pos] = entry;
 				const auto& [id, imgRef] = m_entries[imgIdx];
 				const auto& img = imgRef.get();
-				
-				size_t stride = maxChannels * (packing.width() + padding);
 
-				for (size_t y = 0; y < img.height(); ++y) {
-					size_t rowPos = (pos.y + y) * stride + pos.x * maxChannels;
-
-					for (size_t x = 0; x < img.width(); ++x) {
-						
-						for (size_t c = 0; c < img.channels(); ++c) {
-							data.at(rowPos + x * maxChannels + c) = img.at(x, y, c);
-						}
-
-						for (size_t c = img.channels(); c < maxChannels; ++c) {
-							data.at(rowPos + x * maxChannels + c) = c >= 3 ? std::byte(0xff) : std::byte(0x0);
-						}
-					}
-				}
+				// rotated entries are written transposed, moving along x in the image moves along y in the atlas
+				size_t origin = (packing.page(imgIdx) * height + pos.y) * stride + pos.x * maxChannels;
+				blitImage(data, origin, stride, maxChannels, img, packing.isRotated(imgIdx));
 			});
 
 			std::unordered_map<IdT, typename ImageAtlas<IdT>::Entry> entries{};
@@ -185,15 +209,102 @@ namespace sndx::render {
 			for (const auto& [imgIdx, pos] : packing) {
 				const auto& [id, img] = m_entries[imgIdx];
 
+				bool rotated = packing.isRotated(imgIdx);
+				glm::vec<2, size_t> dims{ img.get().width(), img.get().height() };
+
 				typename ImageAtlas<IdT>::Entry entry{
 					pos,
-					glm::vec<2, size_t>{img.get().width(), img.get().height()}
+					rotated ? glm::vec<2, size_t>{ dims.y, dims.x } : dims,
+					rotated,
+					packing.page(imgIdx)
 				};
 
 				entries.emplace(id, std::move(entry));
 			}
 
-			return ImageAtlas<IdT>{ std::move(entries), ImageData{packing.width() + padding, packing.height() + padding, uint8_t(maxChannels), std::move(data)}};
+			return ImageAtlas<IdT>{ std::move(entries), ImageData{width, height * pages, uint8_t(maxChannels), std::move(data)}, pages };
+		}
+
+	public:
+		using DefaultPacker = sndx::math::BinPacker<true, size_t>;
+		using DefaultPagePacker = sndx::math::PagePacker<size_t>;
+
+		void add(const IdT& id, const ImageData& img) {
+			m_entries.emplace_back(id, img);
+		}
+
+		void reserve(size_t size) noexcept {
+			m_entries.reserve(size);
+		}
+
+		// hash of every id and image in the order added, stable across runs for keying baked atlases
+		[[nodiscard]]
+		uint64_t contentHash(utility::ContentHasher hasher = utility::ContentHasher{}) const {
+			static_assert(std::integral<IdT> || std::convertible_to<const IdT&, std::string_view>, "Ids must be integers or strings to be hashed");
+
+			hasher.update(m_entries.size());
+			for (const auto& [id, imgRef] : m_entries) {
+				const auto& img = imgRef.get();
+
+				if constexpr (std::integral<IdT>) {
+					hasher.update(id);
+				}
+				else {
+					hasher.update(std::string_view{ id });
+				}
+
+				hasher.update(img.width()).update(img.height()).update(img.channels());
+				hasher.update(std::span{ img.data(), img.bytes() });
+			}
+
+			return hasher.value();
+		}
+
+#ifndef __APPLE__
+		template <class Packer = DefaultPacker> [[nodiscard]]
+		ImageAtlas<IdT> build(auto&& policy, size_t dimConstraint, size_t padding) const {
+#else
+		template <class Packer = DefaultPacker> [[nodiscard]]
+		ImageAtlas<IdT> build(size_t dimConstraint, size_t padding) const {
+#endif
+			Packer packer{};
+			for (size_t i = 0; i < m_entries.size(); ++i) {
+				const auto& img = m_entries[i].data.get();
+				packer.add(i, img.width(), img.height());
+			}
+
+			auto packing = packer.pack(dimConstraint, padding);
+
+#ifndef __APPLE__
+			return assemble(std::forward<decltype(policy)>(policy), packing, packing.width() + padding, packing.height() + padding);
+#else
+			return assemble(packing, packing.width() + padding, packing.height() + padding);
+#endif
+		}
+
+		// spills onto more pages instead of growing past maxWidth x maxHeight
+#ifndef __APPLE__
+		template <class Packer = DefaultPagePacker> [[nodiscard]]
+		ImageAtlas<IdT> buildPages(auto&& policy, size_t maxWidth, size_t maxHeight, size_t padding) const {
+#else
+		template <class Packer = DefaultPagePacker> [[nodiscard]]
+		ImageAtlas<IdT> buildPages(size_t maxWidth, size_t maxHeight, size_t padding = 1) const {
+#endif
+			Packer packer{};
+			for (size_t i = 0; i < m_entries.size(); ++i) {
+				const auto& img = m_entries[i].data.get();
+				packer.add(i, img.width(), img.height());
+			}
+
+			auto packing = packer.pack(maxWidth, maxHeight, padding);
+			auto width = std::min(packing.width() + padding, maxWidth);
+			auto height = std::min(packing.height() + padding, maxHeight);
+
+#ifndef __APPLE__
+			return assemble(std::forward<decltype(policy)>(policy), packing, width, height);
+#else
+			return assemble(packing, width, height);
+#endif
 		}
 
 #ifndef __APPLE__
@@ -202,6 +313,11 @@ namespace sndx::render {
 			return build<Packer>(std::execution::par_unseq, dimConstraint, padding);
 
 		}
+
+		template <class Packer = DefaultPagePacker> [[nodiscard]]
+		ImageAtlas<IdT> buildPages(size_t maxWidth, size_t maxHeight, size_t padding = 1) const {
+			return buildPages<Packer>(std::execution::par_unseq, maxWidth, maxHeight, padding);
+		}
 #endif
 
 #ifndef __APPLE__
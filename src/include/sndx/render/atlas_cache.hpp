@@ -0,0 +1,308 @@
+#pragma once
+
+#include "./atlas.hpp"
+
+#include "../data/serialize.hpp"
+#include "../platform/mapped_file.hpp"
+#include "../utility/hash.hpp"
+
+#include <array>
+#include <concepts>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace sndx::render {
+
+	namespace detail {
+		inline constexpr std::array<char, 8> atlasCacheMagic{ 'S', 'N', 'D', 'X', 'A', 'T', 'L', 'S' };
+		inline constexpr uint32_t atlasCacheVersion = 1;
+
+		// pixels start on a cache line so they can be uploaded straight from the map
+		inline constexpr size_t atlasCacheAlignment = 64;
+
+		template <class IdT, class OutputIt>
+		void serializeAtlasId(const IdT& id, OutputIt& out) {
+			static_assert(std::integral<IdT> || std::convertible_to<const IdT&, std::string_view>, "Ids must be integers or strings to be cached");
+
+			if constexpr (std::integral<IdT>) {
+				serializeToAdjust(out, uint64_t(id));
+			}
+			else {
+				std::string_view str{ id };
+				serializeToAdjust(out, uint64_t(str.size()));
+				for (char c : str) {
+					serializeToAdjust(out, c);
+				}
+			}
+		}
+
+		template <class IdT>
+		void deserializeAtlasId(IdT& id, const uint8_t*& in, const uint8_t* end) {
+			uint64_t value{};
+			deserializeFromAdjust(value, in, end);
+
+			if constexpr (std::integral<IdT>) {
+				id = IdT(value);
+				if (uint64_t(id) != value)
+					throw bad_field_error("Atlas cache id does not fit the id type");
+			}
+			else {
+				if (uint64_t(end - in) < value)
+					throw out_of_data_error("Ran out of data while deserializing");
+
+				id = IdT(reinterpret_cast<const char*>(in), size_t(value));
+				in += value;
+			}
+		}
+	}
+
+	// A baked ImageAtlas read through a memory map.
+	// the layout is a little endian header, the entry table, then the raw pixels aligned to 64 bytes.
+	// pixels() hands out the mapped bytes for uploading directly, toImageAtlas copies them once
+	template <class IdT = std::string>
+	class AtlasCache {
+	private:
+		using Entry = typename ImageAtlas<IdT>::Entry;
+
+		platform::MappedFile m_file{};
+		std::unordered_map<IdT, Entry> m_entries{};
+		std::span<const std::byte> m_pixels{};
+		uint64_t m_hash{};
+		size_t m_width{}, m_height{}, m_pages{};
+		uint8_t m_channels{};
+
+		AtlasCache() = default;
+
+	public:
+		// nothing if the file is missing or is not an atlas cache of this version.
+		// throws deserialize_error if it is one but is damaged
+		[[nodiscard]]
+		static std::optional<AtlasCache> open(const std::filesystem::path& path) {
+			AtlasCache out{};
+			out.m_file = platform::MappedFile{ path };
+			if (!out.m_file.valid())
+				return std::nullopt;
+
+			auto bytes = out.m_file.data();
+			auto begin = reinterpret_cast<const uint8_t*>(bytes.data());
+			auto end = begin + bytes.size();
+			auto it = begin;
+
+			std::array<char, 8> magic{};
+			uint32_t version{}, channels{};
+			if (bytes.size() < magic.size() + sizeof(version))
+				return std::nullopt;
+
+			deserializeFromAdjust(magic, it, end);
+			deserializeFromAdjust(version, it, end);
+			if (magic != detail::atlasCacheMagic || version != detail::atlasCacheVersion)
+				return std::nullopt;
+
+			uint64_t width{}, height{}, pages{}, count{}, pixelOffset{}, pixelBytes{};
+			deserializeFromAdjust(channels, it, end);
+			deserializeFromAdjust(out.m_hash, it, end);
+			deserializeFromAdjust(width, it, end);
+			deserializeFromAdjust(height, it, end);
+			deserializeFromAdjust(pages, it, end);
+			deserializeFromAdjust(count, it, end);
+			deserializeFromAdjust(pixelOffset, it, end);
+			deserializeFromAdjust(pixelBytes, it, end);
+
+			constexpr uint64_t maxSide = std::numeric_limits<uint32_t>::max();
+			if (channels == 0 || channels > 4 || width == 0 || width > maxSide || height == 0 || height > maxSide || pages == 0 || height % pages != 0)
+				throw bad_field_error("Atlas cache has a bad image description");
+
+			// width * height * channels can overflow, divide pixelBytes back down instead
+			if (pixelBytes % (channels * height) != 0 || pixelBytes / channels / height != width || pixelOffset < uint64_t(it - begin) || pixelOffset > bytes.size() || bytes.size() - pixelOffset < pixelBytes)
+				throw bad_field_error("Atlas cache pixels do not match its image description");
+
+			out.m_width = size_t(width);
+			out.m_height = size_t(height);
+			out.m_pages = size_t(pages);
+			out.m_channels = uint8_t(channels);
+			out.m_pixels = bytes.subspan(size_t(pixelOffset), size_t(pixelBytes));
+
+			auto pageHeight = height / pages;
+			auto tableEnd = begin + pixelOffset;
+			out.m_entries.reserve(size_t(std::min(count, uint64_t(bytes.size()))));
+
+			for (uint64_t i = 0; i < count; ++i) {
+				IdT id{};
+				uint64_t x{}, y{}, w{}, h{}, page{};
+				uint8_t rotated{};
+
+				detail::deserializeAtlasId(id, it, tableEnd);
+				deserializeFromAdjust(x, it, tableEnd);
+				deserializeFromAdjust(y, it, tableEnd);
+				deserializeFromAdjust(w, it, tableEnd);
+				deserializeFromAdjust(h, it, tableEnd);
+				deserializeFromAdjust(page, it, tableEnd);
+				deserializeFromAdjust(rotated, it, tableEnd);
+
+				if (x > width || w > width - x || y > pageHeight || h > pageHeight - y || page >= pages || rotated > 1)
+					throw bad_field_error("Atlas cache entry is outside of the atlas");
+
+				Entry entry{
+					glm::vec<2, size_t>{ size_t(x), size_t(y) },
+					glm::vec<2, size_t>{ size_t(w), size_t(h) },
+					rotated != 0,
+					size_t(page)
+				};
+
+				if (!out.m_entries.emplace(std::move(id), entry).second)
+					throw bad_field_error("Atlas cache has duplicate ids");
+			}
+
+			return out;
+		}
+
+		// writes next to path then swaps it in, readers never see half a file
+		static bool save(const std::filesystem::path& path, const ImageAtlas<IdT>& atlas, uint64_t hash) {
+			const auto& image = atlas.m_image;
+
+			std::vector<uint8_t> head{};
+			auto out = std::back_inserter(head);
+
+			serializeToAdjust(out, detail::atlasCacheMagic);
+			serializeToAdjust(out, detail::atlasCacheVersion);
+			serializeToAdjust(out, uint32_t(image.channels()));
+			serializeToAdjust(out, hash);
+			serializeToAdjust(out, uint64_t(image.width()));
+			serializeToAdjust(out, uint64_t(image.height()));
+			serializeToAdjust(out, uint64_t(atlas.pages()));
+			serializeToAdjust(out, uint64_t(atlas.m_entries.size()));
+
+			// the offset isn't known until the table is written
+			auto offsetAt = head.size();
+			serializeToAdjust(out, uint64_t(0));
+			serializeToAdjust(out, uint64_t(image.bytes()));
+
+			for (const auto& [id, entry] : atlas.m_entries) {
+				detail::serializeAtlasId(id, out);
+				serializeToAdjust(out, uint64_t(entry.pos.x));
+				serializeToAdjust(out, uint64_t(entry.pos.y));
+				serializeToAdjust(out, uint64_t(entry.dims.x));
+				serializeToAdjust(out, uint64_t(entry.dims.y));
+				serializeToAdjust(out, uint64_t(entry.page));
+				serializeToAdjust(out, uint8_t(entry.rotated));
+			}
+
+			auto alignment = detail::atlasCacheAlignment;
+			head.resize((head.size() + alignment - 1) / alignment * alignment, 0);
+
+			std::vector<uint8_t> offset{};
+			serializeTo(std::back_inserter(offset), uint64_t(head.size()));
+			std::copy(offset.begin(), offset.end(), head.begin() + std::ptrdiff_t(offsetAt));
+
+			auto temp = path;
+			temp += ".tmp";
+
+			{
+				std::ofstream file{ temp, std::ios::binary | std::ios::trunc };
+				if (!file)
+					return false;
+
+				file.write(reinterpret_cast<const char*>(head.data()), std::streamsize(head.size()));
+				file.write(reinterpret_cast<const char*>(image.data()), std::streamsize(image.bytes()));
+				if (!file)
+					return false;
+			}
+
+			std::error_code err{};
+			std::filesystem::rename(temp, path, err);
+			if (err) {
+				std::filesystem::remove(temp, err);
+				return false;
+			}
+
+			return true;
+		}
+
+		// copies the pixels out of the map
+		[[nodiscard]]
+		ImageAtlas<IdT> toImageAtlas() const {
+			std::vector<std::byte> data(m_pixels.begin(), m_pixels.end());
+			auto entries = m_entries;
+
+			return ImageAtlas<IdT>{ std::move(entries), ImageData{ m_width, m_height, m_channels, std::move(data) }, m_pages };
+		}
+
+		[[nodiscard]]
+		uint64_t hash() const noexcept {
+			return m_hash;
+		}
+
+		[[nodiscard]]
+		std::span<const std::byte> pixels() const noexcept {
+			return m_pixels;
+		}
+
+		[[nodiscard]]
+		const auto& getEntries() const noexcept {
+			return m_entries;
+		}
+
+		[[nodiscard]]
+		auto width() const noexcept {
+			return m_width;
+		}
+
+		[[nodiscard]]
+		auto height() const noexcept {
+			return m_height;
+		}
+
+		[[nodiscard]]
+		auto channels() const noexcept {
+			return m_channels;
+		}
+
+		[[nodiscard]]
+		auto pages() const noexcept {
+			return m_pages;
+		}
+	};
+
+	// loads the atlas baked at path if it was made with hash, otherwise builds and bakes it.
+	// damaged caches are rebuilt, a cache that can't be written still returns the built atlas
+	template <class IdT, class BuildFn> [[nodiscard]]
+	ImageAtlas<IdT> loadOrBuildAtlas(const std::filesystem::path& path, uint64_t hash, BuildFn&& build) {
+		try {
+			if (auto cache = AtlasCache<IdT>::open(path); cache && cache->hash() == hash) {
+				return cache->toImageAtlas();
+			}
+		}
+		catch (const deserialize_error&) {}
+
+		ImageAtlas<IdT> atlas = std::forward<BuildFn>(build)();
+		AtlasCache<IdT>::save(path, atlas, hash);
+		return atlas;
+	}
+
+	// AtlasBuilder::build that only repacks when the images, ids, packer or settings change.
+	// packerTag stands in for the packer in the key, it must change whenever the packing would
+	template <class Packer = AtlasBuilder<>::DefaultPacker, class IdT> [[nodiscard]]
+	ImageAtlas<IdT> buildCached(const AtlasBuilder<IdT>& builder, const std::filesystem::path& path, std::string_view packerTag, size_t dimConstraint, size_t padding = 1) {
+		utility::ContentHasher settings{};
+		settings.update(dimConstraint).update(padding).update(packerTag);
+
+		return loadOrBuildAtlas<IdT>(path, builder.contentHash(settings), [&]() {
+			return builder.template build<Packer>(dimConstraint, padding);
+		});
+	}
+
+	// keyed by Packer::cacheTag, the packers in math/binpack.hpp all have one
+	template <class Packer = AtlasBuilder<>::DefaultPacker, class IdT>
+		requires requires { { Packer::cacheTag } -> std::convertible_to<std::string_view>; }
+	[[nodiscard]]
+	ImageAtlas<IdT> buildCached(const AtlasBuilder<IdT>& builder, const std::filesystem::path& path, size_t dimConstraint, size_t padding = 1) {
+		return buildCached<Packer>(builder, path, std::string_view{ Packer::cacheTag }, dimConstraint, padding);
+	}
+}
\ No newline at end of file
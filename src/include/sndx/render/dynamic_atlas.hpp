@@ -0,0 +1,223 @@
+#pragma once
+
+#include "../math/binpack.hpp"
+
+#include "./image/imagedata.hpp"
+#include "./image/blit.hpp"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <span>
+#include <unordered_map>
+#include <string>
+#include <vector>
+#include <utility>
+#include <stdexcept>
+
+namespace sndx::render {
+
+	// An atlas that can be added to and removed from while in use, for sprites and glyphs that can't be baked.
+	// free space is tracked as a MaxRects free list so removed entries are reused.
+	// every change records the region of the image it touched, upload those instead of the whole image
+	template <class IdT = std::string>
+	class DynamicAtlas {
+	public:
+		struct Region {
+			glm::vec<2, size_t> pos, dims;
+		};
+
+	private:
+		std::unordered_map<IdT, Region> m_entries{};
+		std::vector<math::detail::FreeRect> m_free{};
+		std::vector<Region> m_dirty{};
+		ImageData m_image;
+		size_t m_padding;
+
+		// removals only merge with free space they line up with, the free list can be missing space after them
+		bool m_fragmented = false;
+
+		// entries carry their padding on the right and bottom, the last column's is free
+		[[nodiscard]]
+		math::detail::FreeRect footprint(const Region& region) const noexcept {
+			return math::detail::FreeRect{ region.pos.x, region.pos.y, region.dims.x + m_padding, region.dims.y + m_padding };
+		}
+
+		[[nodiscard]]
+		const math::detail::FreeRect* findSpace(size_t width, size_t height) const noexcept {
+			// best short side fit, then top left most
+			std::array<size_t, 3> bestScore{};
+			bestScore.fill(std::numeric_limits<size_t>::max());
+			const math::detail::FreeRect* best = nullptr;
+
+			for (const auto& f : m_free) {
+				if (width > f.width || height > f.height)
+					continue;
+
+				std::array<size_t, 3> score{ std::min(f.width - width, f.height - height), f.y, f.x };
+				if (score < bestScore) {
+					bestScore = score;
+					best = &f;
+				}
+			}
+
+			return best;
+		}
+
+		// exact free list from the entries still in the atlas
+		void rebuildFree() {
+			m_free.assign(1, math::detail::FreeRect{ 0, 0, m_image.width() + m_padding, m_image.height() + m_padding });
+
+			for (const auto& [id, region] : m_entries) {
+				math::detail::splitFreeRects(m_free, footprint(region));
+			}
+
+			m_fragmented = false;
+		}
+
+		void blit(const ImageData& img, const Region& region) {
+			size_t channels = m_image.channels();
+			size_t stride = m_image.width() * channels;
+			std::span<std::byte> data{ m_image.data(), m_image.bytes() };
+
+			blitImage(data, region.pos.y * stride + region.pos.x * channels, stride, channels, img);
+
+			// a removed entry may have left pixels in the padding
+			auto right = std::min(region.pos.x + region.dims.x + m_padding, m_image.width());
+			auto bottom = std::min(region.pos.y + region.dims.y + m_padding, m_image.height());
+			for (size_t y = region.pos.y; y < bottom; ++y) {
+				auto padStart = y < region.pos.y + region.dims.y ? region.pos.x + region.dims.x : region.pos.x;
+				std::fill(data.begin() + std::ptrdiff_t(y * stride + padStart * channels), data.begin() + std::ptrdiff_t(y * stride + right * channels), std::byte(0x0));
+			}
+
+			m_dirty.push_back(Region{ region.pos, glm::vec<2, size_t>{ right - region.pos.x, bottom - region.pos.y } });
+		}
+
+	public:
+		DynamicAtlas(size_t width, size_t height, uint8_t channels, size_t padding = 1) :
+			m_image{ width, height, channels, std::vector<std::byte>(width * height * channels, std::byte(0x0)) }, m_padding(padding) {
+
+			if (width == 0 || height == 0)
+				throw std::invalid_argument("Cannot create an empty atlas");
+
+			if (channels <= 0 || channels > 4)
+				throw std::invalid_argument("Channels must be between 1 and 4.");
+
+			clear();
+		}
+
+		/* Modifying Methods */
+
+		// returns false when there is no room left, the atlas is unchanged in that case.
+		// after removals a failed fit rebuilds the free list before giving up
+		bool insert(const IdT& id, const ImageData& img) {
+			if (m_entries.contains(id))
+				throw std::invalid_argument("Id is already in the atlas");
+
+			if (img.channels() > m_image.channels())
+				throw std::invalid_argument("Image has more channels than the atlas");
+
+			if (img.width() == 0 || img.height() == 0)
+				throw std::invalid_argument("Cannot add an empty image");
+
+			auto w = img.width() + m_padding;
+			auto h = img.height() + m_padding;
+
+			auto best = findSpace(w, h);
+			if (!best && m_fragmented) {
+				rebuildFree();
+				best = findSpace(w, h);
+			}
+
+			if (!best)
+				return false;
+
+			Region region{ glm::vec<2, size_t>{ best->x, best->y }, glm::vec<2, size_t>{ img.width(), img.height() } };
+			math::detail::splitFreeRects(m_free, footprint(region));
+
+			blit(img, region);
+			m_entries.emplace(id, region);
+			return true;
+		}
+
+		// the pixels stay in the image until the space is reused, nothing needs uploading
+		bool remove(const IdT& id) {
+			auto it = m_entries.find(id);
+			if (it == m_entries.end())
+				return false;
+
+			math::detail::releaseFreeRect(m_free, footprint(it->second));
+			m_entries.erase(it);
+			m_fragmented = true;
+			return true;
+		}
+
+		void clear() {
+			m_entries.clear();
+			rebuildFree();
+		}
+
+		// hands over the regions changed since the last call
+		[[nodiscard]]
+		std::vector<Region> takeDirty() noexcept {
+			return std::exchange(m_dirty, {});
+		}
+
+		/* Info Methods */
+
+		[[nodiscard]]
+		const auto& getDirty() const noexcept {
+			return m_dirty;
+		}
+
+		[[nodiscard]]
+		bool contains(const IdT& id) const {
+			return m_entries.contains(id);
+		}
+
+		[[nodiscard]]
+		const Region& getEntry(const IdT& id) const {
+			return m_entries.at(id);
+		}
+
+		[[nodiscard]]
+		const auto& getEntries() const noexcept {
+			return m_entries;
+		}
+
+		[[nodiscard]]
+		const ImageData& getImage() const noexcept {
+			return m_image;
+		}
+
+		[[nodiscard]]
+		auto width() const noexcept {
+			return m_image.width();
+		}
+
+		[[nodiscard]]
+		auto height() const noexcept {
+			return m_image.height();
+		}
+
+		[[nodiscard]]
+		auto size() const noexcept {
+			return m_entries.size();
+		}
+
+		[[nodiscard]]
+		bool empty() const noexcept {
+			return m_entries.empty();
+		}
+
+		[[nodiscard]]
+		auto begin() const {
+			return m_entries.begin();
+		}
+
+		[[nodiscard]]
+		auto end() const {
+			return m_entries.end();
+		}
+	};
+}
\ No newline at end of file
@@ -9,6 +9,7 @@
 #include <filesystem>
 
 #include "atlas.hpp"
+#include "atlas_cache.hpp"
 
 namespace sndx::render {
 	struct GlyphMetric {
@@ -95,6 +96,14 @@ namespace sndx::render {
 #endif
 		}
 
+		// reuses the atlas baked at path while the glyphs and settings are unchanged
+		template <class Packer = DefaultPacker> [[nodiscard]]
+		Font<ImageAtlas<FT_ULong>> buildCached(const std::filesystem::path& path, size_t dimConstraint, size_t padding = 1) const {
+			auto atlas = render::buildCached<Packer>(m_builder, path, dimConstraint, padding);
+
+			return Font<ImageAtlas<FT_ULong>>{std::move(atlas), m_metrics, m_maxBearingY, m_sdf};
+		}
+
 		template <class TextureT, class Packer = DefaultPacker> [[nodiscard]]
 		auto buildTexture(auto&& policy, size_t dimConstraint, size_t padding = 1, bool compress = false) {
 			auto atlas = TextureAtlas<TextureT, FT_ULong>{m_builder.build<Packer>(std::forward<decltype(policy)>(policy), dimConstraint, padding), compress};
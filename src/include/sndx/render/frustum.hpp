@@ -0,0 +1,309 @@
+#pragma once
+
+#include "./camera.hpp"
+
+#include "../collision/aabbtree.hpp"
+#include "../collision/circle.hpp"
+#include "../collision/rect.hpp"
+#include "../collision/rect_batch.hpp"
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// define SNDX_NO_SIMD to force the scalar kernels
+#ifndef SNDX_NO_SIMD
+#if defined(__AVX2__)
+#define SNDX_FRUSTUM_SIMD 2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SNDX_FRUSTUM_SIMD 1
+#include <emmintrin.h>
+#endif
+#endif
+
+#ifndef SNDX_FRUSTUM_SIMD
+#define SNDX_FRUSTUM_SIMD 0
+#endif
+
+namespace sndx::render {
+
+	// The six planes of a view volume, normals face inwards and are unit length.
+	// a point p is on the inside of plane i when dot(planes[i], vec4(p, 1)) >= 0.
+	// box and sphere tests are conservative, things near the corners of the frustum may pass.
+	struct Frustum {
+		// left, right, bottom, top, near, far
+		static constexpr size_t planeCount = 6;
+		static constexpr uint8_t allPlanes = (1 << planeCount) - 1;
+
+		enum class Result : uint8_t {
+			outside,
+			intersecting,
+			inside
+		};
+
+		std::array<glm::vec4, planeCount> planes{};
+
+		// Gribb & Hartmann, the planes are sums and differences of the rows of projView.
+		// ZO must match the depth range the projection was built with
+		template <bool ZO = false> [[nodiscard]]
+		static Frustum fromMatrix(const glm::mat4& projView) {
+			auto row = [&](glm::length_t r) {
+				return glm::vec4{ projView[0][r], projView[1][r], projView[2][r], projView[3][r] };
+			};
+
+			auto x = row(0), y = row(1), z = row(2), w = row(3);
+
+			Frustum out{};
+			out.planes = { w + x, w - x, w + y, w - y, ZO ? z : w + z, w - z };
+
+			for (auto& plane : out.planes) {
+				auto len = glm::length(glm::vec3(plane));
+				if (len <= 0.0f)
+					throw std::invalid_argument("Frustum matrix has a degenerate plane");
+
+				plane /= len;
+			}
+
+			return out;
+		}
+
+		template <bool ZO = false> [[nodiscard]]
+		static Frustum fromCamera(const Perspective& projection, const View& view) {
+			return fromMatrix<ZO>(projection.getMatrix<ZO>() * view.getMatrix());
+		}
+
+		[[nodiscard]]
+		float distance(size_t plane, const glm::vec3& point) const noexcept {
+			const auto& p = planes[plane];
+			return p.x * point.x + p.y * point.y + p.z * point.z + p.w;
+		}
+
+		[[nodiscard]]
+		bool contains(const glm::vec3& point) const noexcept {
+			for (size_t i = 0; i < planeCount; ++i) {
+				if (distance(i, point) < 0.0f)
+					return false;
+			}
+			return true;
+		}
+
+		[[nodiscard]]
+		bool intersects(const collision::Rect3D& box) const noexcept {
+			uint8_t mask = allPlanes;
+			uint8_t start = 0;
+			return classify(box, mask, start) != Result::outside;
+		}
+
+		[[nodiscard]]
+		bool intersects(const collision::Circle3D& sphere) const noexcept {
+			for (size_t i = 0; i < planeCount; ++i) {
+				if (distance(i, sphere.getCenter()) < -sphere.getRadius())
+					return false;
+			}
+			return true;
+		}
+
+		// Tests box against the planes set in mask, starting with plane start.
+		// planes box is entirely inside of are cleared from mask, children of box can skip them.
+		// on outside, start becomes the plane that rejected box so the next test of it tries that first.
+		[[nodiscard]]
+		Result classify(const collision::Rect3D& box, uint8_t& mask, uint8_t& start) const noexcept {
+			size_t tests = 0;
+			return classify(box, mask, start, tests);
+		}
+
+		// same as above, adds the number of planes actually tested to tests
+		[[nodiscard]]
+		Result classify(const collision::Rect3D& box, uint8_t& mask, uint8_t& start, size_t& tests) const noexcept {
+			const auto& lo = box.getP1();
+			const auto& hi = box.getP2();
+
+			for (size_t k = 0; k < planeCount; ++k) {
+				auto i = (start + k) % planeCount;
+				auto bit = uint8_t(1 << i);
+				if ((mask & bit) == 0)
+					continue;
+
+				++tests;
+
+				// corners furthest along and against the normal
+				const auto& p = planes[i];
+				glm::vec3 pos{ p.x >= 0.0f ? hi.x : lo.x, p.y >= 0.0f ? hi.y : lo.y, p.z >= 0.0f ? hi.z : lo.z };
+				glm::vec3 neg{ p.x >= 0.0f ? lo.x : hi.x, p.y >= 0.0f ? lo.y : hi.y, p.z >= 0.0f ? lo.z : hi.z };
+
+				if (distance(i, pos) < 0.0f) {
+					start = uint8_t(i);
+					return Result::outside;
+				}
+
+				if (!(distance(i, neg) < 0.0f)) {
+					mask &= uint8_t(~bit);
+				}
+			}
+
+			return mask == 0 ? Result::inside : Result::intersecting;
+		}
+
+		/* Batch Methods */
+
+		// bit i of out is set if boxes[i] intersects, same results as intersects(Rect3D).
+		// returns the number of set bits
+		size_t cull(const collision::RectBatch3D& boxes, std::vector<uint64_t>& out) const {
+			return boxes.planeMask(planes, out);
+		}
+
+		// bit i of out is set if the sphere (x[i], y[i], z[i]) of radius[i] intersects,
+		// same results as intersects(Circle3D). returns the number of set bits
+		size_t cullSpheres(std::span<const float> x, std::span<const float> y, std::span<const float> z, std::span<const float> radius, std::vector<uint64_t>& out) const {
+			auto count = x.size();
+			if (y.size() != count || z.size() != count || radius.size() != count)
+				throw std::invalid_argument("Frustum sphere arrays must be the same size");
+
+			out.assign((count + 63) / 64, 0);
+
+			size_t i = 0;
+#if SNDX_FRUSTUM_SIMD == 2
+			const auto zero = _mm256_setzero_ps();
+
+			for (; i + 8 <= count; i += 8) {
+				auto cx = _mm256_loadu_ps(x.data() + i);
+				auto cy = _mm256_loadu_ps(y.data() + i);
+				auto cz = _mm256_loadu_ps(z.data() + i);
+				auto negR = _mm256_sub_ps(zero, _mm256_loadu_ps(radius.data() + i));
+
+				auto outside = zero;
+				for (const auto& p : planes) {
+					auto d = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(
+						_mm256_mul_ps(_mm256_set1_ps(p.x), cx),
+						_mm256_mul_ps(_mm256_set1_ps(p.y), cy)),
+						_mm256_mul_ps(_mm256_set1_ps(p.z), cz)),
+						_mm256_set1_ps(p.w));
+					outside = _mm256_or_ps(outside, _mm256_cmp_ps(d, negR, _CMP_LT_OQ));
+				}
+
+				auto bits = uint64_t(~_mm256_movemask_ps(outside) & 0xff);
+				out[i / 64] |= bits << (i % 64);
+			}
+#elif SNDX_FRUSTUM_SIMD == 1
+			const auto zero = _mm_setzero_ps();
+
+			for (; i + 4 <= count; i += 4) {
+				auto cx = _mm_loadu_ps(x.data() + i);
+				auto cy = _mm_loadu_ps(y.data() + i);
+				auto cz = _mm_loadu_ps(z.data() + i);
+				auto negR = _mm_sub_ps(zero, _mm_loadu_ps(radius.data() + i));
+
+				auto outside = zero;
+				for (const auto& p : planes) {
+					auto d = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+						_mm_mul_ps(_mm_set1_ps(p.x), cx),
+						_mm_mul_ps(_mm_set1_ps(p.y), cy)),
+						_mm_mul_ps(_mm_set1_ps(p.z), cz)),
+						_mm_set1_ps(p.w));
+					outside = _mm_or_ps(outside, _mm_cmplt_ps(d, negR));
+				}
+
+				auto bits = uint64_t(~_mm_movemask_ps(outside) & 0xf);
+				out[i / 64] |= bits << (i % 64);
+			}
+#endif
+
+			// the spans aren't padded, finish the tail one at a time
+			for (; i < count; ++i) {
+				bool inside = true;
+				for (size_t p = 0; p < planeCount && inside; ++p) {
+					inside = !(distance(p, glm::vec3{ x[i], y[i], z[i] }) < -radius[i]);
+				}
+				out[i / 64] |= uint64_t(inside) << (i % 64);
+			}
+
+			size_t total = 0;
+			for (auto word : out) {
+				total += size_t(std::popcount(word));
+			}
+			return total;
+		}
+	};
+
+	// Walks an AABBTree against a Frustum, rejecting whole subtrees at once.
+	// children only test the planes their parent straddles, and every node remembers the plane
+	// that last rejected it to try first next time, which is usually right again while the camera moves smoothly.
+	class FrustumCuller {
+	private:
+		std::vector<uint8_t> m_lastPlane{};
+		size_t m_planeTests = 0;
+		size_t m_nodesVisited = 0;
+
+		[[nodiscard]]
+		uint8_t& lastPlane(uint32_t node) {
+			if (node >= m_lastPlane.size()) {
+				m_lastPlane.resize(size_t(node) + 1, 0);
+			}
+			return m_lastPlane[node];
+		}
+
+	public:
+		FrustumCuller() = default;
+
+		// calls fn(NodeId) for every leaf whose fat bounds intersect frustum.
+		// fn may return false to stop early
+		template <class DataT, class Fn>
+		void cull(const Frustum& frustum, const collision::AABBTree<DataT, glm::vec3>& tree, Fn&& fn) {
+			using Tree = collision::AABBTree<DataT, glm::vec3>;
+			using NodeId = typename Tree::NodeId;
+
+			m_planeTests = 0;
+			m_nodesVisited = 0;
+
+			if (tree.getRoot() == Tree::null)
+				return;
+
+			collision::detail::TraversalStack<std::pair<NodeId, uint8_t>> stack{};
+			stack.push({ tree.getRoot(), Frustum::allPlanes });
+
+			while (!stack.empty()) {
+				auto [id, mask] = stack.pop();
+				const auto& node = tree.getNode(id);
+				++m_nodesVisited;
+
+				if (mask != 0) {
+					auto& start = lastPlane(id);
+					if (frustum.classify(node.bounds, mask, start, m_planeTests) == Frustum::Result::outside)
+						continue;
+				}
+
+				if (node.isLeaf()) {
+					if (!collision::detail::invokeContinue(fn, id))
+						return;
+				}
+				else {
+					stack.push({ node.right, mask });
+					stack.push({ node.left, mask });
+				}
+			}
+		}
+
+		// drops the remembered planes, call when the tree is rebuilt
+		void reset() noexcept {
+			m_lastPlane.clear();
+		}
+
+		/* Info Methods */
+
+		// box vs plane tests done by the last cull
+		[[nodiscard]]
+		size_t getPlaneTests() const noexcept {
+			return m_planeTests;
+		}
+
+		[[nodiscard]]
+		size_t getNodesVisited() const noexcept {
+			return m_nodesVisited;
+		}
+	};
+}
\ No newline at end of file
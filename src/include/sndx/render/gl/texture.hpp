@@ -131,6 +131,98 @@ namespace sndx::render {
 		}
 	};
 
+	// Layers are stacked top to bottom in the source image, each height / layers rows tall
+	class Texture2DArray {
+	private:
+		size_t m_width{}, m_height{}, m_layers{};
+		GLuint m_id{};
+
+	public:
+
+		explicit Texture2DArray() = default;
+
+		Texture2DArray(const ImageData& image, size_t layers, GLint mipmaps = 0, bool compress = true) :
+			m_width(image.width()), m_height(layers == 0 ? 0 : image.height() / layers), m_layers(layers) {
+
+			if (layers == 0 || image.height() % layers != 0)
+				throw std::invalid_argument("Image height must be a multiple of the layer count");
+
+			glGenTextures(1, &m_id);
+			glBindTexture(GL_TEXTURE_2D_ARRAY, m_id);
+			glTexImage3D(GL_TEXTURE_2D_ARRAY, mipmaps, formatFromChannels(image.channels(), compress),
+				GLsizei(m_width), GLsizei(m_height), GLsizei(m_layers), 0, formatFromChannels(image.channels(), false), GL_UNSIGNED_BYTE, image.data());
+		}
+
+		Texture2DArray(const Texture2DArray&) = delete;
+		Texture2DArray(Texture2DArray&& other) noexcept :
+			m_width(std::exchange(other.m_width, 0)), m_height(std::exchange(other.m_height, 0)),
+			m_layers(std::exchange(other.m_layers, 0)), m_id(std::exchange(other.m_id, 0)) {}
+
+		Texture2DArray& operator=(const Texture2DArray&) = delete;
+		Texture2DArray& operator=(Texture2DArray&& other) noexcept {
+			std::swap(m_width, other.m_width);
+			std::swap(m_height, other.m_height);
+			std::swap(m_layers, other.m_layers);
+			std::swap(m_id, other.m_id);
+			return *this;
+		}
+
+		~Texture2DArray() noexcept {
+			if (m_id != 0)
+				glDeleteTextures(1, &m_id);
+
+			m_id = 0;
+		}
+
+		[[nodiscard]]
+		auto width() const noexcept {
+			return m_width;
+		}
+
+		// of a single layer
+		[[nodiscard]]
+		auto height() const noexcept {
+			return m_height;
+		}
+
+		[[nodiscard]]
+		auto layers() const noexcept {
+			return m_layers;
+		}
+
+		[[nodiscard]]
+		auto target() const noexcept {
+			return GLenum(GL_TEXTURE_2D_ARRAY);
+		}
+
+		void bind() const {
+			glBindTexture(GL_TEXTURE_2D_ARRAY, m_id);
+		}
+
+		void bind(size_t tex) const {
+			if (tex >= 32)
+				throw std::invalid_argument("Cannot bind beyond 32");
+
+			glActiveTexture(GLenum(GL_TEXTURE0 + tex));
+			bind();
+		}
+
+		// every layer, stacked the same way they were uploaded
+		[[nodiscard]]
+		ImageData asImage(uint8_t channels, GLint mipmap = 0) const {
+			auto format = formatFromChannels(channels, false);
+			size_t size = size_t(m_width * m_height * m_layers * channels * sizeof(std::byte));
+
+			std::vector<std::byte> data{};
+			data.resize(size);
+
+			bind();
+			glGetTexImage(GL_TEXTURE_2D_ARRAY, mipmap, format, GL_UNSIGNED_BYTE, data.data());
+
+			return ImageData{ m_width, m_height * m_layers, channels, std::move(data) };
+		}
+	};
+
 	template <class Loader> [[nodiscard]]
 	auto loadTextureFile(const std::filesystem::path& path, uint8_t channels, const Loader& loader, GLint mipmaps = 0, bool compress = true) {
 		if (auto img = loadImageFile(path, channels, loader)) {
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "./imagedata.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+
+// define SNDX_NO_SIMD to force the scalar kernels
+#ifndef SNDX_NO_SIMD
+#if defined(__SSSE3__) || defined(__AVX__)
+#define SNDX_BLIT_SIMD 2
+#include <tmmintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SNDX_BLIT_SIMD 1
+#include <emmintrin.h>
+#endif
+#endif
+
+#ifndef SNDX_BLIT_SIMD
+#define SNDX_BLIT_SIMD 0
+#endif
+
+namespace sndx::render {
+
+	namespace detail {
+		// channels an image lacks are black with opaque alpha
+		[[nodiscard]]
+		constexpr std::byte fillChannel(size_t channel) noexcept {
+			return channel >= 3 ? std::byte(0xff) : std::byte(0x0);
+		}
+
+		inline void expandPixel(std::byte* dst, const std::byte* src, size_t srcChannels, size_t dstChannels) noexcept {
+			for (size_t c = 0; c < srcChannels; ++c) {
+				dst[c] = src[c];
+			}
+
+			for (size_t c = srcChannels; c < dstChannels; ++c) {
+				dst[c] = fillChannel(c);
+			}
+		}
+
+		inline void expandRow(std::byte* dst, const std::byte* src, size_t pixels, size_t srcChannels, size_t dstChannels) noexcept {
+			size_t i = 0;
+
+#if SNDX_BLIT_SIMD >= 1
+			if (srcChannels == 1 && dstChannels == 4) {
+				// widening v to v, 0 then v, 0 to v, 0, 0, 0xff
+				const auto zero = _mm_setzero_si128();
+				const auto alpha = _mm_set1_epi16(short(0xff00));
+
+				for (; i + 16 <= pixels; i += 16) {
+					auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+					auto lo = _mm_unpacklo_epi8(v, zero);
+					auto hi = _mm_unpackhi_epi8(v, zero);
+
+					auto out = reinterpret_cast<__m128i*>(dst + i * 4);
+					_mm_storeu_si128(out + 0, _mm_unpacklo_epi16(lo, alpha));
+					_mm_storeu_si128(out + 1, _mm_unpackhi_epi16(lo, alpha));
+					_mm_storeu_si128(out + 2, _mm_unpacklo_epi16(hi, alpha));
+					_mm_storeu_si128(out + 3, _mm_unpackhi_epi16(hi, alpha));
+				}
+			}
+#endif
+
+#if SNDX_BLIT_SIMD >= 2
+			if (srcChannels == 3 && dstChannels == 4) {
+				const auto shuffle = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+				const auto alpha = _mm_set1_epi32(int(0xff000000));
+
+				// each load reads 16 bytes but only uses 12, stop while the extra 4 are still in the row
+				for (; i + 6 <= pixels; i += 4) {
+					auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 3));
+					auto rgba = _mm_or_si128(_mm_shuffle_epi8(v, shuffle), alpha);
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), rgba);
+				}
+			}
+#endif
+
+			for (; i < pixels; ++i) {
+				expandPixel(dst + i * dstChannels, src + i * srcChannels, srcChannels, dstChannels);
+			}
+		}
+	}
+
+	// Copies img into dst, an image with dstChannels bytes per pixel and stride bytes per row.
+	// img's top left lands at offset, channels img lacks are filled in.
+	// transpose writes image rows down the columns of dst.
+	// bounds are checked once up front, the copy itself runs a row at a time
+	inline void blitImage(std::span<std::byte> dst, size_t offset, size_t stride, size_t dstChannels, const ImageData& img, bool transpose = false) {
+		size_t srcChannels = img.channels();
+		if (dstChannels < srcChannels)
+			throw std::invalid_argument("Cannot blit to an image with fewer channels");
+
+		if (img.pixels() == 0) [[unlikely]]
+			return;
+
+		auto rows = transpose ? img.width() : img.height();
+		auto cols = transpose ? img.height() : img.width();
+		if (cols * dstChannels > stride || offset + (rows - 1) * stride + cols * dstChannels > dst.size())
+			throw std::out_of_range("Blit runs outside of the destination");
+
+		const std::byte* src = img.data();
+		std::byte* out = dst.data() + offset;
+		size_t srcStride = img.width() * srcChannels;
+
+		if (transpose) {
+			for (size_t y = 0; y < img.height(); ++y) {
+				for (size_t x = 0; x < img.width(); ++x) {
+					detail::expandPixel(out + x * stride + y * dstChannels, src + y * srcStride + x * srcChannels, srcChannels, dstChannels);
+				}
+			}
+			return;
+		}
+
+		for (size_t y = 0; y < img.height(); ++y) {
+			if (srcChannels == dstChannels) {
+				std::memcpy(out + y * stride, src + y * srcStride, srcStride);
+			}
+			else {
+				detail::expandRow(out + y * stride, src + y * srcStride, img.width(), srcChannels, dstChannels);
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -130,6 +130,10 @@ namespace sndx::render {
 			return m_data.data();
 		}
 
+		[[nodiscard]] auto data() noexcept {
+			return m_data.data();
+		}
+
 		[[nodiscard]]
 		auto& at(size_t x, size_t y, size_t channel) {
 			if (x >= width() || y >= height() || channel >= channels())
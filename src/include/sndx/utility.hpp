@@ -1,6 +1,7 @@
 #pragma once
 
 #include "./utility/endian.hpp"
+#include "./utility/hash.hpp"
 #include "./utility/registry.hpp"
 #include "./utility/stream.hpp"
 
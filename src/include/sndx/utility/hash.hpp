@@ -0,0 +1,69 @@
+#pragma once
+
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string_view>
+
+#include "./endian.hpp"
+
+namespace sndx::utility {
+	// 64 bit hash that is the same on every platform and every run, unlike std::hash.
+	// meant for cache keys, not for security
+	class ContentHasher {
+	private:
+		uint64_t m_state;
+
+		static constexpr uint64_t multiplier = 0x9e3779b97f4a7c15;
+
+		constexpr void mix(uint64_t word) noexcept {
+			m_state = (std::rotl(m_state, 5) ^ word) * multiplier;
+		}
+
+	public:
+		explicit constexpr ContentHasher(uint64_t seed = 0xcbf29ce484222325) noexcept :
+			m_state(seed) {}
+
+		// a word at a time, the length goes in too so trailing zeros change the hash
+		ContentHasher& update(std::span<const std::byte> bytes) noexcept {
+			size_t i = 0;
+			for (; i + sizeof(uint64_t) <= bytes.size(); i += sizeof(uint64_t)) {
+				uint64_t word;
+				std::memcpy(&word, bytes.data() + i, sizeof(word));
+				mix(fromEndianess<std::endian::little>(word));
+			}
+
+			uint64_t tail = 0;
+			for (size_t shift = 0; i < bytes.size(); ++i, shift += 8) {
+				tail |= uint64_t(bytes[i]) << shift;
+			}
+			mix(tail);
+			mix(bytes.size());
+
+			return *this;
+		}
+
+		ContentHasher& update(std::string_view str) noexcept {
+			return update(std::as_bytes(std::span{ str }));
+		}
+
+		constexpr ContentHasher& update(std::integral auto value) noexcept {
+			mix(uint64_t(value));
+			return *this;
+		}
+
+		// murmur3's finalizer so every input bit reaches every output bit
+		[[nodiscard]]
+		constexpr uint64_t value() const noexcept {
+			auto h = m_state;
+			h ^= h >> 33;
+			h *= 0xff51afd7ed558ccd;
+			h ^= h >> 33;
+			h *= 0xc4ceb9fe1a85ec53;
+			h ^= h >> 33;
+			return h;
+		}
+	};
+}
\ No newline at end of file
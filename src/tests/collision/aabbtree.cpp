@@ -0,0 +1,298 @@
+#include "collision/aabbtree.hpp"
+#include "collision/circle.hpp"
+#include "collision/triangle.hpp"
+
+#include <gtest/gtest.h>
+
+#include "collision_helper.hpp"
+
+#include <algorithm>
+#include <random>
+#include <set>
+
+using namespace sndx::collision;
+
+namespace {
+	// picked up by kNearest without a distance function
+	struct Ball {
+		glm::vec3 pos{};
+		float radius = 0.0f;
+
+		[[nodiscard]]
+		float distance(const glm::vec3& point) const {
+			return Circle3D{ pos, radius }.distance(point);
+		}
+	};
+}
+
+TEST(AABBTree, emptyTree) {
+	AABBTree<size_t> tree{};
+
+	EXPECT_TRUE(tree.empty());
+	EXPECT_EQ(tree.getHeight(), 0);
+	EXPECT_TRUE(tree.getOverlappingPairs().empty());
+
+	size_t hits = 0;
+	tree.query(Rect3D{ glm::vec3(-1.0f), glm::vec3(1.0f) }, [&](auto) { ++hits; });
+	tree.raycast(glm::vec3(0.0f), glm::vec3(1.0f, 0.0f, 0.0f), [&](auto, float) { ++hits; });
+	EXPECT_EQ(hits, 0);
+}
+
+TEST(AABBTree, insertsShapesByBounds) {
+	AABBTree<int> tree{ 0.0f };
+
+	Circle3D circle{ glm::vec3(0.0f), 1.0f };
+	Capsule3D capsule{ glm::vec3(5.0f, 0.0f, 0.0f), glm::vec3(5.0f, 2.0f, 0.0f), 0.5f };
+	Tri3D tri{ glm::vec3(10.0f, 0.0f, 0.0f), glm::vec3(11.0f, 0.0f, 0.0f), glm::vec3(10.0f, 1.0f, 0.0f) };
+	OriRect3D obb{ glm::vec3(-5.0f, 0.0f, 0.0f), glm::vec3(1.0f), glm::quat(glm::vec3(0.0f, 0.7f, 0.0f)) };
+
+	auto c = tree.insert(circle, 0);
+	auto p = tree.insert(capsule, 1);
+	auto t = tree.insert(tri, 2);
+	auto o = tree.insert(obb, 3);
+
+	EXPECT_EQ(tree.size(), 4);
+	EXPECT_EQ(tree.getData(c), 0);
+	EXPECT_EQ(tree.getData(p), 1);
+	EXPECT_EQ(tree.getData(t), 2);
+	EXPECT_EQ(tree.getData(o), 3);
+
+	EXPECT_TRUE(tree.getFatBounds(c).contains(getBounds(circle)));
+	EXPECT_TRUE(tree.getFatBounds(o).contains(getBounds(obb)));
+
+	std::vector<int> found{};
+	tree.query(Rect3D{ glm::vec3(4.0f, -1.0f, -1.0f), glm::vec3(12.0f, 1.0f, 1.0f) }, [&](auto id) {
+		found.push_back(tree.getData(id));
+	});
+	std::sort(found.begin(), found.end());
+
+	EXPECT_EQ(found, (std::vector<int>{ 1, 2 }));
+}
+
+TEST(AABBTree, pairsMatchBruteForce) {
+	auto boxes = randomBoxes(500, 1337);
+
+	AABBTree<size_t> tree{ 0.0f };
+	std::vector<AABBTree<size_t>::NodeId> ids{};
+	for (size_t i = 0; i < boxes.size(); ++i) {
+		ids.push_back(tree.insert(boxes[i], i));
+	}
+
+	std::set<std::pair<size_t, size_t>> expected{};
+	for (size_t i = 0; i < boxes.size(); ++i) {
+		for (size_t j = i + 1; j < boxes.size(); ++j) {
+			if (boxes[i].overlaps(boxes[j])) {
+				expected.emplace(i, j);
+			}
+		}
+	}
+
+	std::set<std::pair<size_t, size_t>> actual{};
+	for (auto [a, b] : tree.getOverlappingPairs()) {
+		auto da = tree.getData(a);
+		auto db = tree.getData(b);
+		actual.emplace(std::min(da, db), std::max(da, db));
+	}
+
+	EXPECT_EQ(actual, expected);
+
+	// AVL balancing keeps the height logarithmic
+	EXPECT_LE(tree.getHeight(), 20);
+}
+
+TEST(AABBTree, moveAndRemove) {
+	AABBTree<size_t> tree{ 0.5f };
+
+	Rect3D a{ glm::vec3(0.0f), glm::vec3(1.0f) };
+	Rect3D b{ glm::vec3(10.0f), glm::vec3(11.0f) };
+
+	auto ia = tree.insert(a, 0);
+	auto ib = tree.insert(b, 1);
+	EXPECT_TRUE(tree.getOverlappingPairs().empty());
+
+	// small moves stay inside the fat bounds
+	EXPECT_FALSE(tree.move(ia, Rect3D{ glm::vec3(0.1f), glm::vec3(1.1f) }));
+
+	EXPECT_TRUE(tree.move(ia, Rect3D{ glm::vec3(9.5f), glm::vec3(10.5f) }));
+	auto pairs = tree.getOverlappingPairs();
+	ASSERT_EQ(pairs.size(), 1);
+
+	tree.remove(ib);
+	EXPECT_EQ(tree.size(), 1);
+	EXPECT_TRUE(tree.getOverlappingPairs().empty());
+	EXPECT_THROW(tree.remove(ib), std::invalid_argument);
+
+	// freed nodes get reused
+	auto ic = tree.insert(b, 2);
+	EXPECT_EQ(tree.getData(ic), 2);
+	EXPECT_EQ(tree.getOverlappingPairs().size(), 1);
+}
+
+TEST(AABBTree, raycastFindsClosest) {
+	AABBTree<size_t> tree{ 0.0f };
+
+	for (size_t i = 0; i < 10; ++i) {
+		auto x = float(i) * 3.0f + 2.0f;
+		tree.insert(Rect3D{ glm::vec3(x, -1.0f, -1.0f), glm::vec3(x + 1.0f, 1.0f, 1.0f) }, i);
+	}
+	tree.insert(Rect3D{ glm::vec3(0.0f, 5.0f, 0.0f), glm::vec3(1.0f, 6.0f, 1.0f) }, 100);
+
+	size_t hits = 0;
+	tree.raycast(glm::vec3(0.0f), glm::vec3(1.0f, 0.0f, 0.0f), [&](auto, float) { ++hits; });
+	EXPECT_EQ(hits, 10);
+
+	size_t closest = 1000;
+	float closestDist = std::numeric_limits<float>::max();
+	tree.raycast(glm::vec3(0.0f), glm::vec3(1.0f, 0.0f, 0.0f), [&](auto id, float dist) {
+		if (dist < closestDist) {
+			closestDist = dist;
+			closest = tree.getData(id);
+		}
+		return dist;
+	});
+
+	EXPECT_EQ(closest, 0);
+	EXPECT_FLOAT_EQ(closestDist, 2.0f);
+
+	// rays don't hit things behind them
+	hits = 0;
+	tree.raycast(glm::vec3(0.0f), glm::vec3(-1.0f, 0.0f, 0.0f), [&](auto, float) { ++hits; });
+	EXPECT_EQ(hits, 0);
+}
+
+TEST(AABBTree, kNearestMatchesBruteForce) {
+	std::mt19937 gen{ 21 };
+	std::uniform_real_distribution<float> pos{ -20.0f, 20.0f };
+	std::uniform_real_distribution<float> size{ 0.1f, 2.0f };
+
+	AABBTree<Ball> tree{ 0.2f };
+	std::vector<AABBTree<Ball>::NodeId> leaves{};
+	for (size_t i = 0; i < 500; ++i) {
+		Ball ball{ glm::vec3{ pos(gen), pos(gen), pos(gen) }, size(gen) };
+		leaves.push_back(tree.insert(getBounds(Circle3D{ ball.pos, ball.radius }), ball));
+	}
+
+	for (int q = 0; q < 50; ++q) {
+		glm::vec3 point{ pos(gen), pos(gen), pos(gen) };
+
+		std::vector<float> expected{};
+		for (auto leaf : leaves) {
+			expected.push_back(tree.getData(leaf).distance(point));
+		}
+		std::sort(expected.begin(), expected.end());
+
+		auto res = tree.kNearest(point, 8);
+		ASSERT_EQ(res.size(), 8);
+		for (size_t i = 0; i < res.size(); ++i) {
+			EXPECT_FLOAT_EQ(res[i].second, expected[i]) << q;
+			EXPECT_FLOAT_EQ(tree.getData(res[i].first).distance(point), res[i].second);
+		}
+
+		auto one = tree.nearest(point);
+		ASSERT_TRUE(one.has_value());
+		EXPECT_FLOAT_EQ(one->second, expected.front());
+
+		// only what is within maxDist
+		auto limit = expected[3];
+		auto limited = tree.kNearest(point, 8, limit);
+		EXPECT_EQ(limited.size(), size_t(std::upper_bound(expected.begin(), expected.end(), limit) - expected.begin()));
+	}
+
+	EXPECT_TRUE(tree.kNearest(glm::vec3(0.0f), 0).empty());
+	EXPECT_FALSE(tree.nearest(glm::vec3(100.0f), 1.0f).has_value());
+	EXPECT_EQ(tree.kNearest(glm::vec3(0.0f), 1000).size(), leaves.size());
+}
+
+TEST(AABBTree, kNearestExactDistanceAndBatches) {
+	std::mt19937 gen{ 22 };
+	std::uniform_real_distribution<float> pos{ -15.0f, 15.0f };
+	std::uniform_real_distribution<float> size{ -2.0f, 2.0f };
+
+	std::vector<Tri3D> tris{};
+	AABBTree<size_t> tree{ 0.1f };
+	for (size_t i = 0; i < 300; ++i) {
+		glm::vec3 p{ pos(gen), pos(gen), pos(gen) };
+		tris.emplace_back(p, p + glm::vec3{ size(gen), size(gen), size(gen) }, p + glm::vec3{ size(gen), size(gen), size(gen) });
+		tree.insert(getBounds(tris.back()), i);
+	}
+
+	auto dist = [&](AABBTree<size_t>::NodeId id, const glm::vec3& point) {
+		return tris[tree.getData(id)].distance(point);
+	};
+
+	std::vector<glm::vec3> points{};
+	for (int q = 0; q < 64; ++q) {
+		points.emplace_back(pos(gen), pos(gen), pos(gen));
+	}
+
+	std::vector<std::vector<AABBTree<size_t>::Neighbour>> batch{};
+	tree.kNearest(points, 4, dist, batch);
+	ASSERT_EQ(batch.size(), points.size());
+
+	for (size_t q = 0; q < points.size(); ++q) {
+		std::vector<float> expected{};
+		for (const auto& tri : tris) {
+			expected.push_back(tri.distance(points[q]));
+		}
+		std::sort(expected.begin(), expected.end());
+
+		auto single = tree.kNearest(points[q], 4, [&](auto id) { return dist(id, points[q]); });
+		ASSERT_EQ(single.size(), 4);
+		EXPECT_EQ(batch[q], single) << q;
+
+		for (size_t i = 0; i < single.size(); ++i) {
+			EXPECT_FLOAT_EQ(single[i].second, expected[i]) << q;
+		}
+	}
+}
+
+TEST(AABBTree, treePairsMatchBruteForce) {
+	auto dynamicBoxes = randomBoxes(1500, 31);
+	auto staticBoxes = randomBoxes(2500, 32);
+
+	AABBTree<size_t> dynamicTree{ 0.1f };
+	AABBTree<int> staticTree{ 0.0f };
+	std::vector<AABBTree<size_t>::NodeId> dynamicLeaves{}, staticLeaves{};
+
+	for (size_t i = 0; i < dynamicBoxes.size(); ++i) {
+		dynamicLeaves.push_back(dynamicTree.insert(dynamicBoxes[i], i));
+	}
+	for (size_t i = 0; i < staticBoxes.size(); ++i) {
+		staticLeaves.push_back(staticTree.insert(staticBoxes[i], int(i)));
+	}
+
+	using Pair = std::pair<AABBTree<size_t>::NodeId, AABBTree<size_t>::NodeId>;
+	std::vector<Pair> expected{};
+	for (auto a : dynamicLeaves) {
+		for (auto b : staticLeaves) {
+			if (dynamicTree.getFatBounds(a).overlaps(staticTree.getFatBounds(b))) {
+				expected.emplace_back(a, b);
+			}
+		}
+	}
+	std::sort(expected.begin(), expected.end());
+	ASSERT_GT(expected.size(), 100);
+
+	std::vector<Pair> serial{};
+	dynamicTree.queryPairs(staticTree, [&](auto a, auto b) {
+		serial.emplace_back(a, b);
+	});
+	std::sort(serial.begin(), serial.end());
+	EXPECT_EQ(serial, expected);
+
+	// from everything serial to one task per overlapping leaf pair
+	for (uint32_t depth : { 0u, 3u, 8u, 64u }) {
+		auto res = dynamicTree.getOverlappingPairs(staticTree, depth);
+		std::sort(res.begin(), res.end());
+		EXPECT_EQ(res, expected) << depth;
+	}
+
+	size_t calls = 0;
+	dynamicTree.queryPairs(staticTree, [&](auto, auto) {
+		++calls;
+		return false;
+	});
+	EXPECT_EQ(calls, 1);
+
+	EXPECT_TRUE(dynamicTree.getOverlappingPairs(AABBTree<int>{}).empty());
+}
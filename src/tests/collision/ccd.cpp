@@ -0,0 +1,87 @@
+#include "collision/ccd.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace sndx::collision;
+
+TEST(CCD, fastSphereHitsThinTriangle) {
+	Circle3D sphere{ glm::vec3(0.0f), 0.1f };
+	Tri3D tri{ glm::vec3(-5.0f, -5.0f, 0.0f), glm::vec3(5.0f, -5.0f, 0.0f), glm::vec3(0.0f, 5.0f, 0.0f) };
+
+	TransformIsotropic a0{ glm::vec3(0.0f, 0.0f, -5.0f) };
+	TransformIsotropic a1{ glm::vec3(0.0f, 0.0f, 5.0f) };
+	TransformIsotropic fixed{};
+
+	// the discrete test misses it entirely at both ends of the step
+	ASSERT_FALSE(getCollision(transform(sphere, a0), tri));
+	ASSERT_FALSE(getCollision(transform(sphere, a1), tri));
+
+	auto res = timeOfImpact(sphere, a0, a1, tri, fixed, fixed);
+	ASSERT_TRUE(res.has_value());
+
+	EXPECT_NEAR(res->toi, 4.9f / 10.0f, 0.001f);
+	EXPECT_NEAR(res->normal.z, 1.0f, 0.001f);
+	EXPECT_NEAR(res->point.z, -0.005f, 0.01f);
+	EXPECT_GT(res->iterations, 0);
+}
+
+TEST(CCD, rotatingCapsuleHitsThinBox) {
+	Capsule3D capsule{ glm::vec3(0.0f, -1.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f), 0.05f };
+	OriRect3D wall{ glm::vec3(3.0f, 0.0f, 0.0f), glm::vec3(0.01f, 2.0f, 2.0f), glm::quat(glm::vec3(0.0f, 0.2f, 0.0f)) };
+
+	TransformIsotropic a0{ glm::vec3(0.0f) };
+	TransformIsotropic a1{ glm::vec3(6.0f, 0.0f, 0.0f), glm::quat(glm::vec3(0.0f, 0.0f, 1.5f)) };
+	TransformIsotropic fixed{};
+
+	auto res = timeOfImpact(capsule, a0, a1, wall, fixed, fixed);
+	ASSERT_TRUE(res.has_value());
+	EXPECT_GT(res->toi, 0.0f);
+	EXPECT_LT(res->toi, 0.5f);
+
+	// conservative, so not overlapping yet at the toi
+	auto at = detail::lerpTransform(a0, a1, res->toi);
+	EXPECT_FALSE(gjk(detail::supportAt(capsule, at), getSupportFn(wall)));
+
+	// but touching shortly after
+	at = detail::lerpTransform(a0, a1, res->toi + 0.01f);
+	EXPECT_TRUE(gjk(detail::supportAt(capsule, at), getSupportFn(wall)));
+}
+
+TEST(CCD, missesAndInitialOverlap) {
+	Circle3D sphere{ glm::vec3(0.0f), 0.5f };
+	Rect3D box{ glm::vec3(-1.0f), glm::vec3(1.0f) };
+
+	Transform fixed{};
+
+	// moving away
+	EXPECT_FALSE(timeOfImpact(sphere, Transform{ glm::vec3(3.0f, 0.0f, 0.0f) }, Transform{ glm::vec3(6.0f, 0.0f, 0.0f) }, box, fixed, fixed));
+
+	// passing by
+	EXPECT_FALSE(timeOfImpact(sphere, Transform{ glm::vec3(-5.0f, 3.0f, 0.0f) }, Transform{ glm::vec3(5.0f, 3.0f, 0.0f) }, box, fixed, fixed));
+
+	auto res = timeOfImpact(sphere, Transform{ glm::vec3(1.2f, 0.0f, 0.0f) }, Transform{ glm::vec3(5.0f, 0.0f, 0.0f) }, box, fixed, fixed);
+	ASSERT_TRUE(res.has_value());
+	EXPECT_EQ(res->toi, 0.0f);
+	// a is to the right of b, so a towards b is -x
+	EXPECT_NEAR(res->normal.x, -1.0f, 0.01f);
+}
+
+TEST(CCD, growingShapeDoesNotTunnel) {
+	Circle3D sphere{ glm::vec3(0.0f), 0.5f };
+	Tri3D tri{ glm::vec3(-5.0f, -5.0f, 0.0f), glm::vec3(5.0f, -5.0f, 0.0f), glm::vec3(0.0f, 5.0f, 0.0f) };
+
+	// only the scale changes, the sphere grows through the triangle
+	TransformIsotropic a0{ glm::vec3(0.0f, 0.0f, -2.0f), glm::quat(glm::vec3(0.0f)), 1.0f };
+	TransformIsotropic a1{ glm::vec3(0.0f, 0.0f, -2.0f), glm::quat(glm::vec3(0.0f)), 10.0f };
+	TransformIsotropic fixed{};
+
+	auto res = timeOfImpact(sphere, a0, a1, tri, fixed, fixed);
+	ASSERT_TRUE(res.has_value());
+
+	// radius 4 reaches the triangle, scale 1 + 9t = 4
+	EXPECT_NEAR(res->toi, 1.0f / 3.0f, 0.01f);
+	EXPECT_NEAR(res->normal.z, 1.0f, 0.001f);
+
+	auto at = detail::lerpTransform(a0, a1, res->toi);
+	EXPECT_FALSE(gjk(detail::supportAt(sphere, at), getSupportFn(tri)));
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "collision/narrowphase.hpp"
+
+#include <random>
+#include <vector>
+
+namespace sndx::collision {
+
+	// boxes with their min corner within extent of the origin on each axis
+	[[nodiscard]]
+	inline std::vector<Rect3D> randomBoxes(size_t count, unsigned seed, float extent = 20.0f, float minSize = 0.1f, float maxSize = 2.0f) {
+		std::mt19937 gen{ seed };
+		std::uniform_real_distribution<float> pos{ -extent, extent };
+		std::uniform_real_distribution<float> size{ minSize, maxSize };
+
+		std::vector<Rect3D> out{};
+		out.reserve(count);
+		for (size_t i = 0; i < count; ++i) {
+			glm::vec3 p{ pos(gen), pos(gen), pos(gen) };
+			out.emplace_back(p, p + glm::vec3{ size(gen), size(gen), size(gen) });
+		}
+		return out;
+	}
+
+	// cycles through every Shape3D alternative, positions are within extent of the origin on each axis
+	[[nodiscard]]
+	inline std::vector<Shape3D> randomShapes(size_t count, unsigned seed, float extent = 3.0f) {
+		std::mt19937 gen{ seed };
+		std::uniform_real_distribution<float> pos{ -extent, extent };
+		std::uniform_real_distribution<float> size{ 0.3f, 1.5f };
+		std::uniform_real_distribution<float> angle{ -3.0f, 3.0f };
+
+		std::vector<Shape3D> out{};
+		out.reserve(count);
+		for (size_t i = 0; i < count; ++i) {
+			glm::vec3 p{ pos(gen), pos(gen), pos(gen) };
+			switch (i % 5) {
+			case 0:
+				out.emplace_back(Circle3D{ p, size(gen) });
+				break;
+			case 1:
+				out.emplace_back(Capsule3D{ p, p + glm::vec3{ size(gen), size(gen), 0.0f }, size(gen) * 0.5f });
+				break;
+			case 2:
+				out.emplace_back(Rect3D{ p, p + glm::vec3{ size(gen), size(gen), size(gen) } });
+				break;
+			case 3:
+				out.emplace_back(OriRect3D{ p, glm::vec3{ size(gen), size(gen), size(gen) }, glm::quat(glm::vec3{ angle(gen), angle(gen), angle(gen) }) });
+				break;
+			default:
+				out.emplace_back(Tri3D{ p, p + glm::vec3{ size(gen), 0.0f, 0.0f }, p + glm::vec3{ 0.0f, size(gen), size(gen) } });
+				break;
+			}
+		}
+		return out;
+	}
+}
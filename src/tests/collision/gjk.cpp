@@ -1,9 +1,12 @@
 #include "collision/gjk.hpp"
 #include "collision/rect.hpp"
 #include "collision/circle.hpp"
+#include "collision/collision.hpp"
 
 #include <gtest/gtest.h>
 
+#include <random>
+
 using namespace sndx::collision;
 
 TEST(GJK, simpleBoxesCollide) {
@@ -296,4 +299,145 @@ TEST(EPA, mixedShapesGiveCorrectDirection2) {
 
 	result = epa(*simplex, sptB, sptA);
 	EXPECT_LE(result.depth, 0.004f);
+}
+
+TEST(EPA, arenaDoesNotAllocate) {
+	EpaArena arena{};
+
+	Circle3D circle{ glm::vec3{ 0.3f, 0.2f, 0.1f }, 1.0f };
+	Rect3D box{ glm::vec3{ 0.5f, -0.5f, -0.7f }, glm::vec3{ 1.5f, 0.9f, 0.6f } };
+
+	auto sptA = getSupportFn(circle);
+	auto sptB = getSupportFn(box);
+
+	auto simplex = gjk(sptA, sptB);
+	ASSERT_TRUE(simplex);
+
+	auto expected = epa(*simplex, sptA, sptB);
+
+	for (size_t i = 0; i < 10; ++i) {
+		auto result = epa(*simplex, sptA, sptB, arena);
+		EXPECT_EQ(result.depth, expected.depth);
+		EXPECT_EQ(result.normal, expected.normal);
+	}
+
+	const auto& stats = arena.getStats();
+	EXPECT_EQ(stats.calls, 10);
+	EXPECT_GT(stats.lastIterations, 0);
+	EXPECT_EQ(stats.iterations, stats.lastIterations * 10);
+	EXPECT_EQ(stats.allocations, 0);
+	EXPECT_FALSE(arena.spilled());
+
+	arena.resetStats();
+	EXPECT_EQ(arena.getStats().calls, 0);
+}
+
+
+TEST(GJK2D, matchesAnalyticTests) {
+	std::mt19937 gen{ 18 };
+	std::uniform_real_distribution<float> pos{ -2.0f, 2.0f };
+	std::uniform_real_distribution<float> size{ 0.2f, 1.5f };
+
+	size_t hits = 0, misses = 0;
+	for (int i = 0; i < 2000; ++i) {
+		Circle2D circle{ glm::vec2{ pos(gen), pos(gen) }, size(gen) };
+		glm::vec2 p{ pos(gen), pos(gen) };
+		Rect2D box{ p, p + glm::vec2{ size(gen), size(gen) } };
+		Circle2D other{ glm::vec2{ pos(gen), pos(gen) }, size(gen) };
+
+		// too close to call either way
+		auto gap = glm::distance(circle.getCenter(), other.getCenter()) - circle.getRadius() - other.getRadius();
+		if (std::abs(gap) > 0.0001f) {
+			auto res = gjk2D(getSupportFn(circle), getSupportFn(other));
+			EXPECT_EQ(res.has_value(), gap < 0.0f) << i;
+		}
+
+		auto boxGap = box.distance(circle.getCenter()) - circle.getRadius();
+		if (std::abs(boxGap) > 0.0001f) {
+			bool hit = boxGap < 0.0f;
+			EXPECT_EQ(hasCollision(getSupportFn(circle), getSupportFn(box)), hit) << i;
+			EXPECT_EQ(hasCollision(getSupportFn(box), getSupportFn(circle)), hit) << i;
+			hits += hit;
+			misses += !hit;
+		}
+	}
+	EXPECT_GT(hits, 100);
+	EXPECT_GT(misses, 100);
+}
+
+TEST(EPA2D, matchesAnalyticDepth) {
+	std::mt19937 gen{ 19 };
+	std::uniform_real_distribution<float> pos{ -1.0f, 1.0f };
+	std::uniform_real_distribution<float> size{ 0.3f, 1.5f };
+
+	auto check = [](const auto& a, const auto& b, float tolerance) {
+		auto expected = getCollision(a, b);
+		auto res = getCollision(getSupportFn(a), getSupportFn(b));
+		static_assert(std::is_same_v<decltype(res), std::optional<Collision2D>>);
+
+		if (!expected || expected->depth < 0.001f)
+			return size_t(0);
+
+		EXPECT_TRUE(res.has_value());
+		if (res) {
+			EXPECT_NEAR(res->depth, expected->depth, tolerance);
+			EXPECT_GT(glm::dot(res->normal, expected->normal), 0.99f);
+
+			// moving a out along the normal separates them
+			auto ra = a;
+			ra.translate(-res->normal * (res->depth + 0.001f));
+			EXPECT_FALSE(hasCollision(getSupportFn(ra), getSupportFn(b)));
+		}
+		return size_t(1);
+	};
+
+	size_t checked = 0;
+	for (int i = 0; i < 500; ++i) {
+		Circle2D a{ glm::vec2{ pos(gen), pos(gen) }, size(gen) };
+		Circle2D b{ glm::vec2{ pos(gen), pos(gen) }, size(gen) };
+		glm::vec2 p{ pos(gen), pos(gen) };
+		Rect2D boxA{ p, p + glm::vec2{ size(gen), size(gen) } };
+		p = glm::vec2{ pos(gen), pos(gen) };
+		Rect2D boxB{ p, p + glm::vec2{ size(gen), size(gen) } };
+		p = glm::vec2{ pos(gen), pos(gen) };
+		Capsule2D capsule{ p, p + glm::vec2{ size(gen), pos(gen) }, size(gen) * 0.5f };
+
+		checked += check(a, b, 0.002f);
+		checked += check(capsule, a, 0.002f);
+
+		// the analytic test reports the overlap, not how far to push when one box spans the other
+		auto push = glm::min(boxA.getP2() - boxB.getP1(), boxB.getP2() - boxA.getP1());
+		auto boxes = getCollision(getSupportFn(boxA), getSupportFn(boxB));
+		if (push.x > 0.001f && push.y > 0.001f) {
+			ASSERT_TRUE(boxes.has_value()) << i;
+			EXPECT_NEAR(boxes->depth, std::min(push.x, push.y), 0.0001f) << i;
+			++checked;
+		}
+	}
+	EXPECT_GT(checked, 500);
+}
+
+TEST(EPA2D, handlesTouchingAndAlignedShapes) {
+	// the origin lands exactly on gjk's simplex
+	Circle2D circleA{ glm::vec2{ -1.0f, 0.0f }, 1.0f };
+	Circle2D circleB{ glm::vec2{ -2.0f, 0.0f }, 0.5f };
+
+	auto res = getCollision(getSupportFn(circleA), getSupportFn(circleB));
+	ASSERT_TRUE(res.has_value());
+	EXPECT_NEAR(res->depth, 0.5f, 0.002f);
+	EXPECT_NEAR(std::abs(res->normal.x), 1.0f, 0.001f);
+
+	Rect2D boxA{ glm::vec2{ 0.0f }, glm::vec2{ 1.0f } };
+	Rect2D boxB{ glm::vec2{ 1.0f, 0.0f }, glm::vec2{ 2.0f, 1.0f } };
+
+	res = getCollision(getSupportFn(boxA), getSupportFn(boxB));
+	if (res) {
+		EXPECT_NEAR(res->depth, 0.0f, 0.001f);
+		EXPECT_FALSE(std::isnan(res->normal.x));
+	}
+
+	// 3d support functions still get 3d results
+	Circle3D sphere{ glm::vec3{ 0.0f }, 1.0f };
+	auto res3D = getCollision(getSupportFn(sphere), getSupportFn(sphere));
+	static_assert(std::is_same_v<decltype(res3D), std::optional<Collision3D>>);
 }
\ No newline at end of file
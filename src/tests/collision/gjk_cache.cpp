@@ -0,0 +1,186 @@
+#include "collision/gjk_cache.hpp"
+#include "collision/collision.hpp"
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+using namespace sndx::collision;
+
+TEST(GjkCache, warmStartMatchesAndSavesWork) {
+	std::mt19937 gen{ 3 };
+	std::uniform_real_distribution<float> jitter{ -0.005f, 0.005f };
+	std::uniform_real_distribution<float> spread{ -0.3f, 0.3f };
+
+	// a stack of boxes resting just above each other
+	std::vector<glm::vec3> base{};
+	for (size_t i = 0; i < 20; ++i) {
+		base.emplace_back(spread(gen), float(i) * 2.02f, spread(gen));
+	}
+
+	GjkCache warm{};
+	GjkCache cold{};
+
+	for (size_t frame = 0; frame < 30; ++frame) {
+		std::vector<OriRect3D> boxes{};
+		for (const auto& p : base) {
+			glm::vec3 j{ jitter(gen), jitter(gen), jitter(gen) };
+			boxes.emplace_back(p + j, glm::vec3(1.0f), glm::quat(j));
+		}
+
+		for (uint32_t i = 0; i + 1 < boxes.size(); ++i) {
+			auto sptA = getSupportFn(boxes[i]);
+			auto sptB = getSupportFn(boxes[i + 1]);
+
+			auto res = warm.query(i, i + 1, sptA, sptB);
+			EXPECT_EQ(bool(res), hasCollision(boxes[i], boxes[i + 1]));
+
+			(void)cold.query(i, i + 1, sptA, sptB);
+		}
+
+		warm.nextFrame();
+		cold.clear();
+	}
+
+	const auto& stats = warm.getStats();
+	EXPECT_EQ(stats.queries, 30 * 19);
+	EXPECT_GT(stats.hitRate(), 0.9);
+	EXPECT_GT(stats.earlyOuts, 0);
+	EXPECT_EQ(cold.getStats().hits, 0);
+
+	EXPECT_LT(stats.averageSupports() * 2.0, cold.getStats().averageSupports());
+}
+
+TEST(GjkCache, restingContactSavesWork) {
+	std::mt19937 gen{ 5 };
+	std::uniform_real_distribution<float> jitter{ -0.001f, 0.001f };
+	std::uniform_real_distribution<float> spread{ -0.3f, 0.3f };
+
+	// a settled stack, every box sinks into the one below by the solver's slop
+	std::vector<glm::vec3> base{};
+	for (size_t i = 0; i < 20; ++i) {
+		base.emplace_back(spread(gen), float(i) * 1.99f, spread(gen));
+	}
+
+	GjkCache warm{};
+	GjkCache cold{};
+
+	for (size_t frame = 0; frame < 30; ++frame) {
+		std::vector<OriRect3D> boxes{};
+		for (const auto& p : base) {
+			glm::vec3 j{ jitter(gen), jitter(gen), jitter(gen) };
+			boxes.emplace_back(p + j, glm::vec3(1.0f), glm::quat(j));
+		}
+
+		for (uint32_t i = 0; i + 1 < boxes.size(); ++i) {
+			auto sptA = getSupportFn(boxes[i]);
+			auto sptB = getSupportFn(boxes[i + 1]);
+
+			auto res = warm.query(i, i + 1, sptA, sptB);
+			ASSERT_TRUE(res.has_value());
+			EXPECT_EQ(res->size, 4);
+
+			// the reused simplex must still be usable by epa
+			auto depth = epa(*res, sptA, sptB).depth;
+			EXPECT_NEAR(depth, 0.01f, 0.005f);
+
+			(void)cold.query(i, i + 1, sptA, sptB);
+		}
+
+		warm.nextFrame();
+		cold.clear();
+	}
+
+	const auto& stats = warm.getStats();
+	EXPECT_GT(stats.hitRate(), 0.9);
+	EXPECT_EQ(stats.earlyOuts, 0);
+
+	// four supports is the least a hit can cost
+	EXPECT_LT(stats.averageSupports(), 4.1);
+	EXPECT_LT(stats.averageSupports(), cold.getStats().averageSupports());
+}
+
+TEST(GjkCache, eviction) {
+	GjkCache cache{};
+
+	Circle3D a{ glm::vec3(0.0f), 1.0f };
+	Circle3D b{ glm::vec3(5.0f, 0.0f, 0.0f), 1.0f };
+	Circle3D c{ glm::vec3(-5.0f, 0.0f, 0.0f), 1.0f };
+
+	EXPECT_FALSE(cache.query(0, 1, getSupportFn(a), getSupportFn(b)));
+	EXPECT_FALSE(cache.query(0, 2, getSupportFn(a), getSupportFn(c)));
+	EXPECT_FALSE(cache.query(1, 2, getSupportFn(b), getSupportFn(c)));
+	EXPECT_EQ(cache.size(), 3);
+
+	cache.evict(0, 1);
+	EXPECT_FALSE(cache.contains(0, 1));
+	EXPECT_EQ(cache.size(), 2);
+
+	cache.evictId(2);
+	EXPECT_EQ(cache.size(), 0);
+
+	EXPECT_FALSE(cache.query(0, 1, getSupportFn(a), getSupportFn(b)));
+	cache.nextFrame();
+	cache.nextFrame();
+	EXPECT_FALSE(cache.query(1, 2, getSupportFn(b), getSupportFn(c)));
+
+	cache.evictStale(1);
+	EXPECT_FALSE(cache.contains(0, 1));
+	EXPECT_TRUE(cache.contains(1, 2));
+}
+
+TEST(GjkCache, reusedFaceKeepsGjkWinding) {
+	auto corner = [](glm::vec3 p) {
+		return detail::MinkowskiDiff{ p, glm::vec3(0.0f), p };
+	};
+
+	// the origin is above the z = -1 face, whose winding faces down as given
+	SimplexGJK simplex{ { corner({ -1.0f, -1.0f, -1.0f }), corner({ 0.0f, 1.0f, -1.0f }), corner({ 1.0f, -1.0f, -1.0f }), corner({ 0.0f, 0.0f, -3.0f }) }, 4 };
+
+	glm::vec3 dir{};
+	ASSERT_FALSE(detail::tetrahedronContainsOrigin(simplex, dir));
+	ASSERT_EQ(simplex.size, 3);
+	EXPECT_NEAR(dir.z, 1.0f, 0.0001f);
+	EXPECT_GT(glm::dot(glm::cross(simplex.points[1].out - simplex.points[0].out, simplex.points[2].out - simplex.points[0].out), dir), 0.0f);
+
+	// the shapes moved apart, the first new support already proves it
+	auto apart = [](glm::vec3) { return glm::vec3(0.0f, 0.0f, -0.5f); };
+	auto origin = [](glm::vec3) { return glm::vec3(0.0f); };
+
+	uint32_t supports = 0;
+	glm::vec3 lastDir{};
+	EXPECT_FALSE(detail::gjkFrom(apart, origin, simplex, dir, 32, supports, lastDir));
+	EXPECT_EQ(supports, 1);
+}
+
+TEST(GjkCache, warmMatchesColdAsPairsSeparate) {
+	std::mt19937 gen{ 11 };
+	std::uniform_real_distribution<float> angle{ -3.0f, 3.0f };
+	std::uniform_real_distribution<float> dir{ -1.0f, 1.0f };
+	std::uniform_real_distribution<float> gap{ -0.5f, 0.5f };
+
+	size_t flips = 0;
+	for (size_t pair = 0; pair < 200; ++pair) {
+		OriRect3D a{ glm::vec3(0.0f), glm::vec3(1.0f, 0.5f, 0.8f), glm::quat(glm::vec3{ angle(gen), angle(gen), angle(gen) }) };
+		auto rot = glm::quat(glm::vec3{ angle(gen), angle(gen), angle(gen) });
+		auto side = glm::normalize(glm::vec3{ dir(gen), dir(gen), dir(gen) });
+
+		GjkWarmStart warm{};
+		bool last = false;
+
+		// the pair keeps crossing between touching and apart
+		for (size_t step = 0; step < 20; ++step) {
+			OriRect3D b{ side * (1.5f + gap(gen)), glm::vec3(0.7f, 0.6f, 0.5f), rot };
+
+			GjkWarmStart cold{};
+			auto expected = gjk(getSupportFn(a), getSupportFn(b), cold);
+			auto actual = gjk(getSupportFn(a), getSupportFn(b), warm);
+
+			ASSERT_EQ(bool(actual), bool(expected)) << pair << " " << step;
+			flips += step > 0 && bool(expected) != last;
+			last = bool(expected);
+		}
+	}
+
+	EXPECT_GT(flips, 500);
+}
@@ -0,0 +1,225 @@
+#include "collision/heightfield.hpp"
+#include "collision/trimesh.hpp"
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+using namespace sndx::collision;
+
+namespace {
+	constexpr uint32_t width = 97;
+	constexpr uint32_t depth = 65;
+	const glm::vec3 origin{ -20.0f, -1.0f, -10.0f };
+	const glm::vec2 cellSize{ 0.5f, 0.4f };
+
+	std::vector<float> makeHeights() {
+		std::vector<float> out{};
+		for (uint32_t z = 0; z < depth; ++z) {
+			for (uint32_t x = 0; x < width; ++x) {
+				out.push_back(2.0f * std::sin(float(x) * 0.15f) * std::cos(float(z) * 0.2f) + 0.3f * std::sin(float(x * z) * 0.05f));
+			}
+		}
+		return out;
+	}
+
+	HeightField<> makeField() {
+		return HeightField<>{ width, depth, makeHeights(), origin, cellSize };
+	}
+
+	// the same triangles in index order, the reference for every query
+	template <class HeightT>
+	TriangleMesh makeMesh(const HeightField<HeightT>& field) {
+		std::vector<Tri3D> tris{};
+		for (uint32_t i = 0; i < field.triCount(); ++i) {
+			tris.push_back(field.getTri(i));
+		}
+		return TriangleMesh{ tris };
+	}
+
+	float closestDistance(const TriangleMesh& mesh, const glm::vec3& point) {
+		auto best = std::numeric_limits<float>::max();
+		for (uint32_t i = 0; i < mesh.size(); ++i) {
+			best = std::min(best, mesh.getTri(i).distance(point));
+		}
+		return best;
+	}
+}
+
+TEST(HeightField, boundsAndSamples) {
+	auto heights = makeHeights();
+	auto field = makeField();
+
+	auto [lo, hi] = std::minmax_element(heights.begin(), heights.end());
+	auto bounds = field.getBounds();
+	EXPECT_EQ(bounds.getP1(), glm::vec3(origin.x, origin.y + *lo, origin.z));
+	EXPECT_FLOAT_EQ(bounds.getP2().x, origin.x + float(width - 1) * cellSize.x);
+	EXPECT_FLOAT_EQ(bounds.getP2().y, origin.y + *hi);
+	EXPECT_FLOAT_EQ(bounds.getP2().z, origin.z + float(depth - 1) * cellSize.y);
+
+	// 96 x 64 cells needs 7 levels to reach a single node
+	EXPECT_EQ(field.getLevelCount(), 7);
+	EXPECT_EQ(field.triCount(), 96 * 64 * 2);
+
+	EXPECT_FLOAT_EQ(*field.heightAt(origin.x + 3.0f * cellSize.x, origin.z + 5.0f * cellSize.y), origin.y + heights[5 * width + 3]);
+	EXPECT_FALSE(field.heightAt(origin.x - 1.0f, 0.0f).has_value());
+
+	// heightAt lies on the triangles
+	auto ray = field.raycast(glm::vec3(1.3f, 20.0f, 2.7f), glm::vec3(0.0f, -1.0f, 0.0f));
+	ASSERT_TRUE(ray.hit());
+	EXPECT_NEAR(20.0f - ray.dist, *field.heightAt(1.3f, 2.7f), 1e-4f);
+	EXPECT_GT(ray.norm.y, 0.0f);
+}
+
+TEST(HeightField, raycastMatchesMesh) {
+	auto field = makeField();
+	auto mesh = makeMesh(field);
+
+	std::mt19937 gen{ 9 };
+	std::uniform_real_distribution<float> pos{ -25.0f, 25.0f };
+	std::uniform_real_distribution<float> height{ -4.0f, 8.0f };
+	std::uniform_real_distribution<float> unit{ -1.0f, 1.0f };
+
+	size_t hits = 0;
+	for (int i = 0; i < 2000; ++i) {
+		glm::vec3 from{ pos(gen), height(gen), pos(gen) };
+		glm::vec3 dir{ unit(gen), unit(gen) * 0.5f, unit(gen) };
+
+		// axis aligned rays walk along cell edges
+		if (i % 10 == 0) dir.x = 0.0f;
+		if (i % 10 == 1) dir.z = 0.0f;
+
+		auto expected = mesh.raycast(from, dir);
+		auto res = field.raycast(from, dir);
+
+		ASSERT_EQ(res.hit(), expected.hit()) << i;
+		if (res.hit()) {
+			++hits;
+			EXPECT_NEAR(res.dist, expected.dist, 1e-4f) << i;
+		}
+
+		auto limited = field.raycast(from, dir, false, 1.0f);
+		EXPECT_EQ(limited.hit(), expected.hit() && expected.dist <= 1.0f) << i;
+	}
+	EXPECT_GT(hits, 200);
+}
+
+TEST(HeightField, spherecastTouchesFirst) {
+	auto field = makeField();
+	auto mesh = makeMesh(field);
+
+	std::mt19937 gen{ 10 };
+	std::uniform_real_distribution<float> pos{ -15.0f, 10.0f };
+	std::uniform_real_distribution<float> unit{ -1.0f, 1.0f };
+
+	size_t hits = 0;
+	for (int i = 0; i < 60; ++i) {
+		glm::vec3 from{ pos(gen), 6.0f, pos(gen) * 0.3f };
+		glm::vec3 dir{ unit(gen) * 4.0f, -2.0f, unit(gen) * 4.0f };
+		float radius = 0.2f + 0.1f * float(i % 8);
+
+		auto res = field.spherecast(from, dir, radius, 4.0f);
+		if (!res.hit()) {
+			EXPECT_GT(closestDistance(mesh, from + dir * 4.0f), radius - 0.01f) << i;
+			continue;
+		}
+		++hits;
+
+		EXPECT_NEAR(closestDistance(mesh, from + dir * res.dist), radius, 0.01f) << i;
+		for (float f : { 0.0f, 0.25f, 0.5f, 0.75f, 0.95f }) {
+			EXPECT_GT(closestDistance(mesh, from + dir * res.dist * f), radius - 0.01f) << i;
+		}
+		EXPECT_NEAR(glm::length(res.norm), 1.0f, 1e-4f);
+	}
+	EXPECT_GT(hits, 10);
+
+	// already touching
+	auto ground = *field.heightAt(0.0f, 0.0f);
+	auto touching = field.spherecast(glm::vec3(0.0f, ground + 0.1f, 0.0f), glm::vec3(1.0f, 0.0f, 0.0f), 0.5f);
+	ASSERT_TRUE(touching.hit());
+	EXPECT_EQ(touching.dist, 0.0f);
+
+	EXPECT_THROW((void)field.spherecast(glm::vec3(0.0f), glm::vec3(1.0f), -1.0f), std::invalid_argument);
+}
+
+TEST(HeightField, collideMatchesMesh) {
+	auto field = makeField();
+	auto mesh = makeMesh(field);
+
+	auto check = [&](const auto& shape) {
+		auto expected = mesh.getCollisions(shape);
+		auto res = field.getCollisions(shape);
+		std::sort(res.begin(), res.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+		std::sort(expected.begin(), expected.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+		EXPECT_EQ(res.size(), expected.size());
+		for (size_t i = 0; i < std::min(res.size(), expected.size()); ++i) {
+			EXPECT_EQ(res[i].first, expected[i].first);
+			EXPECT_EQ(res[i].second.depth, expected[i].second.depth);
+		}
+		return res.size();
+	};
+
+	auto ground = *field.heightAt(2.0f, 1.0f);
+	glm::vec3 p{ 2.0f, ground, 1.0f };
+
+	EXPECT_GT(check(Circle3D{ p + glm::vec3(0.0f, 0.3f, 0.0f), 0.5f }), 0);
+	EXPECT_GT(check(Capsule3D{ p + glm::vec3(-1.0f, 0.2f, 0.0f), p + glm::vec3(1.0f, 0.2f, 0.3f), 0.4f }), 0);
+	EXPECT_GT(check(OriRect3D{ p, glm::vec3(0.6f, 0.3f, 0.4f), glm::quat(glm::vec3(0.3f, 0.5f, 0.1f)) }), 0);
+	EXPECT_EQ(check(Circle3D{ p + glm::vec3(0.0f, 5.0f, 0.0f), 0.5f }), 0);
+
+	Circle3D ball{ p + glm::vec3(0.0f, 0.3f, 0.0f), 0.5f };
+	auto deepest = getCollision(ball, field);
+	ASSERT_TRUE(deepest.has_value());
+	for (const auto& [index, res] : field.getCollisions(ball)) {
+		EXPECT_LE(res.depth, deepest->depth);
+	}
+
+	auto flipped = getCollision(field, ball);
+	ASSERT_TRUE(flipped.has_value());
+	EXPECT_EQ(flipped->normal, -deepest->normal);
+	EXPECT_FALSE(getCollision(Circle3D{ p + glm::vec3(0.0f, 5.0f, 0.0f), 0.5f }, field).has_value());
+}
+
+TEST(HeightField, quantizedHeights) {
+	auto heights = makeHeights();
+	auto field = makeField();
+	auto quantized = HeightField16::quantize(width, depth, heights, origin, cellSize);
+
+	auto [lo, hi] = std::minmax_element(heights.begin(), heights.end());
+	auto maxError = (*hi - *lo) / 131070.0f + 1e-5f;
+
+	for (uint32_t z = 0; z < depth; ++z) {
+		for (uint32_t x = 0; x < width; ++x) {
+			EXPECT_NEAR(quantized.getPoint(x, z).y, field.getPoint(x, z).y, maxError);
+		}
+	}
+
+	auto mesh = makeMesh(quantized);
+	std::mt19937 gen{ 2 };
+	std::uniform_real_distribution<float> pos{ -20.0f, 20.0f };
+	for (int i = 0; i < 200; ++i) {
+		glm::vec3 from{ pos(gen), 10.0f, pos(gen) * 0.5f };
+		glm::vec3 dir{ pos(gen) * 0.05f, -1.0f, pos(gen) * 0.05f };
+
+		auto expected = mesh.raycast(from, dir);
+		auto res = quantized.raycast(from, dir);
+		ASSERT_EQ(res.hit(), expected.hit());
+		if (res.hit()) {
+			EXPECT_NEAR(res.dist, expected.dist, 1e-4f);
+		}
+	}
+}
+
+TEST(HeightField, rejectsBadInput) {
+	EXPECT_THROW((HeightField<>{ 1, 5, std::vector<float>(5), origin, cellSize }), std::invalid_argument);
+	EXPECT_THROW((HeightField<>{ 4, 4, std::vector<float>(15), origin, cellSize }), std::invalid_argument);
+	EXPECT_THROW((HeightField<>{ 4, 4, std::vector<float>(16), origin, glm::vec2(0.0f, 1.0f) }), std::invalid_argument);
+	EXPECT_THROW((HeightField<>{ 4, 4, std::vector<float>(16, std::numeric_limits<float>::infinity()), origin, cellSize }), std::invalid_argument);
+
+	HeightField<> tiny{ 2, 2, std::vector<float>{ 0.0f, 1.0f, 2.0f, 3.0f }, glm::vec3(0.0f), glm::vec2(1.0f) };
+	EXPECT_EQ(tiny.getLevelCount(), 0);
+	EXPECT_EQ(tiny.triCount(), 2);
+	EXPECT_THROW((void)tiny.getTri(2), std::out_of_range);
+	EXPECT_TRUE(tiny.raycast(glm::vec3(0.2f, 5.0f, 0.7f), glm::vec3(0.0f, -1.0f, 0.0f)).hit());
+}
\ No newline at end of file
@@ -0,0 +1,164 @@
+#include "collision/hull.hpp"
+#include "collision/gjk.hpp"
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+using namespace sndx::collision;
+
+namespace {
+	std::vector<glm::vec3> spherePoints(size_t count, unsigned seed, const glm::vec3& center = glm::vec3(0.0f)) {
+		std::mt19937 gen{ seed };
+		std::normal_distribution<float> dist{};
+
+		std::vector<glm::vec3> out{};
+		for (size_t i = 0; i < count; ++i) {
+			out.push_back(center + glm::normalize(glm::vec3(dist(gen), dist(gen), dist(gen))));
+		}
+		return out;
+	}
+
+	float bruteSupport(std::span<const glm::vec3> points, const glm::vec3& dir) {
+		auto best = std::numeric_limits<float>::lowest();
+		for (const auto& p : points) {
+			best = std::max(best, glm::dot(p, dir));
+		}
+		return best;
+	}
+}
+
+TEST(ConvexHull, cubeDropsInteriorPoints) {
+	std::vector<glm::vec3> points{};
+	for (int i = 0; i < 8; ++i) {
+		points.emplace_back(float(i & 1), float((i >> 1) & 1), float((i >> 2) & 1));
+	}
+
+	std::mt19937 gen{ 1 };
+	std::uniform_real_distribution<float> inner{ 0.1f, 0.9f };
+	for (int i = 0; i < 50; ++i) {
+		points.emplace_back(inner(gen), inner(gen), inner(gen));
+	}
+	points.push_back(points[3]);
+
+	ConvexHull hull{ points };
+	EXPECT_EQ(hull.size(), 8);
+	EXPECT_EQ(hull.getFaces().size(), 12);
+	EXPECT_EQ(hull.getBounds().getP1(), glm::vec3(0.0f));
+	EXPECT_EQ(hull.getBounds().getP2(), glm::vec3(1.0f));
+
+	// euler: every vertex of a triangulated cube has 4 or 5 neighbours, 36 directed edges in total
+	size_t edges = 0;
+	for (ConvexHull::Index i = 0; i < hull.size(); ++i) {
+		auto neighbours = hull.getNeighbours(i);
+		EXPECT_GE(neighbours.size(), 3);
+		edges += neighbours.size();
+	}
+	EXPECT_EQ(edges, 36);
+
+	for (const auto& face : hull.getFaces()) {
+		for (const auto& p : points) {
+			EXPECT_LE(glm::dot(face.normal, p) - face.offset, 1e-5f);
+		}
+	}
+
+	EXPECT_TRUE(hull.contains(glm::vec3(0.5f)));
+	EXPECT_FALSE(hull.contains(glm::vec3(1.1f, 0.5f, 0.5f)));
+}
+
+TEST(ConvexHull, supportMatchesBruteForce) {
+	auto points = spherePoints(2000, 2);
+	ConvexHull hull{ points };
+	ASSERT_TRUE(hull.usesHillClimbing());
+	ASSERT_GT(hull.size(), ConvexHull::bruteForceLimit);
+
+	std::mt19937 gen{ 5 };
+	std::normal_distribution<float> dist{};
+	std::uniform_int_distribution<ConvexHull::Index> start{ 0, ConvexHull::Index(hull.size() - 1) };
+
+	for (int i = 0; i < 500; ++i) {
+		glm::vec3 dir{ dist(gen), dist(gen), dist(gen) };
+		auto expected = bruteSupport(points, dir);
+
+		uint32_t steps = 0;
+		auto climbed = hull.supportHillClimb(dir, start(gen), steps);
+		EXPECT_NEAR(glm::dot(hull.getVertex(climbed), dir), expected, 1e-5f);
+		EXPECT_NEAR(glm::dot(hull.getVertex(hull.supportBruteForce(dir)), dir), expected, 1e-5f);
+	}
+}
+
+TEST(ConvexHull, warmSupportTakesFewSteps) {
+	ConvexHull hull{ spherePoints(4000, 3) };
+	auto support = getSupportFn(hull);
+
+	// a slowly turning direction, like successive gjk iterations
+	for (int i = 0; i < 1000; ++i) {
+		float t = float(i) * 0.01f;
+		glm::vec3 dir{ std::cos(t), std::sin(t * 0.7f), std::sin(t) };
+		auto p = support(dir);
+		EXPECT_NEAR(glm::dot(p, dir), bruteSupport(hull.getVertices(), dir), 1e-5f);
+	}
+
+	EXPECT_LT(support.getSteps(), 1000 * 4);
+}
+
+TEST(ConvexHull, smallHullScansEveryVertex) {
+	std::vector<glm::vec3> points{
+		{ 0.0f, 0.0f, 0.0f }, { 1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f, 1.0f },
+		{ 1.0f, 1.0f, 1.0f }, { 1.0f, 1.0f, 0.0f }
+	};
+
+	ConvexHull hull{ points };
+	EXPECT_FALSE(hull.usesHillClimbing());
+
+	// ties go to the lowest index no matter which lane they land in
+	EXPECT_EQ(hull.supportBruteForce(glm::vec3(1.0f, 0.0f, 0.0f)), 1);
+	EXPECT_EQ(hull.supportBruteForce(glm::vec3(0.0f, 1.0f, 0.0f)), 2);
+	EXPECT_EQ(hull.supportBruteForce(glm::vec3(-1.0f, -1.0f, -1.0f)), 0);
+	EXPECT_EQ(hull.supportPoint(glm::vec3(1.0f)), glm::vec3(1.0f));
+
+	auto sphere = spherePoints(ConvexHull::bruteForceLimit, 4);
+	ConvexHull round{ sphere };
+	std::mt19937 gen{ 6 };
+	std::normal_distribution<float> dist{};
+	for (int i = 0; i < 100; ++i) {
+		glm::vec3 dir{ dist(gen), dist(gen), dist(gen) };
+		EXPECT_NEAR(glm::dot(round.supportPoint(dir), dir), bruteSupport(sphere, dir), 1e-6f);
+	}
+}
+
+TEST(ConvexHull, gjkMatchesPointCloud) {
+	auto a = spherePoints(500, 7);
+	auto b = spherePoints(500, 8, glm::vec3(1.5f, 0.2f, 0.0f));
+	ConvexHull hullA{ a }, hullB{ b };
+
+	auto cloud = gjk(getSupportFn(std::span<const glm::vec3>{ a }), getSupportFn(std::span<const glm::vec3>{ b }));
+	auto hull = gjk(getSupportFn(hullA), getSupportFn(hullB));
+	ASSERT_TRUE(cloud.has_value());
+	ASSERT_TRUE(hull.has_value());
+
+	auto cloudPen = epa(*cloud, getSupportFn(std::span<const glm::vec3>{ a }), getSupportFn(std::span<const glm::vec3>{ b }));
+	auto hullPen = epa(*hull, getSupportFn(hullA), getSupportFn(hullB));
+	EXPECT_NEAR(cloudPen.depth, hullPen.depth, 1e-4f);
+	EXPECT_NEAR(glm::dot(cloudPen.normal, hullPen.normal), 1.0f, 1e-3f);
+
+	ConvexHull far{ spherePoints(500, 9, glm::vec3(3.0f, 0.0f, 0.0f)) };
+	EXPECT_FALSE(gjk(getSupportFn(hullA), getSupportFn(far)).has_value());
+}
+
+TEST(ConvexHull, rejectsDegenerateInput) {
+	std::vector<glm::vec3> few{ glm::vec3(0.0f), glm::vec3(1.0f), glm::vec3(2.0f) };
+	EXPECT_THROW(ConvexHull{ few }, std::invalid_argument);
+
+	std::vector<glm::vec3> same(10, glm::vec3(1.0f));
+	EXPECT_THROW(ConvexHull{ same }, std::invalid_argument);
+
+	std::vector<glm::vec3> line{ glm::vec3(0.0f), glm::vec3(1.0f), glm::vec3(2.0f), glm::vec3(3.0f) };
+	EXPECT_THROW(ConvexHull{ line }, std::invalid_argument);
+
+	std::vector<glm::vec3> flat{ { 0.0f, 0.0f, 0.0f }, { 1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 1.0f, 1.0f, 0.0f } };
+	EXPECT_THROW(ConvexHull{ flat }, std::invalid_argument);
+
+	ConvexHull hull{ spherePoints(10, 1) };
+	EXPECT_THROW((void)hull.getNeighbours(ConvexHull::Index(hull.size())), std::out_of_range);
+}
\ No newline at end of file
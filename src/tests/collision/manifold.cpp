@@ -0,0 +1,149 @@
+#include "collision/manifold.hpp"
+#include "collision/collision.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace sndx::collision;
+
+namespace {
+	const glm::quat identity{ 1.0f, 0.0f, 0.0f, 0.0f };
+
+	void expectInside(const OriRect3D& box, const glm::vec3& point, float tolerance = 0.001f) {
+		auto local = glm::transpose(glm::mat3_cast(box.getRotation())) * (point - box.getCenter());
+		for (glm::length_t i = 0; i < 3; ++i) {
+			EXPECT_LE(std::abs(local[i]), box.getHalfExtents()[i] + tolerance);
+		}
+	}
+}
+
+TEST(Manifold, faceOnFace) {
+	OriRect3D ground{ glm::vec3(0.0f), glm::vec3(5.0f, 0.5f, 5.0f), identity };
+	OriRect3D box{ glm::vec3(0.0f, 0.99f, 0.0f), glm::vec3(0.5f), identity };
+
+	auto manifold = getManifold(ground, box);
+	ASSERT_TRUE(manifold);
+	EXPECT_EQ(manifold->size(), 4);
+	EXPECT_NEAR(manifold->normal.y, 1.0f, 0.0001f);
+
+	for (const auto& point : manifold->getPoints()) {
+		EXPECT_NEAR(point.depth, 0.01f, 0.0001f);
+		EXPECT_NEAR(point.a.y, 0.5f, 0.0001f);
+		EXPECT_NEAR(point.b.y, 0.49f, 0.0001f);
+		EXPECT_NEAR(std::abs(point.b.x), 0.5f, 0.0001f);
+		EXPECT_NEAR(std::abs(point.b.z), 0.5f, 0.0001f);
+		EXPECT_NE(point.feature, 0);
+	}
+
+	// same pair the other way around
+	auto flipped = getManifold(box, ground);
+	ASSERT_TRUE(flipped);
+	EXPECT_EQ(flipped->size(), 4);
+	EXPECT_NEAR(flipped->normal.y, -1.0f, 0.0001f);
+
+	auto col = getCollision(ground, box);
+	ASSERT_TRUE(col);
+	EXPECT_NEAR(col->depth, 0.01f, 0.0001f);
+	EXPECT_NEAR(col->normal.y, 1.0f, 0.0001f);
+
+	// moving the box far enough along the normal separates them
+	EXPECT_FALSE(hasCollision(ground, OriRect3D{ box.getCenter() + col->normal * (col->depth + 0.0001f), box.getHalfExtents(), identity }));
+}
+
+TEST(Manifold, twistedBoxesClipToFourPoints) {
+	OriRect3D bottom{ glm::vec3(0.0f), glm::vec3(0.5f), identity };
+	OriRect3D top{ glm::vec3(0.0f, 0.98f, 0.0f), glm::vec3(0.5f), glm::quat(glm::vec3(0.0f, 0.785f, 0.0f)) };
+
+	auto manifold = getManifold(bottom, top);
+	ASSERT_TRUE(manifold);
+
+	// the clipped octagon is reduced to 4 points
+	EXPECT_EQ(manifold->size(), 4);
+	for (const auto& point : manifold->getPoints()) {
+		EXPECT_NEAR(point.depth, 0.02f, 0.0001f);
+		expectInside(bottom, point.a);
+		expectInside(top, point.b);
+	}
+}
+
+TEST(Manifold, edgeOnEdge) {
+	OriRect3D a{ glm::vec3(0.0f), glm::vec3(0.5f), glm::quat(glm::vec3(0.785398f, 0.0f, 0.0f)) };
+	OriRect3D b{ glm::vec3(0.0f, 1.4f, 0.0f), glm::vec3(0.5f), glm::quat(glm::vec3(0.0f, 0.0f, 0.785398f)) };
+
+	auto manifold = getManifold(a, b);
+	ASSERT_TRUE(manifold);
+	EXPECT_EQ(manifold->size(), 1);
+
+	const auto& point = manifold->points[0];
+	EXPECT_NEAR(manifold->normal.y, 1.0f, 0.001f);
+	EXPECT_NEAR(point.depth, std::sqrt(2.0f) - 1.4f, 0.001f);
+	EXPECT_NEAR(glm::length(point.a - glm::vec3(0.0f, std::sqrt(0.5f), 0.0f)), 0.0f, 0.001f);
+	EXPECT_NEAR(glm::length(point.b - glm::vec3(0.0f, 1.4f - std::sqrt(0.5f), 0.0f)), 0.0f, 0.001f);
+}
+
+TEST(Manifold, separated) {
+	OriRect3D a{ glm::vec3(0.0f), glm::vec3(0.5f), identity };
+	OriRect3D b{ glm::vec3(0.0f, 1.01f, 0.0f), glm::vec3(0.5f), glm::quat(glm::vec3(0.0f, 0.3f, 0.0f)) };
+
+	EXPECT_FALSE(getManifold(a, b));
+	EXPECT_FALSE(getCollision(a, b));
+}
+
+TEST(PersistentManifold, keepsImpulsesByFeature) {
+	OriRect3D ground{ glm::vec3(0.0f), glm::vec3(5.0f, 0.5f, 5.0f), identity };
+	OriRect3D box{ glm::vec3(0.0f, 0.99f, 0.0f), glm::vec3(0.5f), identity };
+
+	PersistentManifold persistent{};
+	EXPECT_EQ(persistent.update(*getManifold(ground, box)), 0);
+	ASSERT_EQ(persistent.size(), 4);
+
+	for (size_t i = 0; i < persistent.size(); ++i) {
+		persistent.getPoints()[i].normalImpulse = float(i + 1);
+	}
+
+	std::vector<std::pair<uint32_t, float>> before{};
+	for (const auto& point : persistent.getPoints()) {
+		before.emplace_back(point.feature, point.normalImpulse);
+	}
+
+	// slid sideways, the features stay the same
+	box.translate(glm::vec3(0.1f, 0.0f, 0.0f));
+	EXPECT_EQ(persistent.update(*getManifold(ground, box)), 4);
+
+	for (const auto& point : persistent.getPoints()) {
+		EXPECT_EQ(point.age, 1);
+
+		auto it = std::find_if(before.begin(), before.end(), [&](const auto& b) { return b.first == point.feature; });
+		ASSERT_NE(it, before.end());
+		EXPECT_EQ(point.normalImpulse, it->second);
+	}
+
+	// a flipped normal is a new contact
+	EXPECT_EQ(persistent.update(getManifold(ground, box)->swapped()), 0);
+	for (const auto& point : persistent.getPoints()) {
+		EXPECT_EQ(point.normalImpulse, 0.0f);
+		EXPECT_EQ(point.age, 0);
+	}
+}
+
+TEST(PersistentManifold, matchesUnknownFeaturesByDistance) {
+	Collision3D col{};
+	col.normal = glm::vec3(0.0f, 1.0f, 0.0f);
+	col.depth = 0.01f;
+	col.a = glm::vec3(0.0f);
+	col.b = glm::vec3(0.0f, -0.01f, 0.0f);
+
+	PersistentManifold persistent{ 0.05f };
+	persistent.update(Manifold3D{ col });
+	persistent.getPoints()[0].tangentImpulse = glm::vec2(0.5f, -0.25f);
+
+	col.b.x += 0.03f;
+	EXPECT_EQ(persistent.update(Manifold3D{ col }), 1);
+	EXPECT_EQ(persistent.getPoints()[0].tangentImpulse, glm::vec2(0.5f, -0.25f));
+
+	col.b.x += 0.1f;
+	EXPECT_EQ(persistent.update(Manifold3D{ col }), 0);
+	EXPECT_EQ(persistent.getPoints()[0].tangentImpulse, glm::vec2(0.0f));
+
+	persistent.clear();
+	EXPECT_TRUE(persistent.empty());
+}
@@ -0,0 +1,82 @@
+#include "collision/narrowphase.hpp"
+
+#include <gtest/gtest.h>
+
+#include "collision_helper.hpp"
+
+#include <cstring>
+
+using namespace sndx::collision;
+
+namespace {
+	// bitwise, some overloads produce nan contact points
+	bool sameCollision(const Collision3D& a, const Collision3D& b) {
+		return std::memcmp(&a, &b, sizeof(Collision3D)) == 0;
+	}
+}
+
+TEST(Narrowphase, matchesSerialLoop) {
+	auto shapes = randomShapes(40, 21, 4.0f);
+
+	std::vector<Narrowphase<>::Pair> pairs{};
+	for (uint32_t i = 0; i < shapes.size(); ++i) {
+		for (uint32_t j = i + 1; j < shapes.size(); ++j) {
+			pairs.emplace_back(i, j);
+		}
+	}
+
+	Narrowphase<> narrow{ 7 };
+	narrow.run(shapes, pairs);
+	ASSERT_EQ(narrow.getResults().size(), pairs.size());
+
+	std::vector<uint32_t> expectedHits{};
+	for (uint32_t i = 0; i < pairs.size(); ++i) {
+		auto res = getCollision(shapes[pairs[i].first], shapes[pairs[i].second]);
+		ASSERT_EQ(narrow.isHit(i), res.has_value()) << i;
+
+		if (res) {
+			expectedHits.push_back(i);
+			EXPECT_TRUE(sameCollision(*res, narrow.getResult(i)));
+		}
+	}
+
+	EXPECT_EQ(narrow.getHits(), expectedHits);
+	EXPECT_GT(narrow.hitCount(), 0);
+}
+
+TEST(Narrowphase, deterministicAcrossChunkSizes) {
+	auto shapes = randomShapes(50, 8, 4.0f);
+
+	std::vector<Narrowphase<>::Pair> pairs{};
+	for (uint32_t i = 0; i < shapes.size(); ++i) {
+		for (uint32_t j = 0; j < shapes.size(); ++j) {
+			if (i != j) {
+				pairs.emplace_back(i, j);
+			}
+		}
+	}
+
+	Narrowphase<> reference{ 1 };
+	reference.run(std::execution::seq, shapes, pairs);
+
+	for (size_t chunk : { size_t(3), size_t(64), size_t(10000) }) {
+		Narrowphase<> narrow{ chunk };
+
+		// run twice to make sure reused buffers don't leak stale hits
+		narrow.run(shapes, std::vector<Narrowphase<>::Pair>{ pairs.begin(), pairs.begin() + 10 });
+		narrow.run(shapes, pairs);
+
+		ASSERT_EQ(narrow.getHits(), reference.getHits());
+		for (auto hit : narrow.getHits()) {
+			EXPECT_TRUE(sameCollision(narrow.getResult(hit), reference.getResult(hit)));
+		}
+	}
+}
+
+TEST(Narrowphase, rejectsBadPairs) {
+	auto shapes = randomShapes(3, 1, 4.0f);
+	std::vector<Narrowphase<>::Pair> pairs{ { 0, 3 } };
+
+	Narrowphase<> narrow{};
+	EXPECT_THROW(narrow.run(shapes, pairs), std::out_of_range);
+}
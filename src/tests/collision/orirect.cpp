@@ -0,0 +1,215 @@
+#include "collision/collision.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace sndx::collision;
+
+namespace {
+	struct RandomBoxes {
+		std::mt19937 gen{ 7 };
+		std::uniform_real_distribution<float> pos{ -2.0f, 2.0f };
+		std::uniform_real_distribution<float> size{ 0.2f, 1.5f };
+		std::uniform_real_distribution<float> angle{ -3.14f, 3.14f };
+
+		OriRect3D box() {
+			return OriRect3D{ point(), glm::vec3{ size(gen), size(gen), size(gen) }, glm::quat(glm::vec3{ angle(gen), angle(gen), angle(gen) }) };
+		}
+
+		glm::vec3 point() {
+			return glm::vec3{ pos(gen), pos(gen), pos(gen) };
+		}
+	};
+
+	// reference versions straight from the quaternion, the way OriRect was tested before baking
+	constexpr float tolerance = 0.001f;
+
+	float projectedRadius(const OriRect3D& box, glm::vec3 axis) {
+		auto axes = glm::mat3_cast(box.getRotation());
+
+		float out = 0.0f;
+		for (glm::length_t i = 0; i < 3; ++i) {
+			out += box.getHalfExtents()[i] * std::abs(glm::dot(axes[i], axis));
+		}
+		return out;
+	}
+
+	// overlap of the two boxes' projections onto axis, negative if apart
+	float overlapAlong(const OriRect3D& a, const OriRect3D& b, glm::vec3 axis) {
+		axis = glm::normalize(axis);
+		return projectedRadius(a, axis) + projectedRadius(b, axis) - std::abs(glm::dot(b.getCenter() - a.getCenter(), axis));
+	}
+
+	// smallest overlap over all 15 SAT axes, negative if the boxes are apart
+	float satOverlap(const OriRect3D& a, const OriRect3D& b) {
+		auto axesA = glm::mat3_cast(a.getRotation());
+		auto axesB = glm::mat3_cast(b.getRotation());
+
+		std::vector<glm::vec3> axes{};
+		for (glm::length_t i = 0; i < 3; ++i) {
+			axes.push_back(axesA[i]);
+			axes.push_back(axesB[i]);
+			for (glm::length_t j = 0; j < 3; ++j) {
+				if (auto cross = glm::cross(axesA[i], axesB[j]); glm::length2(cross) > 0.000001f) {
+					axes.push_back(cross);
+				}
+			}
+		}
+
+		float out = std::numeric_limits<float>::max();
+		for (const auto& axis : axes) {
+			out = std::min(out, overlapAlong(a, b, axis));
+		}
+		return out;
+	}
+
+	float distanceTo(const OriRect3D& box, glm::vec3 point) {
+		auto local = glm::inverse(box.getRotation()) * (point - box.getCenter());
+		return glm::distance(local, glm::clamp(local, -box.getHalfExtents(), box.getHalfExtents()));
+	}
+
+	// the distance along the segment is convex, so a ternary search finds the closest point
+	float distanceTo(const OriRect3D& box, glm::vec3 from, glm::vec3 to) {
+		float lo = 0.0f, hi = 1.0f;
+		for (int i = 0; i < 100; ++i) {
+			auto l = lo + (hi - lo) / 3.0f;
+			auto r = hi - (hi - lo) / 3.0f;
+			if (distanceTo(box, glm::mix(from, to, l)) < distanceTo(box, glm::mix(from, to, r))) {
+				hi = r;
+			}
+			else {
+				lo = l;
+			}
+		}
+		return distanceTo(box, glm::mix(from, to, (lo + hi) * 0.5f));
+	}
+}
+
+TEST(BakedOriRect, matchesQuaternionVersions) {
+	RandomBoxes rng{};
+
+	size_t hits = 0;
+	for (int i = 0; i < 500; ++i) {
+		auto a = rng.box();
+		auto b = rng.box();
+
+		auto overlap = satOverlap(a, b);
+		auto collision = getCollision(a, b);
+		auto manifold = getManifold(a, b);
+
+		// too close to touching for float error to be ruled out
+		if (std::abs(overlap) > tolerance) {
+			EXPECT_EQ(hasCollision(a, b), overlap > 0.0f);
+			EXPECT_EQ(bool(collision), overlap > 0.0f);
+			EXPECT_EQ(bool(manifold), overlap > 0.0f);
+		}
+
+		if (collision && overlap > tolerance) {
+			++hits;
+
+			// face axes are kept unless an edge beats them by 5%, so the chosen axis may overlap a bit more than the minimum
+			auto chosen = overlapAlong(a, b, collision->normal);
+			EXPECT_GE(chosen, overlap - tolerance);
+			EXPECT_LE(chosen, (overlap + 0.0005f) / 0.95f + tolerance);
+			EXPECT_LE(collision->depth, chosen + tolerance);
+			EXPECT_GT(glm::dot(collision->normal, b.getCenter() - a.getCenter()), -tolerance);
+		}
+
+		if (manifold && overlap > tolerance) {
+			auto chosen = overlapAlong(a, b, manifold->normal);
+			for (size_t p = 0; p < manifold->size(); ++p) {
+				const auto& point = manifold->points[p];
+				EXPECT_LE(point.depth, chosen + tolerance);
+				EXPECT_LE(distanceTo(a, point.a), tolerance);
+				EXPECT_LE(distanceTo(b, point.b), tolerance);
+			}
+		}
+
+		Circle3D circle{ rng.point(), rng.size(rng.gen) };
+		auto circleGap = distanceTo(a, circle.getCenter()) - circle.getRadius();
+		if (std::abs(circleGap) > tolerance) {
+			EXPECT_EQ(hasCollision(circle, a), circleGap < 0.0f);
+			EXPECT_EQ(hasCollision(a, circle), circleGap < 0.0f);
+			EXPECT_EQ(bool(getCollision(a, circle)), circleGap < 0.0f);
+			EXPECT_EQ(bool(getCollision(circle, a)), circleGap < 0.0f);
+		}
+
+		// outside the box the depth is how far the circle reaches in
+		if (auto res = getCollision(circle, a); res && distanceTo(a, circle.getCenter()) > tolerance) {
+			EXPECT_NEAR(res->depth, -circleGap, tolerance);
+		}
+
+		Capsule3D capsule{ rng.point(), rng.point(), rng.size(rng.gen) * 0.5f };
+		auto segmentDist = distanceTo(a, capsule.getPointA(), capsule.getPointB());
+		auto capsuleGap = segmentDist - capsule.getRadius();
+		// the box test only samples the ends and face crossings of the segment, so it can miss a shallow corner hit but never reach further than the true distance
+		if (capsuleGap > tolerance) {
+			EXPECT_FALSE(getCollision(capsule, a));
+			EXPECT_FALSE(getCollision(a, capsule));
+		}
+
+		if (auto res = getCollision(capsule, a); res && segmentDist > tolerance) {
+			EXPECT_LE(res->depth, -capsuleGap + tolerance);
+		}
+	}
+
+	// make sure both outcomes were covered
+	EXPECT_GT(hits, 50);
+	EXPECT_LT(hits, 450);
+}
+
+TEST(BakedOriRect, boundsContainCorners) {
+	RandomBoxes rng{};
+
+	for (int i = 0; i < 100; ++i) {
+		auto box = rng.box();
+		BakedOriRect3D baked{ box };
+
+		auto bounds = getBounds(box);
+		EXPECT_EQ(bounds.getP1(), getBounds(baked).getP1());
+		EXPECT_EQ(bounds.getP2(), getBounds(baked).getP2());
+
+		glm::vec3 lo{ std::numeric_limits<float>::max() };
+		glm::vec3 hi{ std::numeric_limits<float>::lowest() };
+		for (int corner = 0; corner < 8; ++corner) {
+			glm::vec3 local{
+				(corner & 1) ? 1.0f : -1.0f,
+				(corner & 2) ? 1.0f : -1.0f,
+				(corner & 4) ? 1.0f : -1.0f
+			};
+			auto p = baked.toWorld(local * box.getHalfExtents());
+			lo = glm::min(lo, p);
+			hi = glm::max(hi, p);
+		}
+
+		for (glm::length_t axis = 0; axis < 3; ++axis) {
+			EXPECT_NEAR(bounds.getP1()[axis], lo[axis], 0.0001f);
+			EXPECT_NEAR(bounds.getP2()[axis], hi[axis], 0.0001f);
+		}
+	}
+}
+
+TEST(BakedOriRect, volume) {
+	OriRect3D box{ glm::vec3(1.0f, 2.0f, 3.0f), glm::vec3(0.5f, 1.0f, 2.0f), glm::quat(glm::vec3(0.0f, 1.5707963f, 0.0f)) };
+	BakedOriRect3D baked{ box };
+
+	EXPECT_EQ(baked.getCenter(), box.getCenter());
+	EXPECT_EQ(baked.getArea(), box.getArea());
+
+	auto local = glm::vec3(0.25f, -0.5f, 1.5f);
+	EXPECT_NEAR(glm::distance(baked.toLocal(baked.toWorld(local)), local), 0.0f, 0.00001f);
+
+	EXPECT_TRUE(baked.contains(box.getCenter()));
+	EXPECT_NEAR(baked.distance(glm::vec3(1.0f, 2.0f, 3.0f + 1.5f)), 1.0f, 0.0001f);
+	EXPECT_NEAR(baked.distance(glm::vec3(1.0f, 2.0f, 3.0f + 1.5f)), box.distance(glm::vec3(1.0f, 2.0f, 3.0f + 1.5f)), 0.0001f);
+
+	auto dir = glm::vec3(0.3f, -0.2f, 0.9f);
+	EXPECT_NEAR(glm::distance(baked.supportPoint(dir), box.supportPoint(dir)), 0.0f, 0.0001f);
+
+	auto unbaked = baked.unbake();
+	EXPECT_NEAR(std::abs(glm::dot(unbaked.getRotation(), box.getRotation())), 1.0f, 0.0001f);
+}
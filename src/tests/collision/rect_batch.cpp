@@ -0,0 +1,102 @@
+#include "collision/rect_batch.hpp"
+
+#include <gtest/gtest.h>
+
+#include "collision_helper.hpp"
+
+#include <random>
+
+using namespace sndx::collision;
+
+namespace {
+	std::vector<Rect3D> testBoxes(size_t count, unsigned seed) {
+		auto out = randomBoxes(count, seed, 20.0f, 0.0f, 4.0f);
+
+		// degenerate and touching boxes
+		out.emplace_back(glm::vec3(0.0f), glm::vec3(0.0f));
+		out.emplace_back(glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(2.0f, 1.0f, 1.0f));
+		return out;
+	}
+}
+
+TEST(RectBatch3D, overlapMatchesRect) {
+	auto boxes = testBoxes(203, 5);
+	RectBatch3D batch{ boxes };
+	ASSERT_EQ(batch.size(), boxes.size());
+
+	auto queries = testBoxes(50, 9);
+	queries.emplace_back(glm::vec3(-1.0f), glm::vec3(1.0f));
+
+	std::vector<uint64_t> mask{};
+	for (const auto& query : queries) {
+		auto count = batch.overlapMask(query, mask);
+
+		size_t expectedCount = 0;
+		for (size_t i = 0; i < boxes.size(); ++i) {
+			bool expected = query.overlaps(boxes[i]);
+			expectedCount += expected;
+			ASSERT_EQ(((mask[i / 64] >> (i % 64)) & 1) != 0, expected) << i;
+		}
+		EXPECT_EQ(count, expectedCount);
+
+		size_t visited = 0;
+		batch.forEachOverlap(query, [&](size_t i) {
+			EXPECT_TRUE(query.overlaps(boxes[i]));
+			++visited;
+		});
+		EXPECT_EQ(visited, expectedCount);
+	}
+}
+
+TEST(RectBatch3D, raycastMatchesRect) {
+	auto boxes = testBoxes(101, 3);
+	RectBatch3D batch{ boxes };
+
+	std::mt19937 gen{ 17 };
+	std::uniform_real_distribution<float> dist{ -25.0f, 25.0f };
+
+	std::vector<std::pair<glm::vec3, glm::vec3>> rays{
+		{ glm::vec3(-30.0f, 0.5f, 0.5f), glm::vec3(1.0f, 0.0f, 0.0f) },
+		{ glm::vec3(30.0f, 0.5f, 0.5f), glm::vec3(-1.0f, 0.0f, 0.0f) },
+		{ glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f) },
+	};
+	for (size_t i = 0; i < 100; ++i) {
+		rays.emplace_back(glm::vec3{ dist(gen), dist(gen), dist(gen) }, glm::vec3{ dist(gen), dist(gen), dist(gen) });
+	}
+
+	std::vector<float> dists{};
+	for (const auto& [from, dir] : rays) {
+		auto hits = batch.raycast(from, dir, dists);
+		ASSERT_EQ(dists.size(), boxes.size());
+
+		size_t expectedHits = 0;
+		for (size_t i = 0; i < boxes.size(); ++i) {
+			auto res = boxes[i].raycast(from, dir);
+			ASSERT_EQ(res.hit(), dists[i] != RectBatch3D::miss) << i;
+			if (res.hit()) {
+				EXPECT_EQ(res.distance(), dists[i]);
+				++expectedHits;
+			}
+		}
+		EXPECT_EQ(hits, expectedHits);
+	}
+
+	auto closest = batch.raycastClosest(glm::vec3(-30.0f, 0.5f, 0.5f), glm::vec3(1.0f, 0.0f, 0.0f));
+	ASSERT_TRUE(closest.has_value());
+	EXPECT_TRUE(boxes[closest->first].raycast(glm::vec3(-30.0f, 0.5f, 0.5f), glm::vec3(1.0f, 0.0f, 0.0f)).hit());
+}
+
+TEST(RectBatch3D, swapRemove) {
+	RectBatch3D batch{};
+	batch.push_back(Rect3D{ glm::vec3(0.0f), glm::vec3(1.0f) });
+	batch.push_back(Rect3D{ glm::vec3(5.0f), glm::vec3(6.0f) });
+	batch.push_back(Rect3D{ glm::vec3(10.0f), glm::vec3(11.0f) });
+
+	batch.swapRemove(0);
+	ASSERT_EQ(batch.size(), 2);
+	EXPECT_EQ(batch.get(0).getP1(), glm::vec3(10.0f));
+
+	std::vector<uint64_t> mask{};
+	EXPECT_EQ(batch.overlapMask(Rect3D{ glm::vec3(-100.0f), glm::vec3(100.0f) }, mask), 2);
+	EXPECT_THROW(batch.swapRemove(2), std::out_of_range);
+}
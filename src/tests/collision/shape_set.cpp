@@ -0,0 +1,140 @@
+#include "collision/shape_set.hpp"
+
+#include <gtest/gtest.h>
+
+#include "collision_helper.hpp"
+
+#include <cstring>
+
+using namespace sndx::collision;
+
+namespace {
+	std::vector<ShapeSet3D::Pair> allPairs(size_t count) {
+		std::vector<ShapeSet3D::Pair> pairs{};
+		for (uint32_t i = 0; i < count; ++i) {
+			for (uint32_t j = 0; j < count; ++j) {
+				if (i != j) {
+					pairs.emplace_back(i, j);
+				}
+			}
+		}
+		return pairs;
+	}
+
+	// the half space y <= height
+	struct Floor {
+		float height;
+	};
+
+	// only for the gjk fallback of floor vs floor
+	auto getSupportFn(const Floor& floor) {
+		return [h = floor.height](glm::vec3 dir) {
+			constexpr float far = 1000.0f;
+			return glm::vec3(dir.x > 0.0f ? far : -far, dir.y > 0.0f ? h : h - far, dir.z > 0.0f ? far : -far);
+		};
+	}
+
+	std::optional<Collision3D> getCollision(const Circle3D& a, const Floor& b) {
+		auto depth = b.height - (a.getCenter().y - a.getRadius());
+		if (depth < 0.0f)
+			return std::nullopt;
+
+		auto contact = a.getCenter() - glm::vec3(0.0f, a.getRadius(), 0.0f);
+		return Collision3D{ glm::vec3(0.0f, -1.0f, 0.0f), depth, contact, contact + glm::vec3(0.0f, depth, 0.0f) };
+	}
+
+	// bitwise, some overloads produce nan contact points
+	bool sameCollision(const Collision3D& a, const Collision3D& b) {
+		return std::memcmp(&a, &b, sizeof(Collision3D)) == 0;
+	}
+}
+
+TEST(ShapeSet, matchesVisit) {
+	auto shapes = randomShapes(40, 12);
+
+	size_t hits = 0;
+	for (const auto& [a, b] : allPairs(shapes.size())) {
+		auto expected = getCollision(shapes[a], shapes[b]);
+		auto res = ShapeSet3D::getCollision(shapes[a], shapes[b]);
+
+		ASSERT_EQ(res.has_value(), expected.has_value()) << a << ' ' << b;
+		EXPECT_EQ(ShapeSet3D::hasCollision(shapes[a], shapes[b]), expected.has_value()) << a << ' ' << b;
+
+		if (res) {
+			EXPECT_TRUE(sameCollision(*res, *expected)) << a << ' ' << b;
+			++hits;
+		}
+	}
+	EXPECT_GT(hits, 0);
+}
+
+TEST(ShapeSet, mirroredOverloadIsSwapped) {
+	using Set = ShapeSet<std::variant<Circle3D, Floor>>;
+
+	Set::Shape circle{ Circle3D{ glm::vec3(0.0f, 0.3f, 0.0f), 0.5f } };
+	Set::Shape floor{ Floor{ 0.0f } };
+
+	// only getCollision(Circle3D, Floor) exists
+	auto ab = Set::getCollision(circle, floor);
+	auto ba = Set::getCollision(floor, circle);
+	ASSERT_TRUE(ab.has_value());
+	ASSERT_TRUE(ba.has_value());
+	EXPECT_TRUE(sameCollision(*ba, ab->swapped()));
+	EXPECT_TRUE(Set::hasCollision(floor, circle));
+
+	std::get<Circle3D>(circle) = Circle3D{ glm::vec3(0.0f, 0.6f, 0.0f), 0.5f };
+	EXPECT_FALSE(Set::getCollision(floor, circle).has_value());
+	EXPECT_FALSE(Set::hasCollision(floor, circle));
+}
+
+TEST(ShapeSet, batchMatchesSingle) {
+	auto shapes = randomShapes(30, 4);
+	auto pairs = allPairs(shapes.size());
+
+	ShapeSet3D set{};
+	std::vector<std::optional<Collision3D>> results(pairs.size());
+	std::vector<uint8_t> tests(pairs.size());
+
+	// a smaller batch first so reused buckets can't leak
+	set.getCollisions(shapes, std::span{ pairs }.first(17), std::span{ results }.first(17));
+	set.getCollisions(shapes, pairs, results);
+	set.hasCollisions(shapes, pairs, tests);
+
+	for (size_t i = 0; i < pairs.size(); ++i) {
+		auto expected = ShapeSet3D::getCollision(shapes[pairs[i].first], shapes[pairs[i].second]);
+		ASSERT_EQ(results[i].has_value(), expected.has_value()) << i;
+		EXPECT_EQ(tests[i] != 0, expected.has_value()) << i;
+
+		if (expected) {
+			EXPECT_TRUE(sameCollision(*results[i], *expected)) << i;
+		}
+	}
+
+	// buckets hold every pair exactly once, in pair order within a bucket
+	size_t total = 0;
+	for (size_t type = 0; type < ShapeSet3D::pairTypeCount; ++type) {
+		auto bucket = set.getBucket(type);
+		total += bucket.size();
+
+		for (size_t i = 0; i < bucket.size(); ++i) {
+			const auto& [a, b] = pairs[bucket[i]];
+			EXPECT_EQ(ShapeSet3D::pairType(shapes[a], shapes[b]), type);
+			if (i > 0) {
+				EXPECT_LT(bucket[i - 1], bucket[i]);
+			}
+		}
+	}
+	EXPECT_EQ(total, pairs.size());
+}
+
+TEST(ShapeSet, rejectsBadInput) {
+	auto shapes = randomShapes(3, 1);
+	std::vector<ShapeSet3D::Pair> pairs{ { 0, 3 } };
+	std::vector<std::optional<Collision3D>> results(1);
+	std::vector<uint8_t> tests(2);
+
+	ShapeSet3D set{};
+	EXPECT_THROW(set.getCollisions(shapes, pairs, results), std::out_of_range);
+	EXPECT_THROW(set.hasCollisions(shapes, pairs, tests), std::invalid_argument);
+	EXPECT_THROW((void)set.getBucket(ShapeSet3D::pairTypeCount), std::out_of_range);
+}
\ No newline at end of file
@@ -0,0 +1,109 @@
+#include "collision/spatial_hash.hpp"
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <set>
+
+using namespace sndx::collision;
+
+namespace {
+	template <class VecT>
+	VecT randomVec(std::mt19937& gen, float lo, float hi) {
+		std::uniform_real_distribution<float> dist{ lo, hi };
+		VecT out{};
+		for (glm::length_t i = 0; i < VecT::length(); ++i) {
+			out[i] = dist(gen);
+		}
+		return out;
+	}
+}
+
+TEST(SpatialHash, circlePairsMatchBruteForce) {
+	std::mt19937 gen{ 7 };
+
+	std::vector<Circle2D> circles{};
+	for (size_t i = 0; i < 1000; ++i) {
+		circles.emplace_back(randomVec<glm::vec2>(gen, -30.0f, 30.0f), 0.5f);
+	}
+
+	CircleHash<glm::vec2> grid{ 1.0f };
+	grid.build(circles);
+
+	std::vector<std::pair<uint32_t, uint32_t>> pairs{};
+	grid.findPairs(pairs);
+
+	std::set<std::pair<uint32_t, uint32_t>> actual{ pairs.begin(), pairs.end() };
+	EXPECT_EQ(actual.size(), pairs.size()); // no duplicates
+
+	std::set<std::pair<uint32_t, uint32_t>> expected{};
+	for (uint32_t i = 0; i < circles.size(); ++i) {
+		for (uint32_t j = i + 1; j < circles.size(); ++j) {
+			if (hasCollision(circles[i], circles[j])) {
+				expected.emplace(i, j);
+			}
+		}
+	}
+
+	EXPECT_EQ(actual, expected);
+}
+
+TEST(SpatialHash, rectPairsAndRadiusQueries) {
+	std::mt19937 gen{ 11 };
+
+	std::vector<Rect3D> rects{};
+	for (size_t i = 0; i < 500; ++i) {
+		auto p = randomVec<glm::vec3>(gen, -10.0f, 10.0f);
+		rects.emplace_back(p, p + randomVec<glm::vec3>(gen, 0.2f, 1.5f));
+	}
+
+	RectHash<glm::vec3> grid{ 1.5f };
+
+	// rebuilding reuses the same storage and gives the same answer
+	for (size_t frame = 0; frame < 3; ++frame) {
+		grid.build(rects);
+
+		size_t pairs = 0;
+		grid.forEachPair([&](auto a, auto b) {
+			EXPECT_LT(a, b);
+			EXPECT_TRUE(rects[a].overlaps(rects[b]));
+			++pairs;
+		});
+
+		size_t expectedPairs = 0;
+		for (size_t i = 0; i < rects.size(); ++i) {
+			for (size_t j = i + 1; j < rects.size(); ++j) {
+				expectedPairs += rects[i].overlaps(rects[j]);
+			}
+		}
+		EXPECT_EQ(pairs, expectedPairs);
+	}
+
+	glm::vec3 center{ 1.0f, -2.0f, 0.5f };
+	float radius = 3.0f;
+
+	std::set<uint32_t> found{};
+	grid.queryRadius(center, radius, [&](uint32_t idx) {
+		EXPECT_TRUE(found.insert(idx).second);
+	});
+
+	std::set<uint32_t> expected{};
+	for (uint32_t i = 0; i < rects.size(); ++i) {
+		if (glm::distance(rects[i].closestPoint(center), center) <= radius) {
+			expected.insert(i);
+		}
+	}
+	EXPECT_EQ(found, expected);
+
+	size_t visited = 0;
+	grid.queryRadius(center, radius, [&](uint32_t) {
+		++visited;
+		return false;
+	});
+	EXPECT_EQ(visited, expected.empty() ? 0 : 1);
+}
+
+TEST(SpatialHash, invalidCellSizeThrows) {
+	EXPECT_THROW(CircleHash<glm::vec2>{ 0.0f }, std::invalid_argument);
+	EXPECT_THROW(CircleHash<glm::vec2>{ -1.0f }, std::invalid_argument);
+}
@@ -0,0 +1,111 @@
+#include "collision/sweep_prune.hpp"
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <set>
+
+using namespace sndx::collision;
+
+template <class T>
+class SweepAndPruneTest : public testing::Test {};
+
+using Types = ::testing::Types<glm::vec2, glm::vec3>;
+TYPED_TEST_SUITE(SweepAndPruneTest, Types);
+
+TYPED_TEST(SweepAndPruneTest, reportsOnlyChanges) {
+	using Id = typename SweepAndPrune<TypeParam>::Id;
+
+	SweepAndPrune<TypeParam> sap{};
+
+	auto a = sap.insert(Rect<TypeParam>{ TypeParam(0.0f), TypeParam(1.0f) });
+	auto b = sap.insert(Rect<TypeParam>{ TypeParam(0.5f), TypeParam(1.5f) });
+	auto c = sap.insert(Rect<TypeParam>{ TypeParam(5.0f), TypeParam(6.0f) });
+
+	sap.step();
+	ASSERT_EQ(sap.getAddedPairs().size(), 1);
+	EXPECT_TRUE(sap.getRemovedPairs().empty());
+	EXPECT_TRUE(sap.hasPair(a, b));
+	EXPECT_FALSE(sap.hasPair(a, c));
+
+	// nothing moved, nothing to report
+	sap.step();
+	EXPECT_TRUE(sap.getAddedPairs().empty());
+	EXPECT_TRUE(sap.getRemovedPairs().empty());
+	EXPECT_EQ(sap.pairCount(), 1);
+
+	sap.update(c, Rect<TypeParam>{ TypeParam(1.2f), TypeParam(2.0f) });
+	sap.step();
+	ASSERT_EQ(sap.getAddedPairs().size(), 1);
+	EXPECT_EQ(sap.getAddedPairs()[0], (std::pair<Id, Id>{ b, c }));
+	EXPECT_TRUE(sap.getRemovedPairs().empty());
+
+	sap.update(a, Rect<TypeParam>{ TypeParam(-3.0f), TypeParam(-2.0f) });
+	sap.step();
+	EXPECT_TRUE(sap.getAddedPairs().empty());
+	ASSERT_EQ(sap.getRemovedPairs().size(), 1);
+	EXPECT_EQ(sap.getRemovedPairs()[0], (std::pair<Id, Id>{ a, b }));
+
+	sap.remove(b);
+	sap.step();
+	EXPECT_TRUE(sap.getAddedPairs().empty());
+	EXPECT_EQ(sap.getRemovedPairs().size(), 1);
+	EXPECT_EQ(sap.pairCount(), 0);
+	EXPECT_EQ(sap.size(), 2);
+}
+
+TYPED_TEST(SweepAndPruneTest, matchesBruteForceWhileMoving) {
+	using Id = typename SweepAndPrune<TypeParam>::Id;
+
+	std::mt19937 gen{ 42 };
+	std::uniform_real_distribution<float> pos{ -10.0f, 10.0f };
+	std::uniform_real_distribution<float> jitter{ -0.3f, 0.3f };
+
+	auto randomVec = [&](auto& dist) {
+		TypeParam out{};
+		for (glm::length_t i = 0; i < TypeParam::length(); ++i) {
+			out[i] = dist(gen);
+		}
+		return out;
+	};
+
+	std::vector<Rect<TypeParam>> boxes{};
+	std::vector<Id> ids{};
+	SweepAndPrune<TypeParam> sap{};
+
+	for (size_t i = 0; i < 200; ++i) {
+		auto p = randomVec(pos);
+		boxes.emplace_back(p, p + TypeParam(1.0f));
+		ids.push_back(sap.insert(boxes.back()));
+	}
+
+	std::set<std::pair<Id, Id>> tracked{};
+	for (size_t frame = 0; frame < 20; ++frame) {
+		if (frame != 0) {
+			for (size_t i = 0; i < boxes.size(); ++i) {
+				boxes[i].translate(randomVec(jitter));
+				sap.update(ids[i], boxes[i]);
+			}
+		}
+		sap.step();
+
+		for (auto pair : sap.getRemovedPairs()) {
+			EXPECT_EQ(tracked.erase(pair), 1);
+		}
+		for (auto pair : sap.getAddedPairs()) {
+			EXPECT_TRUE(tracked.insert(pair).second);
+		}
+
+		std::set<std::pair<Id, Id>> expected{};
+		for (size_t i = 0; i < boxes.size(); ++i) {
+			for (size_t j = i + 1; j < boxes.size(); ++j) {
+				if (boxes[i].overlaps(boxes[j])) {
+					expected.emplace(ids[i], ids[j]);
+				}
+			}
+		}
+
+		ASSERT_EQ(tracked, expected);
+		EXPECT_EQ(sap.pairCount(), expected.size());
+	}
+}
\ No newline at end of file
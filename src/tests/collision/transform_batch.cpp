@@ -0,0 +1,179 @@
+#include "collision/transform_batch.hpp"
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+using namespace sndx::collision;
+
+namespace {
+	constexpr float tolerance = 1e-4f;
+
+	// not a multiple of the lane width so the tail is exercised
+	constexpr size_t count = 45;
+
+	std::mt19937 gen{ 20 };
+	std::uniform_real_distribution<float> pos{ -10.0f, 10.0f };
+	std::uniform_real_distribution<float> angle{ -3.0f, 3.0f };
+	std::uniform_real_distribution<float> scale{ 0.5f, 2.0f };
+
+	glm::vec3 randomPoint() {
+		return glm::vec3{ pos(gen), pos(gen), pos(gen) };
+	}
+
+	glm::quat randomRotation() {
+		return glm::quat{ glm::vec3{ angle(gen), angle(gen), angle(gen) } };
+	}
+
+	std::vector<TransformIsotropic> isotropicTransforms() {
+		std::vector<TransformIsotropic> out{};
+		for (size_t i = 0; i < count; ++i) {
+			out.emplace_back(randomPoint(), randomRotation(), scale(gen));
+		}
+		return out;
+	}
+
+	std::vector<Transform> transforms() {
+		std::vector<Transform> out{};
+		for (size_t i = 0; i < count; ++i) {
+			// a mirrored axis now and then
+			auto flip = i % 7 == 0 ? -1.0f : 1.0f;
+			out.emplace_back(randomPoint(), randomRotation(), glm::vec3{ scale(gen) * flip, scale(gen), scale(gen) });
+		}
+		return out;
+	}
+
+	void expectNear(const glm::vec3& a, const glm::vec3& b) {
+		EXPECT_NEAR(a.x, b.x, tolerance);
+		EXPECT_NEAR(a.y, b.y, tolerance);
+		EXPECT_NEAR(a.z, b.z, tolerance);
+	}
+
+	void expectNear(const Rect3D& a, const Rect3D& b) {
+		expectNear(a.getP1(), b.getP1());
+		expectNear(a.getP2(), b.getP2());
+	}
+}
+
+TEST(TransformBatch, circlesAndCapsules) {
+	auto tforms = isotropicTransforms();
+	TransformIsotropicBatch batch{ tforms };
+	ASSERT_EQ(batch.size(), count);
+
+	std::vector<Circle3D> circles{};
+	std::vector<Capsule3D> capsules{};
+	for (size_t i = 0; i < count; ++i) {
+		circles.emplace_back(randomPoint(), scale(gen));
+		capsules.emplace_back(randomPoint(), randomPoint(), scale(gen));
+	}
+
+	std::vector<Circle3D> worldCircles{};
+	std::vector<Capsule3D> worldCapsules{};
+	std::vector<Rect3D> bounds{};
+
+	batch.transform(circles, worldCircles, bounds);
+	ASSERT_EQ(worldCircles.size(), count);
+	ASSERT_EQ(bounds.size(), count);
+	for (size_t i = 0; i < count; ++i) {
+		auto expected = transform(circles[i], tforms[i]);
+		expectNear(worldCircles[i].getCenter(), expected.getCenter());
+		EXPECT_NEAR(worldCircles[i].getRadius(), expected.getRadius(), tolerance);
+		expectNear(bounds[i], getBounds(expected));
+	}
+
+	batch.transform(capsules, worldCapsules, bounds);
+	ASSERT_EQ(bounds.size(), count);
+	for (size_t i = 0; i < count; ++i) {
+		const auto& t = tforms[i];
+		Capsule3D expected{
+			t.pos + t.rot * (capsules[i].getPointA() * t.scale),
+			t.pos + t.rot * (capsules[i].getPointB() * t.scale),
+			capsules[i].getRadius() * t.scale
+		};
+		expectNear(worldCapsules[i].getPointA(), expected.getPointA());
+		expectNear(worldCapsules[i].getPointB(), expected.getPointB());
+		EXPECT_NEAR(worldCapsules[i].getRadius(), expected.getRadius(), tolerance);
+		expectNear(bounds[i], getBounds(expected));
+	}
+}
+
+TEST(TransformBatch, rectsBecomeOriRects) {
+	std::vector<Rect3D> rects{};
+	for (size_t i = 0; i < count; ++i) {
+		auto p = randomPoint();
+		rects.emplace_back(p, p + glm::vec3{ scale(gen), scale(gen), scale(gen) });
+	}
+
+	std::vector<OriRect3D> world{};
+	std::vector<Rect3D> bounds{};
+
+	auto check = [&](const auto& tforms) {
+		ASSERT_EQ(world.size(), count);
+		ASSERT_EQ(bounds.size(), count);
+		for (size_t i = 0; i < count; ++i) {
+			auto expected = transform(rects[i], tforms[i]);
+			expectNear(world[i].getCenter(), expected.getCenter());
+			expectNear(world[i].getHalfExtents(), expected.getHalfExtents());
+			EXPECT_EQ(world[i].getRotation(), tforms[i].rot);
+			expectNear(bounds[i], getBounds(expected));
+		}
+	};
+
+	auto isotropic = isotropicTransforms();
+	TransformIsotropicBatch(isotropic).transform(rects, world, bounds);
+	check(isotropic);
+
+	auto anisotropic = transforms();
+	TransformBatch(anisotropic).transform(rects, world, bounds);
+	check(anisotropic);
+}
+
+TEST(TransformBatch, triangles) {
+	std::vector<Tri3D> tris{};
+	for (size_t i = 0; i < count; ++i) {
+		tris.emplace_back(randomPoint(), randomPoint(), randomPoint());
+	}
+
+	auto tforms = transforms();
+	TransformBatch batch{ tforms };
+
+	std::vector<Tri3D> world{};
+	std::vector<Rect3D> bounds{};
+	batch.transform(tris, world, bounds);
+
+	ASSERT_EQ(world.size(), count);
+	for (size_t i = 0; i < count; ++i) {
+		auto expected = transform(tris[i], tforms[i]);
+		expectNear(world[i].getP1(), expected.getP1());
+		expectNear(world[i].getP2(), expected.getP2());
+		expectNear(world[i].getP3(), expected.getP3());
+		expectNear(bounds[i], getBounds(expected));
+	}
+}
+
+TEST(TransformBatch, storage) {
+	TransformBatch batch{};
+	EXPECT_TRUE(batch.empty());
+
+	Transform tform{ glm::vec3{ 1.0f, 2.0f, 3.0f }, glm::quat{ glm::vec3{ 0.1f, 0.2f, 0.3f } }, glm::vec3{ 1.0f, 2.0f, 3.0f } };
+	auto idx = batch.push_back(Transform{});
+	batch.set(idx, tform);
+
+	auto got = batch.get(idx);
+	EXPECT_EQ(got.pos, tform.pos);
+	EXPECT_EQ(got.rot, tform.rot);
+	EXPECT_EQ(got.scale, tform.scale);
+
+	std::vector<Tri3D> world{};
+	std::vector<Rect3D> bounds{};
+	std::vector<Tri3D> two(2, Tri3D{ glm::vec3{ 0.0f }, glm::vec3{ 1.0f }, glm::vec3{ 2.0f } });
+	EXPECT_THROW(batch.transform(two, world, bounds), std::invalid_argument);
+	EXPECT_THROW(batch.set(1, tform), std::out_of_range);
+	EXPECT_THROW((void)batch.get(1), std::out_of_range);
+
+	batch.clear();
+	EXPECT_TRUE(batch.empty());
+	batch.transform(std::span<const Tri3D>{}, world, bounds);
+	EXPECT_TRUE(world.empty());
+	EXPECT_TRUE(bounds.empty());
+}
\ No newline at end of file
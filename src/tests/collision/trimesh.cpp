@@ -0,0 +1,170 @@
+#include "collision/trimesh.hpp"
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <set>
+
+using namespace sndx::collision;
+
+namespace {
+	// a bumpy grid plus some floating debris
+	std::vector<Tri3D> makeLevel(unsigned seed) {
+		std::mt19937 gen{ seed };
+		std::uniform_real_distribution<float> height{ -0.5f, 0.5f };
+		std::uniform_real_distribution<float> pos{ -20.0f, 20.0f };
+		std::uniform_real_distribution<float> offset{ -1.0f, 1.0f };
+
+		constexpr int size = 30;
+		std::vector<float> heights((size + 1) * (size + 1));
+		for (auto& h : heights) {
+			h = height(gen);
+		}
+
+		auto vertex = [&](int x, int z) {
+			return glm::vec3{ float(x - size / 2), heights[z * (size + 1) + x], float(z - size / 2) };
+		};
+
+		std::vector<Tri3D> out{};
+		for (int z = 0; z < size; ++z) {
+			for (int x = 0; x < size; ++x) {
+				out.emplace_back(vertex(x, z), vertex(x, z + 1), vertex(x + 1, z));
+				out.emplace_back(vertex(x + 1, z), vertex(x, z + 1), vertex(x + 1, z + 1));
+			}
+		}
+
+		for (size_t i = 0; i < 300; ++i) {
+			glm::vec3 p{ pos(gen), pos(gen) * 0.25f + 3.0f, pos(gen) };
+			out.emplace_back(p, p + glm::vec3{ offset(gen), offset(gen), offset(gen) }, p + glm::vec3{ offset(gen), offset(gen), offset(gen) });
+		}
+
+		return out;
+	}
+
+	Tri3D::RaycastResult bruteRaycast(const std::vector<Tri3D>& tris, const glm::vec3& from, const glm::vec3& dir, size_t& index) {
+		Tri3D::RaycastResult best{};
+		for (size_t i = 0; i < tris.size(); ++i) {
+			auto res = tris[i].raycast(from, dir);
+			if (res.hit() && res.dist < best.dist) {
+				best = res;
+				index = i;
+			}
+		}
+		return best;
+	}
+}
+
+TEST(TriangleMesh, emptyMesh) {
+	TriangleMesh mesh{};
+
+	EXPECT_TRUE(mesh.empty());
+	EXPECT_FALSE(mesh.raycast(glm::vec3(0.0f), glm::vec3(0.0f, -1.0f, 0.0f)).hit());
+	EXPECT_FALSE(mesh.raycastAny(glm::vec3(0.0f), glm::vec3(0.0f, -1.0f, 0.0f)));
+	EXPECT_TRUE(mesh.getCollisions(Circle3D{ glm::vec3(0.0f), 1.0f }).empty());
+}
+
+TEST(TriangleMesh, raycastMatchesBruteForce) {
+	auto tris = makeLevel(3);
+	TriangleMesh mesh{ tris };
+	ASSERT_EQ(mesh.size(), tris.size());
+
+	for (const auto& node : mesh.getNodes()) {
+		EXPECT_LE(node.count, TriangleMesh::maxLeafSize);
+	}
+
+	std::mt19937 gen{ 99 };
+	std::uniform_real_distribution<float> dist{ -15.0f, 15.0f };
+
+	size_t hits = 0;
+	for (size_t i = 0; i < 300; ++i) {
+		glm::vec3 from{ dist(gen), 10.0f, dist(gen) };
+		glm::vec3 dir = glm::vec3{ dist(gen), -15.0f, dist(gen) } - from;
+
+		size_t expectedIdx = 0;
+		auto expected = bruteRaycast(tris, from, dir, expectedIdx);
+		auto actual = mesh.raycast(from, dir);
+
+		ASSERT_EQ(actual.hit(), expected.hit());
+		EXPECT_EQ(mesh.raycastAny(from, dir), expected.hit());
+
+		if (expected.hit()) {
+			++hits;
+			EXPECT_FLOAT_EQ(actual.distance(), expected.distance());
+			EXPECT_EQ(actual.index, expectedIdx);
+			EXPECT_EQ(&mesh.getTri(actual.index), actual.tri);
+
+			// maxDist cuts off anything further away
+			EXPECT_FALSE(mesh.raycastAny(from, dir, false, expected.distance() * 0.5f) && !mesh.raycast(from, dir, false, expected.distance() * 0.5f).hit());
+		}
+	}
+	EXPECT_GT(hits, 200);
+}
+
+TEST(TriangleMesh, packetsMatchSingleRays) {
+	auto tris = makeLevel(4);
+	TriangleMesh mesh{ tris };
+
+	std::array<glm::vec3, 8> from{}, dir{};
+	for (size_t r = 0; r < 8; ++r) {
+		from[r] = glm::vec3{ -3.0f, 6.0f, -3.0f };
+		dir[r] = glm::vec3{ float(r) * 0.3f - 1.0f, -1.0f, 0.5f + float(r % 3) * 0.2f };
+	}
+	// one ray that misses everything
+	dir[7] = glm::vec3{ 0.0f, 1.0f, 0.0f };
+
+	auto packet8 = mesh.raycastPacket<8>(from, dir);
+
+	std::array<glm::vec3, 4> from4{ from[0], from[1], from[2], from[3] };
+	std::array<glm::vec3, 4> dir4{ dir[0], dir[1], dir[2], dir[3] };
+	auto packet4 = mesh.raycastPacket<4>(from4, dir4);
+
+	for (size_t r = 0; r < 8; ++r) {
+		auto single = mesh.raycast(from[r], dir[r]);
+		ASSERT_EQ(packet8[r].hit(), single.hit());
+		if (single.hit()) {
+			EXPECT_EQ(packet8[r].index, single.index);
+			EXPECT_FLOAT_EQ(packet8[r].distance(), single.distance());
+		}
+
+		if (r < 4) {
+			ASSERT_EQ(packet4[r].hit(), single.hit());
+			EXPECT_EQ(packet4[r].index, single.index);
+		}
+	}
+	EXPECT_FALSE(packet8[7].hit());
+}
+
+TEST(TriangleMesh, collideMatchesBruteForce) {
+	auto tris = makeLevel(5);
+	TriangleMesh mesh{ tris };
+
+	auto check = [&](const auto& shape) {
+		std::set<TriangleMesh::TriIndex> expected{};
+		for (TriangleMesh::TriIndex i = 0; i < tris.size(); ++i) {
+			if (getBounds(shape).overlaps(tris[i].getBounds()) && getCollision(shape, tris[i])) {
+				expected.insert(i);
+			}
+		}
+
+		std::set<TriangleMesh::TriIndex> actual{};
+		for (const auto& [index, res] : mesh.getCollisions(shape)) {
+			EXPECT_TRUE(actual.insert(index).second);
+			EXPECT_GE(res.depth, 0.0f);
+		}
+
+		EXPECT_EQ(actual, expected);
+		return actual.size();
+	};
+
+	EXPECT_GT(check(Circle3D{ glm::vec3(0.3f, 0.0f, 0.2f), 1.5f }), 0);
+	EXPECT_GT(check(Capsule3D{ glm::vec3(-2.0f, -0.2f, 1.0f), glm::vec3(2.0f, 0.4f, 1.0f), 0.5f }), 0);
+	EXPECT_GT(check(OriRect3D{ glm::vec3(4.0f, 0.0f, -3.0f), glm::vec3(1.0f, 0.5f, 1.0f), glm::quat(glm::vec3(0.3f, 0.5f, 0.0f)) }), 0);
+	EXPECT_EQ(check(Circle3D{ glm::vec3(0.0f, -50.0f, 0.0f), 1.0f }), 0);
+
+	size_t visited = 0;
+	mesh.collide(Circle3D{ glm::vec3(0.3f, 0.0f, 0.2f), 1.5f }, [&](auto, const auto&) {
+		++visited;
+		return false;
+	});
+	EXPECT_EQ(visited, 1);
+}
@@ -0,0 +1,223 @@
+#include "collision/world.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <execution>
+
+using namespace sndx::collision;
+
+namespace {
+	RigidWorld::BodyId addGround(RigidWorld& world) {
+		RigidWorld::BodyDesc ground{};
+		ground.shape = OriRect3D{ glm::vec3(0.0f), glm::vec3(50.0f, 0.5f, 50.0f), glm::quat(1.0f, 0.0f, 0.0f, 0.0f) };
+		ground.position = glm::vec3(0.0f, -0.5f, 0.0f);
+		ground.mass = 0.0f;
+		return world.addBody(ground);
+	}
+
+	RigidWorld::BodyId addBall(RigidWorld& world, const glm::vec3& pos, float radius = 0.5f) {
+		RigidWorld::BodyDesc ball{};
+		ball.shape = Circle3D{ glm::vec3(0.0f), radius };
+		ball.position = pos;
+		return world.addBody(ball);
+	}
+}
+
+TEST(RigidWorld, freeFall) {
+	RigidWorld world{};
+	auto ball = addBall(world, glm::vec3(0.0f, 100.0f, 0.0f));
+
+	for (int i = 0; i < 60; ++i) {
+		world.step(1.0f / 60.0f);
+	}
+
+	EXPECT_NEAR(world.getLinearVelocity(ball).y, -9.81f, 0.001f);
+	EXPECT_NEAR(world.getPosition(ball).y, 100.0f - 0.5f * 9.81f, 0.1f);
+	EXPECT_TRUE(world.getContacts().empty());
+	EXPECT_EQ(world.islandCount(), 1);
+}
+
+TEST(RigidWorld, restingBallFallsAsleep) {
+	RigidWorld world{};
+	auto ground = addGround(world);
+	auto ball = addBall(world, glm::vec3(0.0f, 2.0f, 0.0f));
+
+	for (int i = 0; i < 240; ++i) {
+		world.step(1.0f / 60.0f);
+	}
+
+	EXPECT_NEAR(world.getPosition(ball).y, 0.5f, 0.02f);
+	EXPECT_FALSE(world.isAwake(ball));
+	EXPECT_FALSE(world.isAwake(ground));
+	EXPECT_EQ(world.getPosition(ground), glm::vec3(0.0f, -0.5f, 0.0f));
+	EXPECT_EQ(world.awakeCount(), 0);
+
+	// nothing left to solve
+	world.step(1.0f / 60.0f);
+	EXPECT_EQ(world.islandCount(), 0);
+	EXPECT_TRUE(world.getContacts().empty());
+
+	world.applyImpulse(ball, glm::vec3(0.0f, 5.0f, 0.0f), world.getPosition(ball));
+	EXPECT_TRUE(world.isAwake(ball));
+
+	world.step(1.0f / 60.0f);
+	EXPECT_GT(world.getPosition(ball).y, 0.5f);
+}
+
+TEST(RigidWorld, warmStartCarriesRestingImpulse) {
+	RigidWorld world{};
+	addGround(world);
+	auto ball = addBall(world, glm::vec3(0.0f, 0.5f, 0.0f));
+
+	auto dt = 1.0f / 60.0f;
+	for (int i = 0; i < 20; ++i) {
+		world.step(dt);
+	}
+
+	ASSERT_EQ(world.getContacts().size(), 1);
+	const auto& contact = world.getContacts().front();
+	EXPECT_EQ(contact.b, ball);
+	EXPECT_NEAR(contact.normal.y, 1.0f, 0.001f);
+
+	// supports exactly its own weight
+	EXPECT_NEAR(contact.normalImpulse, 9.81f * dt, 0.01f);
+	EXPECT_NEAR(world.getPosition(ball).y, 0.5f, 0.01f);
+}
+
+TEST(RigidWorld, separateStacksAreSeparateIslands) {
+	RigidWorld world{};
+	addGround(world);
+
+	std::vector<RigidWorld::BodyId> left{}, right{};
+	for (int i = 0; i < 3; ++i) {
+		left.push_back(addBall(world, glm::vec3(-5.0f, 0.5f + float(i), 0.0f)));
+		right.push_back(addBall(world, glm::vec3(5.0f, 0.5f + float(i), 0.0f)));
+	}
+
+	world.step(1.0f / 60.0f);
+	EXPECT_EQ(world.islandCount(), 2);
+
+	for (int i = 0; i < 300; ++i) {
+		world.step(1.0f / 60.0f);
+	}
+
+	for (int i = 0; i < 3; ++i) {
+		EXPECT_NEAR(world.getPosition(left[i]).y, 0.5f + float(i), 0.05f);
+		EXPECT_NEAR(world.getPosition(left[i]).x, -5.0f, 0.01f);
+		EXPECT_NEAR(world.getPosition(right[i]).y, 0.5f + float(i), 0.05f);
+		EXPECT_NEAR(world.getPosition(right[i]).x, 5.0f, 0.01f);
+	}
+	EXPECT_EQ(world.awakeCount(), 0);
+
+	// waking one stack leaves the other asleep
+	world.wake(left[2]);
+	world.step(1.0f / 60.0f);
+	EXPECT_EQ(world.islandCount(), 1);
+	EXPECT_FALSE(world.isAwake(right[0]));
+}
+
+TEST(RigidWorld, boxSettlesOnGround) {
+	RigidWorld world{};
+	addGround(world);
+
+	RigidWorld::BodyDesc box{};
+	box.shape = OriRect3D{ glm::vec3(0.0f), glm::vec3(0.5f), glm::quat(1.0f, 0.0f, 0.0f, 0.0f) };
+	box.position = glm::vec3(0.0f, 1.0f, 0.0f);
+	box.mass = 2.0f;
+	auto id = world.addBody(box);
+
+	for (int i = 0; i < 300; ++i) {
+		world.step(1.0f / 60.0f);
+	}
+
+	EXPECT_NEAR(world.getPosition(id).y, 0.5f, 0.01f);
+	EXPECT_NEAR(world.getPosition(id).x, 0.0f, 0.001f);
+	EXPECT_NEAR(world.getPosition(id).z, 0.0f, 0.001f);
+	EXPECT_FALSE(world.isAwake(id));
+}
+
+TEST(RigidWorld, boxStackStaysUp) {
+	RigidWorld world{};
+	addGround(world);
+
+	std::vector<RigidWorld::BodyId> boxes{};
+	for (int i = 0; i < 5; ++i) {
+		RigidWorld::BodyDesc box{};
+		box.shape = OriRect3D{ glm::vec3(0.0f), glm::vec3(0.5f), glm::quat(1.0f, 0.0f, 0.0f, 0.0f) };
+		box.position = glm::vec3(0.0f, 0.5f + float(i) * 1.01f, 0.0f);
+		boxes.push_back(world.addBody(box));
+	}
+
+	for (int i = 0; i < 600; ++i) {
+		world.step(1.0f / 60.0f);
+	}
+
+	for (int i = 0; i < 5; ++i) {
+		auto pos = world.getPosition(boxes[i]);
+		EXPECT_NEAR(pos.y, 0.5f + float(i), 0.05f);
+		EXPECT_NEAR(pos.x, 0.0f, 0.01f);
+		EXPECT_NEAR(pos.z, 0.0f, 0.01f);
+	}
+	EXPECT_EQ(world.awakeCount(), 0);
+}
+
+TEST(RigidWorld, deterministicAcrossPolicies) {
+	auto run = [](auto&& policy) {
+		RigidWorld world{};
+		addGround(world);
+
+		std::vector<RigidWorld::BodyId> balls{};
+		for (int i = 0; i < 8; ++i) {
+			balls.push_back(addBall(world, glm::vec3(float(i % 4) * 3.0f, 1.0f + float(i), float(i / 4) * 0.3f)));
+		}
+
+		for (int i = 0; i < 120; ++i) {
+			world.step(policy, 1.0f / 60.0f);
+		}
+
+		std::vector<glm::vec3> out{};
+		for (auto id : balls) {
+			out.push_back(world.getPosition(id));
+		}
+		return out;
+	};
+
+	auto seq = run(std::execution::seq);
+	auto par = run(std::execution::par);
+
+	ASSERT_EQ(seq.size(), par.size());
+	EXPECT_EQ(std::memcmp(seq.data(), par.data(), seq.size() * sizeof(glm::vec3)), 0);
+}
+
+TEST(RigidWorld, removeAndValidate) {
+	RigidWorld world{};
+	addGround(world);
+	auto a = addBall(world, glm::vec3(0.0f, 0.5f, 0.0f));
+	auto b = addBall(world, glm::vec3(0.0f, 1.5f, 0.0f));
+
+	for (int i = 0; i < 60; ++i) {
+		world.step(1.0f / 60.0f);
+	}
+
+	world.removeBody(a);
+	EXPECT_FALSE(world.contains(a));
+	EXPECT_TRUE(world.isAwake(b));
+	EXPECT_EQ(world.size(), 2);
+	EXPECT_THROW((void)world.getPosition(a), std::invalid_argument);
+	EXPECT_THROW(world.removeBody(a), std::invalid_argument);
+	EXPECT_THROW((void)world.getPosition(100), std::invalid_argument);
+
+	for (int i = 0; i < 120; ++i) {
+		world.step(1.0f / 60.0f);
+	}
+	EXPECT_NEAR(world.getPosition(b).y, 0.5f, 0.02f);
+
+	// ids are reused
+	EXPECT_EQ(addBall(world, glm::vec3(10.0f)), a);
+
+	RigidWorld::BodyDesc bad{};
+	bad.mass = -1.0f;
+	EXPECT_THROW(world.addBody(bad), std::invalid_argument);
+	EXPECT_THROW(world.step(0.0f), std::invalid_argument);
+}
\ No newline at end of file
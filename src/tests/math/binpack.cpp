@@ -2,6 +2,8 @@
 
 #include <gtest/gtest.h>
 
+#include <random>
+
 using namespace sndx::math;
 
 TEST(Binpack, TrivialPacking) {
@@ -111,4 +113,199 @@ TEST(Binpack, invalid_packing_throws) {
 	
 	EXPECT_THROW(auto ign = packer.pack(0), std::invalid_argument);
 	EXPECT_THROW(auto ign = packer.pack(1), std::invalid_argument);
+}
+
+namespace {
+	struct Sprite {
+		size_t id, width, height;
+	};
+
+	std::vector<Sprite> randomSprites(size_t count, unsigned seed) {
+		std::mt19937 gen{ seed };
+		std::uniform_int_distribution<size_t> small{ 2, 24 };
+		std::uniform_int_distribution<size_t> large{ 24, 90 };
+
+		std::vector<Sprite> out{};
+		for (size_t i = 0; i < count; ++i) {
+			// mostly small glyph-like sprites with the odd big one
+			auto& widths = i % 9 == 0 ? large : small;
+			auto& heights = i % 5 == 0 ? large : small;
+			out.push_back(Sprite{ i, widths(gen), heights(gen) });
+		}
+		return out;
+	}
+
+	template <class Packer>
+	Packing<size_t> packSprites(const std::vector<Sprite>& sprites, size_t dimConstraint, size_t padding) {
+		Packer packer{};
+		for (const auto& s : sprites) {
+			packer.add(s.id, s.width, s.height);
+		}
+		return packer.pack(dimConstraint, padding);
+	}
+
+	// every sprite is present, in bounds and padded away from the others
+	void validate(const Packing<size_t>& packing, const std::vector<Sprite>& sprites, size_t dimConstraint, size_t padding) {
+		ASSERT_EQ(packing.positions.size(), sprites.size());
+
+		size_t area = 0;
+		std::vector<std::array<size_t, 4>> rects{};
+		for (const auto& s : sprites) {
+			ASSERT_TRUE(packing.contains(s.id));
+			auto pos = packing.find(s.id)->second;
+			auto rotated = packing.isRotated(s.id);
+			auto w = rotated ? s.height : s.width;
+			auto h = rotated ? s.width : s.height;
+
+			EXPECT_LE(pos.x + w, dimConstraint);
+			EXPECT_LE(pos.x + w, packing.width());
+			EXPECT_LE(pos.y + h, packing.height());
+
+			rects.push_back({ pos.x, pos.y, w + padding, h + padding });
+			area += w * h;
+		}
+
+		for (size_t i = 0; i < rects.size(); ++i) {
+			for (size_t j = i + 1; j < rects.size(); ++j) {
+				const auto& a = rects[i];
+				const auto& b = rects[j];
+				auto overlaps = a[0] < b[0] + b[2] && b[0] < a[0] + a[2] && a[1] < b[1] + b[3] && b[1] < a[1] + a[3];
+				ASSERT_FALSE(overlaps) << i << " " << j;
+			}
+		}
+
+		EXPECT_EQ(packing.usedArea, area);
+		EXPECT_GT(packing.efficiency(), 0.0);
+		EXPECT_LE(packing.efficiency(), 1.0);
+	}
+}
+
+TEST(Binpack, SkylineAndMaxRectsAreValid) {
+	auto sprites = randomSprites(400, 5);
+
+	for (size_t padding : { 0, 1, 3 }) {
+		validate(packSprites<SkylinePacker<size_t>>(sprites, 256, padding), sprites, 256, padding);
+		validate(packSprites<SkylinePacker<size_t, true>>(sprites, 256, padding), sprites, 256, padding);
+		validate(packSprites<MaxRectsPacker<size_t>>(sprites, 256, padding), sprites, 256, padding);
+		validate(packSprites<MaxRectsPacker<size_t, true>>(sprites, 256, padding), sprites, 256, padding);
+	}
+}
+
+TEST(Binpack, MaxRectsTighterThanShelves) {
+	auto sprites = randomSprites(400, 6);
+
+	auto shelves = packSprites<BinPacker<true, size_t>>(sprites, 256, 1);
+	auto skyline = packSprites<SkylinePacker<size_t>>(sprites, 256, 1);
+	auto maxRects = packSprites<MaxRectsPacker<size_t>>(sprites, 256, 1);
+
+	EXPECT_GT(maxRects.efficiency(), shelves.efficiency());
+	EXPECT_LT(maxRects.height(), shelves.height());
+	EXPECT_GT(skyline.efficiency(), 0.8);
+	EXPECT_GT(maxRects.efficiency(), 0.85);
+}
+
+TEST(Binpack, RectPackersTrivial) {
+	SkylinePacker skyline{};
+	MaxRectsPacker maxRects{};
+
+	EXPECT_TRUE(skyline.pack(0).empty());
+	EXPECT_EQ(maxRects.pack(0).efficiency(), 0.0);
+
+	skyline.add("a", 10, 5);
+	skyline.add("b", 1, 5);
+	maxRects.add("a", 10, 5);
+	maxRects.add("b", 1, 5);
+
+	for (const auto& out : { skyline.pack(11), maxRects.pack(11) }) {
+		EXPECT_EQ(out.width(), 11);
+		EXPECT_EQ(out.height(), 5);
+		EXPECT_EQ(out.find("a")->second, (glm::vec<2, size_t>{ 0, 0 }));
+		EXPECT_EQ(out.find("b")->second, (glm::vec<2, size_t>{ 10, 0 }));
+		EXPECT_DOUBLE_EQ(out.efficiency(), 1.0);
+		EXPECT_FALSE(out.isRotated("a"));
+	}
+
+	EXPECT_THROW(auto ign = skyline.pack(9), std::invalid_argument);
+	EXPECT_THROW(auto ign = maxRects.pack(9), std::invalid_argument);
+}
+
+TEST(Binpack, RotationFitsWideEntries) {
+	SkylinePacker<std::string, true> skyline{};
+	MaxRectsPacker<std::string, true> maxRects{};
+
+	skyline.add("wide", 20, 4);
+	maxRects.add("wide", 20, 4);
+
+	for (const auto& out : { skyline.pack(8), maxRects.pack(8) }) {
+		EXPECT_TRUE(out.isRotated("wide"));
+		EXPECT_EQ(out.width(), 4);
+		EXPECT_EQ(out.height(), 20);
+	}
+
+	EXPECT_THROW(auto ign = skyline.pack(3), std::invalid_argument);
+	EXPECT_THROW(auto ign = maxRects.pack(3), std::invalid_argument);
+}
+
+TEST(Binpack, PagesSpillAndStayInBounds) {
+	auto sprites = randomSprites(300, 7);
+
+	for (size_t padding : { 0, 2 }) {
+		PagePacker<size_t> packer{};
+		for (const auto& s : sprites) {
+			packer.add(s.id, s.width, s.height);
+		}
+
+		auto out = packer.pack(128, 96, padding);
+		ASSERT_EQ(out.positions.size(), sprites.size());
+		EXPECT_GT(out.pages(), 1);
+		EXPECT_LE(out.width(), 128);
+		EXPECT_LE(out.height(), 96);
+
+		// each page on its own is a valid packing
+		size_t area = 0;
+		for (size_t page = 0; page < out.pages(); ++page) {
+			Packing<size_t> single{};
+			std::vector<Sprite> onPage{};
+
+			for (const auto& s : sprites) {
+				if (out.page(s.id) == page) {
+					single.positions.emplace(s.id, out.find(s.id)->second);
+					onPage.push_back(s);
+				}
+			}
+			ASSERT_FALSE(onPage.empty()) << page;
+
+			single.neededWidth = out.width();
+			single.neededHeight = out.height();
+			for (const auto& s : onPage) {
+				single.usedArea += s.width * s.height;
+			}
+			area += single.usedArea;
+
+			validate(single, onPage, 128, padding);
+		}
+
+		EXPECT_EQ(out.usedArea, area);
+		EXPECT_GT(out.efficiency(), 0.5);
+	}
+}
+
+TEST(Binpack, PagesRejectOversizeEntries) {
+	PagePacker packer{};
+	EXPECT_EQ(packer.pack(10, 10).pages(), 0);
+
+	packer.add("a", 10, 10);
+	auto out = packer.pack(10, 10);
+	EXPECT_EQ(out.pages(), 1);
+	EXPECT_EQ(out.page("a"), 0);
+	EXPECT_DOUBLE_EQ(out.efficiency(), 1.0);
+
+	packer.add("tall", 4, 12);
+	EXPECT_THROW(auto ign = packer.pack(20, 10), std::invalid_argument);
+
+	PagePacker<std::string, true> rotating{};
+	rotating.add("tall", 4, 12);
+	auto rotated = rotating.pack(20, 10);
+	EXPECT_TRUE(rotated.isRotated("tall"));
+	EXPECT_EQ(rotated.height(), 4);
 }
\ No newline at end of file
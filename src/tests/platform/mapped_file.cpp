@@ -0,0 +1,60 @@
+#include "platform/mapped_file.hpp"
+
+#include "../common.hpp"
+
+#include <fstream>
+#include <string>
+
+using namespace sndx::platform;
+
+class MappedFileTest : public ::testing::Test {
+public:
+	std::filesystem::path path{};
+
+	void SetUp() override {
+		set_test_weight(TestWeight::Integration);
+
+		path = std::filesystem::temp_directory_path() / "sndx_test_dir" / "MappedFile.bin";
+		std::filesystem::create_directories(path.parent_path());
+	}
+
+	void TearDown() override {
+		std::filesystem::remove(path);
+	}
+};
+
+TEST_F(MappedFileTest, mapsContents) {
+	const std::string contents = "mapped file contents";
+	{
+		std::ofstream file{ path, std::ios::binary };
+		file << contents;
+	}
+
+	MappedFile mapped{ path };
+	ASSERT_TRUE(mapped.valid());
+	ASSERT_EQ(mapped.size(), contents.size());
+	EXPECT_EQ(std::string_view(reinterpret_cast<const char*>(mapped.data().data()), mapped.size()), contents);
+
+	auto moved = std::move(mapped);
+	EXPECT_FALSE(mapped.valid());
+	EXPECT_TRUE(moved.valid());
+	EXPECT_EQ(moved.data()[0], std::byte('m'));
+
+	moved.close();
+	EXPECT_FALSE(moved.valid());
+	EXPECT_TRUE(moved.data().empty());
+}
+
+TEST_F(MappedFileTest, handlesEmptyAndMissing) {
+	{
+		std::ofstream file{ path, std::ios::binary };
+	}
+
+	MappedFile empty{ path };
+	EXPECT_TRUE(empty.valid());
+	EXPECT_TRUE(empty.data().empty());
+
+	MappedFile missing{ path.parent_path() / ".NOT_A_REAL_FILE.;-;" };
+	EXPECT_FALSE(missing.valid());
+	EXPECT_TRUE(missing.data().empty());
+}
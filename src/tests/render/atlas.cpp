@@ -92,6 +92,90 @@ TEST_F(ImageAtlasTest, addsEntry) {
 	EXPECT_NO_THROW(std::ignore = atlas.getEntry(42));
 }*/
 
+TEST_F(ImageAtlasTest, buildsPages) {
+	AtlasBuilder<size_t> builder{};
+
+	std::vector<ImageData> imgs{};
+	for (size_t i = 0; i < 10; ++i) {
+		imgs.push_back(createSolidImage<1>(6, 5, glm::vec<1, std::byte>{ std::byte(i + 1) }));
+	}
+	for (size_t i = 0; i < imgs.size(); ++i) {
+		builder.add(i, imgs[i]);
+	}
+
+	// 2 x 2 padded entries fit on a page
+	auto atlas = builder.buildPages(16, 16, 1);
+	const auto& image = atlas.m_image;
+
+	ASSERT_EQ(atlas.pages(), 3);
+	EXPECT_EQ(image.width(), 14);
+	EXPECT_EQ(atlas.pageHeight(), 12);
+	EXPECT_EQ(image.height(), atlas.pageHeight() * atlas.pages());
+
+	for (size_t i = 0; i < imgs.size(); ++i) {
+		const auto& entry = atlas.m_entries.at(i);
+		ASSERT_LT(entry.page, atlas.pages());
+		EXPECT_EQ(entry.dims, (glm::vec<2, size_t>{ 6, 5 }));
+
+		for (size_t y = 0; y < entry.dims.y; ++y) {
+			for (size_t x = 0; x < entry.dims.x; ++x) {
+				ASSERT_EQ(image.at(entry.pos.x + x, entry.page * atlas.pageHeight() + entry.pos.y + y, 0), std::byte(i + 1));
+			}
+		}
+	}
+
+	EXPECT_THROW(auto ign = builder.buildPages(5, 16, 1), std::invalid_argument);
+}
+
+TEST_F(ImageAtlasTest, texturePagesAreLayers) {
+	AtlasBuilder<size_t> builder{};
+
+	std::vector<ImageData> imgs{};
+	for (size_t i = 0; i < 10; ++i) {
+		imgs.push_back(createSolidImage<1>(6, 5, glm::vec<1, std::byte>{ std::byte(i + 1) }));
+	}
+	for (size_t i = 0; i < imgs.size(); ++i) {
+		builder.add(i, imgs[i]);
+	}
+
+	auto atlas = builder.buildPages(16, 16, 1);
+	ASSERT_EQ(atlas.pages(), 3);
+
+	// a single 2D texture would be every page tall
+	EXPECT_THROW((TextureAtlas<FakeTexture, size_t>{ atlas }), std::invalid_argument);
+
+	TextureAtlas<FakeTextureArray, size_t> texture{ atlas };
+	const auto& tex = texture.getTexture();
+	EXPECT_EQ(texture.pages(), 3);
+	EXPECT_EQ(tex.layers(), 3);
+	EXPECT_EQ(tex.height(), atlas.pageHeight());
+
+	const auto& layers = tex.asImage(1);
+
+	size_t onLaterPages = 0;
+	for (const auto& [id, entry] : texture) {
+		ASSERT_EQ(entry.page, atlas.m_entries.at(id).page);
+		onLaterPages += entry.page != 0;
+
+		// back from uv to texels of the entry's layer
+		auto texel = [&](glm::vec2 uv) {
+			return glm::vec<2, size_t>{ std::lround(uv.x * float(tex.width())), std::lround(uv.y * float(tex.height())) };
+		};
+
+		auto pos = texel(entry.pos);
+		auto end = texel(entry.pos + entry.dims);
+		ASSERT_EQ(end - pos, (glm::vec<2, size_t>{ 6, 5 }));
+
+		for (size_t y = pos.y; y < end.y; ++y) {
+			for (size_t x = pos.x; x < end.x; ++x) {
+				ASSERT_EQ(layers.at(x, entry.page * tex.height() + y, 0), std::byte(id + 1));
+			}
+		}
+	}
+
+	EXPECT_GT(onLaterPages, 0);
+}
+
 class IntenseImageAtlasTest : public ImageAtlasTest {
 public:
 	void SetUp() override {
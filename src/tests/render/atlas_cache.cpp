@@ -0,0 +1,159 @@
+#include "render/atlas_cache.hpp"
+
+#include "../common.hpp"
+#include "image/image_helper.hpp"
+
+#include <array>
+#include <fstream>
+#include <iterator>
+
+using namespace sndx::render;
+
+class AtlasCacheTest : public ::testing::Test {
+public:
+	std::filesystem::path path{};
+	std::vector<ImageData> imgs{};
+	AtlasBuilder<std::string> builder{};
+
+	void SetUp() override {
+		set_test_weight(TestWeight::Integration);
+
+		path = std::filesystem::temp_directory_path() / "sndx_test_dir" / "AtlasCache.sndxatlas";
+		std::filesystem::create_directories(path.parent_path());
+		std::filesystem::remove(path);
+
+		imgs.push_back(createCheckeredImage(7, 5, glm::vec<3, std::byte>{ std::byte(0xff), std::byte(0x10), std::byte(0x20) }));
+		imgs.push_back(createSolidImage<4>(3, 9, glm::vec<4, std::byte>{ std::byte(0x1), std::byte(0x2), std::byte(0x3), std::byte(0x4) }));
+		imgs.push_back(createSolidImage<1>(12, 2, glm::vec<1, std::byte>{ std::byte(0x80) }));
+
+		builder.add("checkers", imgs[0]);
+		builder.add("solid", imgs[1]);
+		builder.add("gray", imgs[2]);
+	}
+
+	void TearDown() override {
+		std::filesystem::remove(path);
+	}
+
+	static void expectSame(const ImageAtlas<std::string>& a, const ImageAtlas<std::string>& b) {
+		ASSERT_EQ(a.m_image.width(), b.m_image.width());
+		ASSERT_EQ(a.m_image.height(), b.m_image.height());
+		ASSERT_EQ(a.m_image.channels(), b.m_image.channels());
+		EXPECT_EQ(a.pages(), b.pages());
+		EXPECT_TRUE(std::equal(a.m_image.data(), a.m_image.data() + a.m_image.bytes(), b.m_image.data()));
+
+		ASSERT_EQ(a.m_entries.size(), b.m_entries.size());
+		for (const auto& [id, entry] : a.m_entries) {
+			ASSERT_TRUE(b.m_entries.contains(id));
+			const auto& other = b.m_entries.at(id);
+			EXPECT_EQ(entry.pos, other.pos);
+			EXPECT_EQ(entry.dims, other.dims);
+			EXPECT_EQ(entry.rotated, other.rotated);
+			EXPECT_EQ(entry.page, other.page);
+		}
+	}
+};
+
+TEST_F(AtlasCacheTest, roundTrips) {
+	auto atlas = builder.buildPages(12, 10, 1);
+	ASSERT_GT(atlas.pages(), 1);
+
+	ASSERT_TRUE(AtlasCache<std::string>::save(path, atlas, 1234));
+	EXPECT_FALSE(std::filesystem::exists(path.string() + ".tmp"));
+
+	auto cache = AtlasCache<std::string>::open(path);
+	ASSERT_TRUE(cache.has_value());
+	EXPECT_EQ(cache->hash(), 1234);
+	EXPECT_EQ(cache->pages(), atlas.pages());
+	EXPECT_EQ(cache->pixels().size(), atlas.m_image.bytes());
+
+	// the pixels are aligned in the file for uploading straight from the map
+	EXPECT_EQ(std::filesystem::file_size(path) - cache->pixels().size(), 64 * ((std::filesystem::file_size(path) - cache->pixels().size()) / 64));
+
+	expectSame(atlas, cache->toImageAtlas());
+}
+
+TEST_F(AtlasCacheTest, rebuildsOnlyWhenInputsChange) {
+	size_t builds = 0;
+	auto build = [&]() {
+		++builds;
+		return builder.build(16, 1);
+	};
+
+	auto hash = builder.contentHash();
+	EXPECT_EQ(hash, builder.contentHash());
+
+	auto first = loadOrBuildAtlas<std::string>(path, hash, build);
+	auto second = loadOrBuildAtlas<std::string>(path, hash, build);
+	EXPECT_EQ(builds, 1);
+	expectSame(first, second);
+
+	// any change to the inputs changes the hash
+	imgs[2].at(3, 1, 0) = std::byte(0x81);
+	EXPECT_NE(builder.contentHash(), hash);
+	std::ignore = loadOrBuildAtlas<std::string>(path, builder.contentHash(), build);
+	EXPECT_EQ(builds, 2);
+
+	// settings are part of the key too
+	auto cached = buildCached(builder, path, 16, 1);
+	auto again = buildCached(builder, path, 16, 1);
+	expectSame(cached, again);
+	expectSame(cached, builder.build(16, 1));
+	EXPECT_NE(AtlasCache<std::string>::open(path)->hash(), builder.contentHash());
+
+	auto wider = buildCached(builder, path, 32, 1);
+	expectSame(wider, builder.build(32, 1));
+
+	// so is the packer, by its tag rather than its compiler specific type name
+	auto widerHash = AtlasCache<std::string>::open(path)->hash();
+	std::ignore = buildCached<sndx::math::MaxRectsPacker<size_t>>(builder, path, 32, 1);
+	EXPECT_NE(AtlasCache<std::string>::open(path)->hash(), widerHash);
+
+	std::ignore = buildCached(builder, path, AtlasBuilder<>::DefaultPacker::cacheTag, 32, 1);
+	EXPECT_EQ(AtlasCache<std::string>::open(path)->hash(), widerHash);
+}
+
+TEST_F(AtlasCacheTest, rejectsOtherFiles) {
+	EXPECT_FALSE(AtlasCache<std::string>::open(path).has_value());
+
+	{
+		std::ofstream file{ path, std::ios::binary };
+		file << "definitely not an atlas";
+	}
+	EXPECT_FALSE(AtlasCache<std::string>::open(path).has_value());
+
+	// a real cache cut short is damaged
+	ASSERT_TRUE(AtlasCache<std::string>::save(path, builder.build(16, 1), 1));
+	std::filesystem::resize_file(path, std::filesystem::file_size(path) - 10);
+	EXPECT_THROW(std::ignore = AtlasCache<std::string>::open(path), sndx::deserialize_error);
+
+	// and gets rebuilt
+	auto atlas = loadOrBuildAtlas<std::string>(path, 1, [&]() { return builder.build(16, 1); });
+	expectSame(atlas, builder.build(16, 1));
+	EXPECT_NO_THROW(std::ignore = AtlasCache<std::string>::open(path));
+}
+
+
+TEST_F(AtlasCacheTest, rejectsOverflowingDimensions) {
+	std::vector<uint8_t> head{};
+	auto out = std::back_inserter(head);
+
+	// 2^31 x 2^31 x 4 wraps around to 0 pixel bytes
+	sndx::serializeToAdjust(out, std::array<char, 8>{ 'S', 'N', 'D', 'X', 'A', 'T', 'L', 'S' });
+	sndx::serializeToAdjust(out, uint32_t(1));
+	sndx::serializeToAdjust(out, uint32_t(4));
+	sndx::serializeToAdjust(out, uint64_t(1234));
+	sndx::serializeToAdjust(out, uint64_t(1) << 31);
+	sndx::serializeToAdjust(out, uint64_t(1) << 31);
+	sndx::serializeToAdjust(out, uint64_t(1));
+	sndx::serializeToAdjust(out, uint64_t(0));
+	sndx::serializeToAdjust(out, uint64_t(head.size() + 2 * sizeof(uint64_t)));
+	sndx::serializeToAdjust(out, uint64_t(0));
+
+	{
+		std::ofstream file{ path, std::ios::binary };
+		file.write(reinterpret_cast<const char*>(head.data()), std::streamsize(head.size()));
+	}
+
+	EXPECT_THROW(std::ignore = AtlasCache<std::string>::open(path), sndx::bad_field_error);
+}
\ No newline at end of file
@@ -0,0 +1,168 @@
+#include "render/dynamic_atlas.hpp"
+
+#include "image/image_helper.hpp"
+
+#include <gtest/gtest.h>
+
+#include <numeric>
+#include <random>
+
+using namespace sndx::render;
+
+namespace {
+	using Atlas = DynamicAtlas<size_t>;
+
+	glm::vec<3, std::byte> colorOf(size_t id) {
+		return glm::vec<3, std::byte>{ std::byte(id % 251 + 1), std::byte(id / 251 + 1), std::byte(0x7f) };
+	}
+
+	void expectHolds(const Atlas& atlas, size_t id) {
+		ASSERT_TRUE(atlas.contains(id));
+		auto [pos, dims] = atlas.getEntry(id);
+		const auto& image = atlas.getImage();
+
+		ASSERT_LE(pos.x + dims.x, atlas.width());
+		ASSERT_LE(pos.y + dims.y, atlas.height());
+
+		auto color = colorOf(id);
+		for (size_t y = pos.y; y < pos.y + dims.y; ++y) {
+			for (size_t x = pos.x; x < pos.x + dims.x; ++x) {
+				ASSERT_EQ(image.at(x, y, 0), color.x);
+				ASSERT_EQ(image.at(x, y, 1), color.y);
+				ASSERT_EQ(image.at(x, y, 2), color.z);
+			}
+		}
+	}
+
+	void expectSeparate(const Atlas& atlas, size_t padding) {
+		std::vector<Atlas::Region> regions{};
+		for (const auto& [id, region] : atlas) {
+			regions.push_back(region);
+		}
+
+		for (size_t i = 0; i < regions.size(); ++i) {
+			for (size_t j = i + 1; j < regions.size(); ++j) {
+				const auto& a = regions[i];
+				const auto& b = regions[j];
+				auto overlaps = a.pos.x < b.pos.x + b.dims.x + padding && b.pos.x < a.pos.x + a.dims.x + padding &&
+					a.pos.y < b.pos.y + b.dims.y + padding && b.pos.y < a.pos.y + a.dims.y + padding;
+				ASSERT_FALSE(overlaps);
+			}
+		}
+	}
+}
+
+TEST(DynamicAtlas, insertsAndReportsDirty) {
+	Atlas atlas{ 64, 32, 3, 1 };
+	EXPECT_TRUE(atlas.empty());
+
+	ASSERT_TRUE(atlas.insert(0, createSolidImage(10, 6, colorOf(0))));
+	ASSERT_TRUE(atlas.insert(1, createSolidImage(5, 12, colorOf(1))));
+	EXPECT_EQ(atlas.size(), 2);
+
+	expectHolds(atlas, 0);
+	expectHolds(atlas, 1);
+	expectSeparate(atlas, 1);
+
+	// each insert dirties its footprint
+	auto dirty = atlas.takeDirty();
+	ASSERT_EQ(dirty.size(), 2);
+	EXPECT_EQ(dirty[0].pos, atlas.getEntry(0).pos);
+	EXPECT_EQ(dirty[0].dims, (glm::vec<2, size_t>{ 11, 7 }));
+	EXPECT_EQ(dirty[1].pos, atlas.getEntry(1).pos);
+	EXPECT_EQ(dirty[1].dims, (glm::vec<2, size_t>{ 6, 13 }));
+	EXPECT_TRUE(atlas.getDirty().empty());
+
+	// removing needs no upload
+	EXPECT_TRUE(atlas.remove(0));
+	EXPECT_FALSE(atlas.remove(0));
+	EXPECT_FALSE(atlas.contains(0));
+	EXPECT_TRUE(atlas.getDirty().empty());
+
+	// a full size image only fits once everything is gone, padding at the edge is free
+	EXPECT_FALSE(atlas.insert(2, createSolidImage(64, 32, colorOf(2))));
+	EXPECT_TRUE(atlas.getDirty().empty());
+	atlas.remove(1);
+	ASSERT_TRUE(atlas.insert(2, createSolidImage(64, 32, colorOf(2))));
+	expectHolds(atlas, 2);
+}
+
+TEST(DynamicAtlas, reusesFreedSpace) {
+	Atlas atlas{ 128, 128, 3, 2 };
+
+	std::mt19937 gen{ 22 };
+	std::uniform_int_distribution<size_t> side{ 3, 20 };
+
+	std::vector<std::pair<size_t, size_t>> sizes{};
+	size_t id = 0;
+	for (;; ++id) {
+		auto w = side(gen);
+		auto h = side(gen);
+		if (!atlas.insert(id, createSolidImage(w, h, colorOf(id))))
+			break;
+
+		sizes.emplace_back(w, h);
+	}
+	ASSERT_GT(id, 40);
+	expectSeparate(atlas, 2);
+
+	// churn, a freed slot always takes back something its own size
+	std::vector<size_t> ids(sizes.size());
+	std::iota(ids.begin(), ids.end(), size_t(0));
+	for (int round = 0; round < 3; ++round) {
+		std::shuffle(ids.begin(), ids.end(), gen);
+		for (auto i : ids) {
+			ASSERT_TRUE(atlas.remove(i));
+			ASSERT_TRUE(atlas.insert(i, createSolidImage(sizes[i].first, sizes[i].second, colorOf(i)))) << i;
+		}
+	}
+
+	expectSeparate(atlas, 2);
+	for (size_t i = 0; i < sizes.size(); ++i) {
+		expectHolds(atlas, i);
+	}
+
+	// neighbours merge back into bigger space
+	atlas.clear();
+	for (size_t i = 0; i < 4; ++i) {
+		ASSERT_TRUE(atlas.insert(i, createSolidImage(30, 126, colorOf(i))));
+	}
+	EXPECT_FALSE(atlas.insert(4, createSolidImage(62, 62, colorOf(4))));
+
+	auto left = std::min_element(atlas.begin(), atlas.end(), [](const auto& a, const auto& b) {
+		return a.second.pos.x < b.second.pos.x;
+	})->first;
+	auto next = std::find_if(atlas.begin(), atlas.end(), [](const auto& a) {
+		return a.second.pos.x == 32;
+	})->first;
+
+	atlas.remove(left);
+	atlas.remove(next);
+	ASSERT_TRUE(atlas.insert(4, createSolidImage(62, 62, colorOf(4))));
+	ASSERT_TRUE(atlas.insert(5, createSolidImage(62, 62, colorOf(5))));
+	expectHolds(atlas, 4);
+	expectHolds(atlas, 5);
+	expectSeparate(atlas, 2);
+}
+
+TEST(DynamicAtlas, fillsMissingChannels) {
+	DynamicAtlas<std::string> atlas{ 8, 8, 4, 0 };
+
+	ASSERT_TRUE(atlas.insert("gray", createSolidImage<1>(2, 2, glm::vec<1, std::byte>{ std::byte(0x20) })));
+	auto [pos, dims] = atlas.getEntry("gray");
+	EXPECT_EQ(atlas.getImage().at(pos.x, pos.y, 0), std::byte(0x20));
+	EXPECT_EQ(atlas.getImage().at(pos.x, pos.y, 1), std::byte(0x0));
+	EXPECT_EQ(atlas.getImage().at(pos.x, pos.y, 3), std::byte(0xff));
+}
+
+TEST(DynamicAtlas, rejectsBadInput) {
+	EXPECT_THROW((Atlas{ 0, 8, 3 }), std::invalid_argument);
+	EXPECT_THROW((Atlas{ 8, 8, 5 }), std::invalid_argument);
+
+	Atlas atlas{ 16, 16, 3 };
+	ASSERT_TRUE(atlas.insert(0, createSolidImage(2, 2, colorOf(0))));
+	EXPECT_THROW(atlas.insert(0, createSolidImage(2, 2, colorOf(0))), std::invalid_argument);
+	EXPECT_THROW(atlas.insert(1, createSolidImage<4>(2, 2)), std::invalid_argument);
+	EXPECT_THROW(atlas.insert(1, createSolidImage(0, 2)), std::invalid_argument);
+	EXPECT_THROW((void)atlas.getEntry(1), std::out_of_range);
+}
@@ -35,6 +35,50 @@ public:
 		return m_mipmaps;
 	}
 
+	[[nodiscard]]
+	bool compressed() const noexcept {
+		return m_compressed;
+	}
+};
+
+// stands in for Texture2DArray, layers are stacked top to bottom
+class FakeTextureArray {
+private:
+	sndx::render::ImageData m_data;
+	size_t m_layers;
+	int m_mipmaps;
+	bool m_compressed;
+
+public:
+
+	FakeTextureArray(const sndx::render::ImageData& img, size_t layers, int mipmaps = 0, bool compress = true) :
+		m_data(img), m_layers(layers), m_mipmaps(mipmaps), m_compressed(compress) {}
+
+	[[nodiscard]]
+	size_t width() const noexcept {
+		return m_data.width();
+	}
+
+	[[nodiscard]]
+	size_t height() const noexcept {
+		return m_data.height() / m_layers;
+	}
+
+	[[nodiscard]]
+	size_t layers() const noexcept {
+		return m_layers;
+	}
+
+	[[nodiscard]]
+	const sndx::render::ImageData& asImage(uint8_t, int = 0) const noexcept {
+		return m_data;
+	}
+
+	[[nodiscard]]
+	int mipmaps() const noexcept {
+		return m_mipmaps;
+	}
+
 	[[nodiscard]]
 	bool compressed() const noexcept {
 		return m_compressed;
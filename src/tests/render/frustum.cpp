@@ -0,0 +1,176 @@
+#include "render/frustum.hpp"
+
+#include <gtest/gtest.h>
+
+#include "../collision/collision_helper.hpp"
+
+using namespace sndx::render;
+using namespace sndx::collision;
+
+namespace {
+	View makeView() {
+		View view{};
+		view.pos = glm::vec3(1.0f, 2.0f, 3.0f);
+		view.rotateYaw(30.0f).rotatePitch(-10.0f);
+		return view;
+	}
+
+	Perspective makePerspective() {
+		return Perspective{ glm::radians(70.0f), 1.5f, 0.1f, 50.0f };
+	}
+
+	bool isSet(const std::vector<uint64_t>& mask, size_t i) {
+		return (mask[i / 64] >> (i % 64)) & 1;
+	}
+
+	template <bool ZO>
+	void checkCorners() {
+		auto projView = makePerspective().getMatrix<ZO>() * makeView().getMatrix();
+		auto frustum = Frustum::fromMatrix<ZO>(projView);
+
+		// every corner lies on three planes and inside the rest
+		for (const auto& corner : getFrustrumCorners<ZO>(projView)) {
+			size_t on = 0;
+			for (size_t i = 0; i < Frustum::planeCount; ++i) {
+				auto d = frustum.distance(i, corner);
+				EXPECT_GT(d, -0.01f);
+				on += std::abs(d) < 0.01f;
+			}
+			EXPECT_EQ(on, 3);
+		}
+
+		for (const auto& plane : frustum.planes) {
+			EXPECT_NEAR(glm::length(glm::vec3(plane)), 1.0f, 1e-5f);
+		}
+	}
+}
+
+TEST(Frustum, planesPassThroughCorners) {
+	checkCorners<false>();
+	checkCorners<true>();
+
+	auto view = makeView();
+	auto frustum = Frustum::fromCamera(makePerspective(), view);
+
+	auto ahead = view.orientation * glm::vec3(0.0f, 0.0f, -5.0f) + view.pos;
+	auto behind = view.orientation * glm::vec3(0.0f, 0.0f, 5.0f) + view.pos;
+	EXPECT_TRUE(frustum.contains(ahead));
+	EXPECT_FALSE(frustum.contains(behind));
+
+	EXPECT_TRUE(frustum.intersects(Circle3D{ behind, 5.5f }));
+	EXPECT_FALSE(frustum.intersects(Circle3D{ behind, 4.5f }));
+	EXPECT_TRUE(frustum.intersects(Rect3D{ ahead - glm::vec3(0.1f), ahead + glm::vec3(0.1f) }));
+	EXPECT_FALSE(frustum.intersects(Rect3D{ behind - glm::vec3(0.1f), behind + glm::vec3(0.1f) }));
+}
+
+TEST(Frustum, classifyMasksPlanes) {
+	auto view = makeView();
+	auto frustum = Frustum::fromCamera(makePerspective(), view);
+	auto ahead = view.orientation * glm::vec3(0.0f, 0.0f, -10.0f) + view.pos;
+
+	uint8_t mask = Frustum::allPlanes;
+	uint8_t start = 0;
+	EXPECT_EQ(frustum.classify(Rect3D{ ahead - glm::vec3(0.5f), ahead + glm::vec3(0.5f) }, mask, start), Frustum::Result::inside);
+	EXPECT_EQ(mask, 0);
+
+	// straddles the near plane only
+	mask = Frustum::allPlanes;
+	EXPECT_EQ(frustum.classify(Rect3D{ view.pos - glm::vec3(0.5f), view.pos + glm::vec3(0.5f) }, mask, start), Frustum::Result::intersecting);
+	EXPECT_NE(mask, 0);
+
+	// the rejecting plane is remembered and tested first
+	auto behind = view.orientation * glm::vec3(0.0f, 0.0f, 10.0f) + view.pos;
+	Rect3D back{ behind - glm::vec3(0.5f), behind + glm::vec3(0.5f) };
+	mask = Frustum::allPlanes;
+	EXPECT_EQ(frustum.classify(back, mask, start), Frustum::Result::outside);
+
+	size_t tests = 0;
+	mask = Frustum::allPlanes;
+	EXPECT_EQ(frustum.classify(back, mask, start, tests), Frustum::Result::outside);
+	EXPECT_EQ(tests, 1);
+}
+
+TEST(Frustum, batchesMatchScalar) {
+	auto frustum = Frustum::fromCamera(makePerspective(), makeView());
+	auto boxes = randomBoxes(1003, 3, 60.0f, 0.1f, 4.0f);
+
+	RectBatch3D batch{ boxes };
+	std::vector<uint64_t> mask{};
+	auto count = frustum.cull(batch, mask);
+
+	size_t expected = 0;
+	for (size_t i = 0; i < boxes.size(); ++i) {
+		bool hit = frustum.intersects(boxes[i]);
+		expected += hit;
+		EXPECT_EQ(isSet(mask, i), hit) << i;
+	}
+	EXPECT_EQ(count, expected);
+	EXPECT_GT(count, 0);
+	EXPECT_LT(count, boxes.size());
+
+	std::vector<float> x{}, y{}, z{}, r{};
+	for (const auto& box : boxes) {
+		auto c = box.getCenter();
+		x.push_back(c.x);
+		y.push_back(c.y);
+		z.push_back(c.z);
+		r.push_back(glm::length(box.getSize()) * 0.5f);
+	}
+
+	count = frustum.cullSpheres(x, y, z, r, mask);
+	expected = 0;
+	for (size_t i = 0; i < boxes.size(); ++i) {
+		bool hit = frustum.intersects(Circle3D{ glm::vec3{ x[i], y[i], z[i] }, r[i] });
+		expected += hit;
+		EXPECT_EQ(isSet(mask, i), hit) << i;
+	}
+	EXPECT_EQ(count, expected);
+
+	r.pop_back();
+	EXPECT_THROW(frustum.cullSpheres(x, y, z, r, mask), std::invalid_argument);
+}
+
+TEST(FrustumCuller, matchesBruteForceAndReusesPlanes) {
+	auto boxes = randomBoxes(2000, 4, 60.0f, 0.1f, 4.0f);
+
+	AABBTree<size_t> tree{ 0.1f };
+	std::vector<AABBTree<size_t>::NodeId> leaves{};
+	for (size_t i = 0; i < boxes.size(); ++i) {
+		leaves.push_back(tree.insert(boxes[i], i));
+	}
+
+	auto frustum = Frustum::fromCamera(makePerspective(), makeView());
+
+	std::vector<size_t> expected{};
+	for (auto leaf : leaves) {
+		if (frustum.intersects(tree.getFatBounds(leaf))) {
+			expected.push_back(tree.getData(leaf));
+		}
+	}
+	std::sort(expected.begin(), expected.end());
+	ASSERT_FALSE(expected.empty());
+
+	FrustumCuller culler{};
+	auto run = [&]() {
+		std::vector<size_t> found{};
+		culler.cull(frustum, tree, [&](AABBTree<size_t>::NodeId id) {
+			found.push_back(tree.getData(id));
+		});
+		std::sort(found.begin(), found.end());
+		return found;
+	};
+
+	EXPECT_EQ(run(), expected);
+	auto cold = culler.getPlaneTests();
+	EXPECT_LT(culler.getNodesVisited(), 2 * tree.size() - 1);
+
+	EXPECT_EQ(run(), expected);
+	EXPECT_LT(culler.getPlaneTests(), cold);
+
+	size_t calls = 0;
+	culler.cull(frustum, tree, [&](AABBTree<size_t>::NodeId) {
+		++calls;
+		return false;
+	});
+	EXPECT_EQ(calls, 1);
+}
\ No newline at end of file
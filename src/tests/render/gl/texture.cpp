@@ -92,3 +92,21 @@ TEST_F(TextureTest, CanConvertToImg) {
 
 	EXPECT_TRUE(imageEqual(img, originalImg));
 }
+
+TEST_F(TextureTest, ArrayKeepsLayers) {
+	auto originalImg = createCheckeredImage(16, 12, {0xff, 0xff, 0xff});
+
+	EXPECT_THROW(Texture2DArray(originalImg, 5, 0, false), std::invalid_argument);
+
+	auto tex = Texture2DArray(originalImg, 3, 0, false);
+	ASSERT_EQ(glGetError(), GL_NO_ERROR);
+
+	EXPECT_EQ(tex.width(), 16);
+	EXPECT_EQ(tex.height(), 4);
+	EXPECT_EQ(tex.layers(), 3);
+
+	auto img = tex.asImage(3);
+	ASSERT_EQ(glGetError(), GL_NO_ERROR);
+
+	EXPECT_TRUE(imageEqual(img, originalImg));
+}
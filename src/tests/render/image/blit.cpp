@@ -0,0 +1,148 @@
+#include "render/image/blit.hpp"
+
+#include "../../common.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <random>
+
+using namespace sndx::render;
+
+namespace {
+	ImageData randomImage(size_t width, size_t height, uint8_t channels, unsigned seed) {
+		std::mt19937 gen{ seed };
+		std::uniform_int_distribution<int> value{ 0, 255 };
+
+		std::vector<std::byte> data(width * height * channels);
+		for (auto& b : data) {
+			b = std::byte(value(gen));
+		}
+		return ImageData{ width, height, channels, std::move(data) };
+	}
+
+	// AtlasBuilder's copy loop before blitImage, every byte through at()
+	void atCopy(std::vector<std::byte>& data, size_t origin, size_t stride, size_t channels, const ImageData& img) {
+		for (size_t y = 0; y < img.height(); ++y) {
+			size_t rowPos = origin + y * stride;
+
+			for (size_t x = 0; x < img.width(); ++x) {
+				for (size_t c = 0; c < img.channels(); ++c) {
+					data.at(rowPos + x * channels + c) = img.at(x, y, c);
+				}
+
+				for (size_t c = img.channels(); c < channels; ++c) {
+					data.at(rowPos + x * channels + c) = c >= 3 ? std::byte(0xff) : std::byte(0x0);
+				}
+			}
+		}
+	}
+
+	// the pixel at a time copy blitImage replaces
+	std::vector<std::byte> referenceBlit(const ImageData& img, size_t width, size_t height, uint8_t channels, size_t x0, size_t y0, bool transpose) {
+		std::vector<std::byte> out(width * height * channels, std::byte(0x11));
+		for (size_t y = 0; y < img.height(); ++y) {
+			for (size_t x = 0; x < img.width(); ++x) {
+				auto ax = x0 + (transpose ? y : x);
+				auto ay = y0 + (transpose ? x : y);
+
+				for (size_t c = 0; c < channels; ++c) {
+					out.at((ay * width + ax) * channels + c) = c < img.channels() ? img.at(x, y, c) : (c >= 3 ? std::byte(0xff) : std::byte(0x0));
+				}
+			}
+		}
+		return out;
+	}
+}
+
+TEST(Blit, matchesPixelCopy) {
+	constexpr size_t width = 96;
+	constexpr size_t height = 80;
+
+	for (uint8_t src = 1; src <= 4; ++src) {
+		for (uint8_t dst = src; dst <= 4; ++dst) {
+			for (bool transpose : { false, true }) {
+				// odd widths leave a scalar tail after the wide kernels
+				auto img = randomImage(37, 21, src, src * 10u + dst);
+				size_t x0 = 5, y0 = 9;
+
+				std::vector<std::byte> out(width * height * dst, std::byte(0x11));
+				blitImage(out, (y0 * width + x0) * dst, width * dst, dst, img, transpose);
+
+				EXPECT_EQ(out, referenceBlit(img, width, height, dst, x0, y0, transpose)) << int(src) << " " << int(dst) << " " << transpose;
+			}
+		}
+	}
+}
+
+TEST(Blit, rejectsBadTargets) {
+	auto img = randomImage(8, 4, 3, 1);
+	std::vector<std::byte> out(16 * 16 * 4);
+
+	EXPECT_THROW(blitImage(out, 0, 16 * 2, 2, img), std::invalid_argument);
+	EXPECT_THROW(blitImage(out, 0, 4 * 4, 4, img), std::out_of_range);
+	EXPECT_THROW(blitImage(out, (13 * 16 + 8) * 4, 16 * 4, 4, img), std::out_of_range);
+	EXPECT_NO_THROW(blitImage(out, (12 * 16 + 8) * 4, 16 * 4, 4, img));
+	EXPECT_THROW(blitImage(out, (12 * 16 + 8) * 4, 16 * 4, 4, img, true), std::out_of_range);
+
+	ImageData empty{ 0, 0, 3, std::vector<std::byte>{} };
+	EXPECT_NO_THROW(blitImage(std::span<std::byte>{}, 0, 0, 4, empty));
+}
+
+
+class BlitBenchmark : public ::testing::Test {
+public:
+	void SetUp() override {
+		set_test_weight(TestWeight::All);
+	}
+};
+
+// the 4096 x 4096 RGBA atlas workload, 1024 128 x 128 sprites with 1, 3 and 4 channels.
+// run with TEST_WEIGHT_LIMIT=5, timings are best of 5 and recorded as test properties
+TEST_F(BlitBenchmark, atlasWorkload) {
+	constexpr size_t side = 4096;
+	constexpr size_t sprite = 128;
+	constexpr size_t channels = 4;
+	constexpr size_t stride = side * channels;
+
+	std::vector<ImageData> sprites{};
+	for (size_t i = 0; i < (side / sprite) * (side / sprite); ++i) {
+		constexpr std::array<uint8_t, 3> mix{ 1, 3, 4 };
+		sprites.push_back(randomImage(sprite, sprite, mix[i % mix.size()], unsigned(i)));
+	}
+
+	auto origin = [&](size_t i) {
+		return (i / (side / sprite)) * sprite * stride + (i % (side / sprite)) * sprite * channels;
+	};
+
+	auto time = [&](auto&& copy) {
+		using namespace std::chrono;
+
+		std::vector<std::byte> data(side * side * channels);
+		auto best = duration<double, std::milli>::max();
+
+		for (size_t run = 0; run < 5; ++run) {
+			auto start = steady_clock::now();
+			for (size_t i = 0; i < sprites.size(); ++i) {
+				copy(data, origin(i), sprites[i]);
+			}
+			best = std::min(best, duration<double, std::milli>(steady_clock::now() - start));
+		}
+
+		return std::pair{ best.count(), std::move(data) };
+	};
+
+	auto [atMs, expected] = time([](auto& data, size_t at, const ImageData& img) {
+		atCopy(data, at, stride, channels, img);
+	});
+
+	auto [blitMs, actual] = time([](auto& data, size_t at, const ImageData& img) {
+		blitImage(data, at, stride, channels, img);
+	});
+
+	RecordProperty("atMs", atMs);
+	RecordProperty("blitMs", blitMs);
+	RecordProperty("simd", SNDX_BLIT_SIMD);
+
+	ASSERT_EQ(actual, expected);
+}
\ No newline at end of file